@@ -3,16 +3,20 @@
 // Input
 layout(location = 0) in vec3 Position;
 layout(location = 4) in vec2 Tex0;
+layout(location = 5) in vec2 Tex1;
 
 // Output
 out vec2 TexCoord;
-
-// Uniforms
-uniform mat4 ModelMtx;
+flat out int GlyphLayer;
+flat out int IsStroke;
 
 // Main
 void main()
 {
-	gl_Position = vec4(Position, 1) * ModelMtx;
+	// Glyph positions are laid out on the CPU in normalized device coordinates.
+	// Tex1 carries the glyph's texture layer and whether this quad is the stroke pass.
+	gl_Position = vec4(Position, 1);
 	TexCoord = Tex0;
+	GlyphLayer = int(Tex1.x);
+	IsStroke = int(Tex1.y);
 }
@@ -0,0 +1,118 @@
+#ifndef CFLATINDEXTABLE_H
+#define CFLATINDEXTABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Open-addressed hash index over a dense array owned by the caller.
+ * Maps a 64-bit hash to an index into the caller's storage; the caller supplies the equality
+ * test on lookup, so keys aren't duplicated here. Uses linear probing over a power-of-two
+ * slot array that's kept at most half full. There's no erase - rebuild the index instead.
+ */
+class CFlatIndexTable
+{
+public:
+    static constexpr uint32_t skNotFound = UINT32_MAX;
+
+private:
+    struct SSlot
+    {
+        uint64_t Hash = 0;
+        uint32_t Index = skNotFound;
+    };
+
+    std::vector<SSlot> mSlots;
+    size_t mSize = 0;
+
+    /** 64-bit finalizer from MurmurHash3; spreads sequential keys across the table */
+    static uint64_t Mix(uint64_t Hash)
+    {
+        Hash ^= Hash >> 33;
+        Hash *= 0xFF51AFD7ED558CCDULL;
+        Hash ^= Hash >> 33;
+        Hash *= 0xC4CEB9FE1A85EC53ULL;
+        Hash ^= Hash >> 33;
+        return Hash;
+    }
+
+    void Place(uint64_t Hash, uint32_t Index)
+    {
+        const size_t Mask = mSlots.size() - 1;
+        size_t SlotIdx = Mix(Hash) & Mask;
+
+        while (mSlots[SlotIdx].Index != skNotFound)
+            SlotIdx = (SlotIdx + 1) & Mask;
+
+        mSlots[SlotIdx] = SSlot{Hash, Index};
+    }
+
+    void Rehash(size_t NumSlots)
+    {
+        std::vector<SSlot> OldSlots(NumSlots);
+        OldSlots.swap(mSlots);
+
+        for (const SSlot& rkSlot : OldSlots)
+        {
+            if (rkSlot.Index != skNotFound)
+                Place(rkSlot.Hash, rkSlot.Index);
+        }
+    }
+
+public:
+    /** Returns the first index with a matching hash for which IsMatch(Index) is true, or skNotFound */
+    template <typename MatchFuncT>
+    uint32_t Find(uint64_t Hash, MatchFuncT&& IsMatch) const
+    {
+        if (mSlots.empty())
+            return skNotFound;
+
+        const size_t Mask = mSlots.size() - 1;
+
+        for (size_t SlotIdx = Mix(Hash) & Mask; mSlots[SlotIdx].Index != skNotFound; SlotIdx = (SlotIdx + 1) & Mask)
+        {
+            const SSlot& rkSlot = mSlots[SlotIdx];
+
+            if (rkSlot.Hash == Hash && IsMatch(rkSlot.Index))
+                return rkSlot.Index;
+        }
+
+        return skNotFound;
+    }
+
+    /** Adds an index. Doesn't check for duplicates; Find first if that matters. */
+    void Insert(uint64_t Hash, uint32_t Index)
+    {
+        if ((mSize + 1) * 2 > mSlots.size())
+            Rehash(mSlots.empty() ? 16 : mSlots.size() * 2);
+
+        Place(Hash, Index);
+        mSize++;
+    }
+
+    /** Preallocates enough slots for Count indices without growing */
+    void Reserve(size_t Count)
+    {
+        size_t NumSlots = 16;
+
+        while (NumSlots < Count * 2)
+            NumSlots *= 2;
+
+        if (NumSlots > mSlots.size())
+            Rehash(NumSlots);
+    }
+
+    void Clear()
+    {
+        mSlots.clear();
+        mSize = 0;
+    }
+
+    size_t Size() const
+    {
+        return mSize;
+    }
+};
+
+#endif // CFLATINDEXTABLE_H
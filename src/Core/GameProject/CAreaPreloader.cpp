@@ -0,0 +1,272 @@
+#include "Core/GameProject/CAreaPreloader.h"
+
+#include "Core/GameProject/CResourceEntry.h"
+#include "Core/GameProject/CResourceStore.h"
+#include "Core/Resource/CWorld.h"
+#include "Core/Resource/CResource.h"
+#include "Core/Resource/Area/CGameArea.h"
+#include <Common/FileIO/CFileInStream.h>
+#include <Common/FileIO/CMemoryInStream.h>
+
+#include <algorithm>
+#include <ranges>
+
+CAreaPreloader::CAreaPreloader(CResourceStore *pStore, uint64_t MemoryBudget)
+    : mpStore(pStore)
+    , mMemoryBudget(MemoryBudget)
+{
+}
+
+CAreaPreloader::~CAreaPreloader()
+{
+    {
+        std::lock_guard Lock(mMutex);
+        mStopping = true;
+    }
+    mCondition.notify_all();
+
+    if (mWorker.joinable())
+        mWorker.join();
+
+    Clear();
+}
+
+void CAreaPreloader::WorkerMain()
+{
+    std::unique_lock Lock(mMutex);
+
+    while (true)
+    {
+        mCondition.wait(Lock, [this] { return mStopping || !mPendingReads.empty(); });
+
+        if (mStopping)
+            return;
+
+        const SReadRequest Request = std::move(mPendingReads.front());
+        mPendingReads.pop_front();
+        Lock.unlock();
+
+        // An empty result makes Update fall back on a regular load, which reports the error
+        SReadResult Result{Request.AreaID, {}};
+        CFileInStream File(Request.Path, std::endian::big);
+
+        if (File.IsValid())
+        {
+            Result.Data.resize(File.Size());
+            File.ReadBytes(Result.Data.data(), Result.Data.size());
+        }
+
+        Lock.lock();
+        mFinishedReads.push_back(std::move(Result));
+    }
+}
+
+/** Drops the reference to a preloaded area and unloads whatever it brought in that nothing else uses */
+void CAreaPreloader::Evict(SPreloadedArea& rArea)
+{
+    mMemoryUsed -= rArea.Size;
+    rArea.pArea = nullptr;
+    mpStore->DestroyUnreferencedResources(rArea.Entries);
+
+    // Whatever is left is shared with something else; it's unloaded by a later sweep once that lets go of it
+    for (CResourceEntry *pEntry : rArea.Entries)
+    {
+        if (pEntry->IsLoaded())
+            mLeftovers.insert(pEntry);
+    }
+
+    rArea.Entries.clear();
+    SweepLeftovers();
+}
+
+void CAreaPreloader::SweepLeftovers()
+{
+    if (mLeftovers.empty())
+        return;
+
+    const std::vector<CResourceEntry*> Entries(mLeftovers.begin(), mLeftovers.end());
+    mpStore->DestroyUnreferencedResources(Entries);
+    std::erase_if(mLeftovers, [](const CResourceEntry* pkEntry) { return !pkEntry->IsLoaded(); });
+}
+
+void CAreaPreloader::EnforceBudget()
+{
+    while (mMemoryUsed > mMemoryBudget && !mAreas.empty())
+    {
+        Evict(mAreas.back());
+        mAreas.pop_back();
+    }
+}
+
+/** Queues every area attached to the given one. Requests still queued from a previous call are dropped. */
+void CAreaPreloader::RequestAttachedAreas(CWorld *pWorld, size_t AreaIndex)
+{
+    {
+        std::lock_guard Lock(mMutex);
+
+        for (const SReadRequest& rkRequest : mPendingReads)
+            mRequested.erase(rkRequest.AreaID);
+
+        mPendingReads.clear();
+    }
+
+    for (uint32_t AttachedIdx = 0; AttachedIdx < pWorld->AreaAttachedCount(AreaIndex); AttachedIdx++)
+    {
+        const uint32_t AttachedArea = pWorld->AreaAttachedID(AreaIndex, AttachedIdx);
+
+        if (AttachedArea < pWorld->NumAreas())
+            RequestArea(pWorld->AreaResourceID(AttachedArea));
+    }
+}
+
+void CAreaPreloader::RequestArea(const CAssetID& rkAreaID)
+{
+    // Already preloaded; just mark it as recently used
+    const auto Iter = std::ranges::find(mAreas, rkAreaID, &SPreloadedArea::AreaID);
+
+    if (Iter != mAreas.end())
+    {
+        mAreas.splice(mAreas.begin(), mAreas, Iter);
+        return;
+    }
+
+    if (mRequested.contains(rkAreaID))
+        return;
+
+    // Skip areas that are loaded already, e.g. the one open in the editor
+    CResourceEntry *pEntry = mpStore->FindEntry(rkAreaID);
+
+    if (!pEntry || pEntry->ResourceType() != EResourceType::Area || pEntry->IsLoaded())
+        return;
+
+    mRequested.insert(rkAreaID);
+
+    {
+        std::lock_guard Lock(mMutex);
+
+        // Raw resources are loaded from their XML instead of the cooked file, so there's nothing to read ahead
+        if (pEntry->HasRawVersion() || !pEntry->HasCookedVersion())
+        {
+            mFinishedReads.push_back(SReadResult{rkAreaID, {}});
+            return;
+        }
+
+        mPendingReads.push_back(SReadRequest{rkAreaID, pEntry->CookedAssetPath()});
+
+        if (!mWorker.joinable())
+            mWorker = std::thread(&CAreaPreloader::WorkerMain, this);
+    }
+
+    mCondition.notify_one();
+}
+
+/** Decodes at most one area that has finished reading. Returns whether there was anything to do. */
+bool CAreaPreloader::Update()
+{
+    SReadResult Result;
+
+    {
+        std::lock_guard Lock(mMutex);
+
+        if (mFinishedReads.empty())
+            return false;
+
+        Result = std::move(mFinishedReads.front());
+        mFinishedReads.pop_front();
+    }
+
+    // Skip reads that were cancelled, or areas that got loaded some other way in the meantime
+    if (mRequested.erase(Result.AreaID) == 0)
+        return true;
+
+    CResourceEntry *pEntry = mpStore->FindEntry(Result.AreaID);
+
+    if (!pEntry || pEntry->IsLoaded())
+        return true;
+
+    // Remember what was loaded beforehand, so the resources this area pulls in can be told apart
+    std::set<CAssetID> LoadedBefore;
+
+    for (const CAssetID& rkID : mpStore->LoadedResources() | std::views::keys)
+        LoadedBefore.insert(LoadedBefore.end(), rkID);
+
+    CResource *pResource = nullptr;
+
+    if (Result.Data.empty())
+    {
+        pResource = pEntry->Load();
+    }
+    else
+    {
+        CMemoryInStream Stream(Result.Data.data(), Result.Data.size(), std::endian::big);
+        pResource = pEntry->LoadCooked(Stream);
+    }
+
+    if (!pResource)
+        return true;
+
+    SPreloadedArea Area;
+    Area.AreaID = Result.AreaID;
+    Area.pArea = pResource;
+
+    if (!Area.pArea)
+        return true;
+
+    for (const auto& [ID, pLoadedEntry] : mpStore->LoadedResources())
+    {
+        if (!LoadedBefore.contains(ID))
+        {
+            Area.Entries.push_back(pLoadedEntry);
+            Area.Size += pLoadedEntry->Resource()->MemoryUsage().TotalBytes();
+        }
+    }
+
+    mMemoryUsed += Area.Size;
+    mAreas.push_front(std::move(Area));
+    EnforceBudget();
+    return true;
+}
+
+/** Stops holding on to an area, e.g. because it's now open in the editor and owned there */
+void CAreaPreloader::Release(const CAssetID& rkAreaID)
+{
+    const auto Iter = std::ranges::find(mAreas, rkAreaID, &SPreloadedArea::AreaID);
+
+    if (Iter != mAreas.end())
+    {
+        mMemoryUsed -= Iter->Size;
+        mAreas.erase(Iter);
+    }
+}
+
+void CAreaPreloader::Clear()
+{
+    {
+        std::lock_guard Lock(mMutex);
+        mPendingReads.clear();
+        mFinishedReads.clear();
+    }
+
+    mRequested.clear();
+
+    while (!mAreas.empty())
+    {
+        Evict(mAreas.back());
+        mAreas.pop_back();
+    }
+
+    // Anything still loaded now is in use outside the preloader, which owns it from here on
+    SweepLeftovers();
+    mLeftovers.clear();
+}
+
+void CAreaPreloader::SetMemoryBudget(uint64_t MemoryBudget)
+{
+    mMemoryBudget = MemoryBudget;
+    EnforceBudget();
+}
+
+bool CAreaPreloader::IsPreloaded(const CAssetID& rkAreaID) const
+{
+    return std::ranges::find(mAreas, rkAreaID, &SPreloadedArea::AreaID) != mAreas.end();
+}
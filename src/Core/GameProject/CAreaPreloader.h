@@ -0,0 +1,108 @@
+#ifndef CAREAPRELOADER_H
+#define CAREAPRELOADER_H
+
+#include "Core/Resource/TResPtr.h"
+#include <Common/CAssetID.h>
+#include <Common/TString.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+class CGameArea;
+class CResourceEntry;
+class CResourceStore;
+class CWorld;
+
+/**
+ * Loads the areas attached to the active area ahead of time, so moving to a neighbour
+ * doesn't have to wait on disk reads and decoding.
+ *
+ * Cooked files are read on a worker thread, but decoding still happens in Update on the owning
+ * thread. Loading an area also loads its textures and script templates through the resource
+ * store and game templates, none of which are thread-safe, so the area can't be built detached
+ * on the worker. Each Update therefore costs one area decode; the saving is that it happens while
+ * the editor is idle instead of when the user switches areas. Nothing here touches the renderer,
+ * so it runs fine without a GL context.
+ *
+ * Preloaded areas are kept referenced until they're evicted to stay under the memory budget
+ * (least recently used first) or handed off with Release. The budget counts the resident memory
+ * of the area and of every resource that was first loaded along with it, and eviction only
+ * unloads those resources.
+ */
+class CAreaPreloader
+{
+public:
+    static constexpr uint64_t skDefaultMemoryBudget = 64ULL * 1024 * 1024;
+
+private:
+    struct SReadRequest
+    {
+        CAssetID AreaID;
+        TString Path;
+    };
+
+    struct SReadResult
+    {
+        CAssetID AreaID;
+        std::vector<uint8_t> Data;
+    };
+
+    struct SPreloadedArea
+    {
+        CAssetID AreaID;
+        TResPtr<CGameArea> pArea;
+        /** The area and every resource that wasn't loaded until the area was */
+        std::vector<CResourceEntry*> Entries;
+        uint64_t Size = 0;
+    };
+
+    CResourceStore *mpStore;
+    uint64_t mMemoryBudget;
+    uint64_t mMemoryUsed = 0;
+
+    /** Preloaded areas, most recently requested first */
+    std::list<SPreloadedArea> mAreas;
+
+    /** Resources an evicted area brought in that were still in use elsewhere at the time. Swept on each eviction. */
+    std::set<CResourceEntry*> mLeftovers;
+
+    /** Areas that have been requested but not decoded yet. Only touched on the owning thread. */
+    std::set<CAssetID> mRequested;
+
+    // Shared with the worker thread
+    std::thread mWorker;
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    std::deque<SReadRequest> mPendingReads;
+    std::deque<SReadResult> mFinishedReads;
+    bool mStopping = false;
+
+    void WorkerMain();
+    void Evict(SPreloadedArea& rArea);
+    void SweepLeftovers();
+    void EnforceBudget();
+
+public:
+    explicit CAreaPreloader(CResourceStore *pStore, uint64_t MemoryBudget = skDefaultMemoryBudget);
+    ~CAreaPreloader();
+
+    void RequestAttachedAreas(CWorld *pWorld, size_t AreaIndex);
+    void RequestArea(const CAssetID& rkAreaID);
+    bool Update();
+    void Release(const CAssetID& rkAreaID);
+    void Clear();
+    void SetMemoryBudget(uint64_t MemoryBudget);
+    bool IsPreloaded(const CAssetID& rkAreaID) const;
+
+    uint64_t MemoryBudget() const       { return mMemoryBudget; }
+    uint64_t MemoryUsed() const         { return mMemoryUsed; }
+    bool HasPendingRequests() const     { return !mRequested.empty(); }
+};
+
+#endif // CAREAPRELOADER_H
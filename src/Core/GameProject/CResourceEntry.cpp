@@ -604,6 +604,7 @@ bool CResourceEntry::MoveAndRename(const TString& rkDir, const TString& rkName,
 
         mpStore->SetCacheDirty();
         mCachedUppercaseName = rkName.ToUpper();
+        mpStore->OnEntryRenamed(this);
         SaveMetadata();
         return true;
     }
@@ -725,6 +726,7 @@ void CResourceEntry::MarkDeleted(bool InDeleted)
         }
 
         mpStore->SetCacheDirty();
+        mpStore->OnEntryDeletionChanged(this);
         NLog::Debug("{} FOR DELETION: [{}] {}", InDeleted ? "MARKED" : "UNMARKED", *ID().ToString(), *CookedPath.GetFileName());
     }
 }
@@ -0,0 +1,188 @@
+#include "Core/GameProject/CResourceSearchIndex.h"
+
+#include "Core/GameProject/CResourceEntry.h"
+
+#include <algorithm>
+#include <iterator>
+
+std::vector<uint32_t> CResourceSearchIndex::UniqueTrigrams(const TString& rkKey)
+{
+    std::vector<uint32_t> Trigrams;
+
+    if (rkKey.Size() < 3)
+        return Trigrams;
+
+    Trigrams.reserve(rkKey.Size() - 2);
+
+    for (size_t CharIdx = 0; CharIdx + 2 < rkKey.Size(); CharIdx++)
+    {
+        const auto C0 = static_cast<uint8_t>(rkKey[CharIdx]);
+        const auto C1 = static_cast<uint8_t>(rkKey[CharIdx + 1]);
+        const auto C2 = static_cast<uint8_t>(rkKey[CharIdx + 2]);
+        Trigrams.push_back((C0 << 16) | (C1 << 8) | C2);
+    }
+
+    std::ranges::sort(Trigrams);
+    const auto [First, Last] = std::ranges::unique(Trigrams);
+    Trigrams.erase(First, Last);
+    return Trigrams;
+}
+
+void CResourceSearchIndex::AddSlot(uint32_t SlotIdx)
+{
+    SSlot& rSlot = mSlots[SlotIdx];
+    rSlot.Key = rSlot.pEntry->UppercaseName();
+
+    for (const uint32_t Trigram : UniqueTrigrams(rSlot.Key))
+    {
+        std::vector<uint32_t>& rPosting = mPostings[Trigram];
+
+        // Slots are usually appended in increasing order, so this is normally a push_back
+        if (rPosting.empty() || rPosting.back() < SlotIdx)
+            rPosting.push_back(SlotIdx);
+        else
+            rPosting.insert(std::ranges::lower_bound(rPosting, SlotIdx), SlotIdx);
+    }
+}
+
+void CResourceSearchIndex::RemoveSlot(uint32_t SlotIdx)
+{
+    SSlot& rSlot = mSlots[SlotIdx];
+
+    for (const uint32_t Trigram : UniqueTrigrams(rSlot.Key))
+    {
+        const auto PostingIt = mPostings.find(Trigram);
+
+        if (PostingIt == mPostings.end())
+            continue;
+
+        std::vector<uint32_t>& rPosting = PostingIt->second;
+        const auto It = std::ranges::lower_bound(rPosting, SlotIdx);
+
+        if (It != rPosting.end() && *It == SlotIdx)
+            rPosting.erase(It);
+
+        if (rPosting.empty())
+            mPostings.erase(PostingIt);
+    }
+
+    rSlot.Key = TString();
+}
+
+void CResourceSearchIndex::Clear()
+{
+    mSlots.clear();
+    mFreeSlots.clear();
+    mEntrySlots.clear();
+    mPostings.clear();
+    mBuilt = false;
+    mGeneration++;
+}
+
+/** Adds an entry, or reindexes it if its name changed. Does nothing until the index has been built. */
+void CResourceSearchIndex::Update(CResourceEntry *pEntry)
+{
+    if (!mBuilt)
+        return;
+
+    if (const auto It = mEntrySlots.find(pEntry); It != mEntrySlots.end())
+    {
+        if (mSlots[It->second].Key == pEntry->UppercaseName())
+            return;
+
+        RemoveSlot(It->second);
+        AddSlot(It->second);
+    }
+    else
+    {
+        uint32_t SlotIdx;
+
+        if (!mFreeSlots.empty())
+        {
+            SlotIdx = mFreeSlots.back();
+            mFreeSlots.pop_back();
+            mSlots[SlotIdx].pEntry = pEntry;
+        }
+        else
+        {
+            SlotIdx = static_cast<uint32_t>(mSlots.size());
+            mSlots.push_back(SSlot{pEntry, {}});
+        }
+
+        mEntrySlots.emplace(pEntry, SlotIdx);
+        AddSlot(SlotIdx);
+    }
+
+    mGeneration++;
+}
+
+void CResourceSearchIndex::Remove(const CResourceEntry *pEntry)
+{
+    const auto It = mEntrySlots.find(pEntry);
+
+    if (It == mEntrySlots.end())
+        return;
+
+    RemoveSlot(It->second);
+    mSlots[It->second].pEntry = nullptr;
+    mFreeSlots.push_back(It->second);
+    mEntrySlots.erase(It);
+    mGeneration++;
+}
+
+/** Returns every entry whose name contains the given (uppercase) string */
+std::unordered_set<const CResourceEntry*> CResourceSearchIndex::Query(const TString& rkUpperString) const
+{
+    std::unordered_set<const CResourceEntry*> Matches;
+    const std::vector<uint32_t> Trigrams = UniqueTrigrams(rkUpperString);
+
+    // Too short to have any trigrams; check every name directly
+    if (Trigrams.empty())
+    {
+        for (const SSlot& rkSlot : mSlots)
+        {
+            if (rkSlot.pEntry && rkSlot.Key.Contains(rkUpperString))
+                Matches.insert(rkSlot.pEntry);
+        }
+
+        return Matches;
+    }
+
+    // Intersect the postings, smallest first so the candidate list shrinks as fast as possible
+    std::vector<const std::vector<uint32_t>*> Postings;
+    Postings.reserve(Trigrams.size());
+
+    for (const uint32_t Trigram : Trigrams)
+    {
+        const auto It = mPostings.find(Trigram);
+
+        if (It == mPostings.end())
+            return Matches;
+
+        Postings.push_back(&It->second);
+    }
+
+    std::ranges::sort(Postings, {}, &std::vector<uint32_t>::size);
+    std::vector<uint32_t> Candidates = *Postings.front();
+    std::vector<uint32_t> Intersection;
+
+    for (size_t PostingIdx = 1; PostingIdx < Postings.size() && !Candidates.empty(); PostingIdx++)
+    {
+        Intersection.clear();
+        std::ranges::set_intersection(Candidates, *Postings[PostingIdx], std::back_inserter(Intersection));
+        Candidates.swap(Intersection);
+    }
+
+    // Having every trigram doesn't guarantee they're in the right order, so verify each candidate
+    Matches.reserve(Candidates.size());
+
+    for (const uint32_t SlotIdx : Candidates)
+    {
+        const SSlot& rkSlot = mSlots[SlotIdx];
+
+        if (rkSlot.Key.Contains(rkUpperString))
+            Matches.insert(rkSlot.pEntry);
+    }
+
+    return Matches;
+}
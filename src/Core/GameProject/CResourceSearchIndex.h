@@ -0,0 +1,73 @@
+#ifndef CRESOURCESEARCHINDEX_H
+#define CRESOURCESEARCHINDEX_H
+
+#include <Common/TString.h>
+
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+class CResourceEntry;
+
+/**
+ * Trigram index over resource entry names, for case-insensitive substring search.
+ * A query only has to verify the entries that contain every trigram of the search string,
+ * instead of scanning the whole store.
+ *
+ * The index is built on first use and kept up to date by the resource store as entries
+ * are added, renamed or removed.
+ */
+class CResourceSearchIndex
+{
+    struct SSlot
+    {
+        CResourceEntry *pEntry = nullptr;
+        TString Key; // Uppercase name the entry was indexed under
+    };
+
+    std::vector<SSlot> mSlots;
+    std::vector<uint32_t> mFreeSlots;
+    std::unordered_map<const CResourceEntry*, uint32_t> mEntrySlots;
+
+    /** Sorted slot indices for every trigram */
+    std::unordered_map<uint32_t, std::vector<uint32_t>> mPostings;
+
+    bool mBuilt = false;
+    uint32_t mGeneration = 0;
+
+    static std::vector<uint32_t> UniqueTrigrams(const TString& rkKey);
+    void AddSlot(uint32_t SlotIdx);
+    void RemoveSlot(uint32_t SlotIdx);
+
+public:
+    /** Indexes every entry in the range; elements may be raw or smart pointers */
+    template <typename RangeT>
+    void Build(RangeT&& rEntries)
+    {
+        Clear();
+
+        for (const auto& rkEntry : rEntries)
+        {
+            CResourceEntry *pEntry = &*rkEntry;
+            const auto SlotIdx = static_cast<uint32_t>(mSlots.size());
+            mSlots.push_back(SSlot{pEntry, {}});
+            mEntrySlots.emplace(pEntry, SlotIdx);
+            AddSlot(SlotIdx);
+        }
+
+        mBuilt = true;
+    }
+
+    void Clear();
+    void Update(CResourceEntry *pEntry);
+    void Remove(const CResourceEntry *pEntry);
+    std::unordered_set<const CResourceEntry*> Query(const TString& rkUpperString) const;
+
+    bool IsBuilt() const            { return mBuilt; }
+
+    /** Changes whenever the indexed names change, so cached query results can be checked for staleness */
+    uint32_t Generation() const     { return mGeneration; }
+};
+
+#endif // CRESOURCESEARCHINDEX_H
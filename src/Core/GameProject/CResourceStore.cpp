@@ -4,6 +4,7 @@
 #include "Core/IUIRelay.h"
 #include "Core/GameProject/CGameExporter.h"
 #include "Core/GameProject/CGameProject.h"
+#include "Core/OpenGL/CDynamicVertexBuffer.h"
 #include "Core/Resource/CResource.h"
 #include <Common/Macros.h>
 #include <Common/FileUtil.h>
@@ -12,6 +13,10 @@
 #include <Common/Serialization/CBasicBinaryWriter.h>
 #include <tinyxml2.h>
 
+#include <algorithm>
+#include <set>
+#include <vector>
+
 using namespace tinyxml2;
 TString gDataDir;
 bool gResourcesWritable = false;
@@ -84,6 +89,7 @@ bool CResourceStore::SerializeDatabaseCache(IArchive& rArc)
                 {
                     auto pEntry = CResourceEntry::BuildFromArchive(this, rArc);
                     ASSERT(FindEntry(pEntry->ID()) == nullptr);
+                    mSearchIndex.Update(pEntry.get());
                     mResourceEntries.insert_or_assign(pEntry->ID(), std::move(pEntry));
                     rArc.ParamEnd();
                 }
@@ -232,6 +238,7 @@ void CResourceStore::CloseProject()
     }
 
     // Delete all entries from old project
+    mSearchIndex.Clear();
     mResourceEntries.clear();
 
     // Clear deleted files from previous runs
@@ -331,6 +338,7 @@ void CResourceStore::ClearDatabase()
     }
 
     // Clear out existing resource entries and directories
+    mSearchIndex.Clear();
     mResourceEntries.clear();
 
     delete mpDatabaseRoot;
@@ -378,6 +386,7 @@ bool CResourceStore::BuildFromDirectory(bool ShouldGenerateCacheFile)
             ASSERT(mResourceEntries.find(ID) == mResourceEntries.cend());
             ASSERT(ID.Length() == CAssetID::GameIDLength(mGame));
 
+            mSearchIndex.Update(pEntry.get());
             mResourceEntries.insert_or_assign(ID, std::move(pEntry));
         }
         else if (FileUtil::IsDirectory(Path))
@@ -443,6 +452,7 @@ CResourceEntry* CResourceStore::CreateNewResource(const CAssetID& rkID, EResourc
             auto* resPtr = res.get();
 
             mResourceEntries.insert_or_assign(rkID, std::move(res));
+            mSearchIndex.Update(resPtr);
             mDatabaseCacheDirty = true;
 
             if (resPtr->IsLoaded())
@@ -566,6 +576,119 @@ void CResourceStore::DestroyUnreferencedResources()
     } while (NumDeleted > 0);
 }
 
+/** Like DestroyUnreferencedResources, but only considers the given entries */
+void CResourceStore::DestroyUnreferencedResources(std::span<CResourceEntry* const> Entries)
+{
+    // Unloading one entry can release the last reference to another, so repeat until nothing changes
+    uint32 NumDeleted;
+
+    do
+    {
+        NumDeleted = 0;
+
+        for (CResourceEntry *pEntry : Entries)
+        {
+            if (pEntry->IsLoaded() && !pEntry->Resource()->IsReferenced() && pEntry->Unload())
+            {
+                mLoadedResources.erase(pEntry->ID());
+                NumDeleted++;
+            }
+        }
+    } while (NumDeleted > 0);
+}
+
+std::map<EResourceType, SResourceMemoryUsage> CResourceStore::MemoryUsageByType() const
+{
+    std::map<EResourceType, SResourceMemoryUsage> Usage;
+
+    for (const CResourceEntry *pEntry : mLoadedResources | std::views::values)
+        Usage[pEntry->ResourceType()] += pEntry->Resource()->MemoryUsage();
+
+    return Usage;
+}
+
+SResourceMemoryUsage CResourceStore::DependencyMemoryUsage(CResourceEntry *pRoot) const
+{
+    // Totals the root and every loaded resource reachable from it through loaded resources, counting each once
+    SResourceMemoryUsage Usage;
+    std::set<CAssetID> Visited{pRoot->ID()};
+    std::vector<CResourceEntry*> Pending{pRoot};
+
+    while (!Pending.empty())
+    {
+        CResourceEntry *pEntry = Pending.back();
+        Pending.pop_back();
+
+        if (!pEntry->IsLoaded())
+            continue;
+
+        Usage += pEntry->Resource()->MemoryUsage();
+
+        // Prefer the cached dependency tree; building one for a large area isn't free
+        std::unique_ptr<CDependencyTree> pBuiltTree;
+        const CDependencyTree *pTree = pEntry->Dependencies();
+
+        if (!pTree)
+        {
+            pBuiltTree = pEntry->Resource()->BuildDependencyTree();
+            pTree = pBuiltTree.get();
+        }
+
+        std::set<CAssetID> DependencyIDs;
+        pTree->GetAllResourceReferences(DependencyIDs);
+
+        for (const CAssetID& rkID : DependencyIDs)
+        {
+            if (!Visited.insert(rkID).second)
+                continue;
+
+            if (CResourceEntry *pDependency = FindEntry(rkID))
+                Pending.push_back(pDependency);
+        }
+    }
+
+    return Usage;
+}
+
+void CResourceStore::DumpMemoryReport() const
+{
+    constexpr double kMB = 1024.0 * 1024.0;
+    SResourceMemoryUsage Total;
+
+    NLog::Debug("Resource memory usage ({} loaded):", mLoadedResources.size());
+
+    // By type, largest first
+    auto ByType = MemoryUsageByType();
+    std::vector<std::pair<EResourceType, SResourceMemoryUsage>> SortedTypes(ByType.begin(), ByType.end());
+    std::ranges::sort(SortedTypes, std::greater{}, [](const auto& rkPair) { return rkPair.second.TotalBytes(); });
+
+    for (const auto& [Type, Usage] : SortedTypes)
+    {
+        NLog::Debug("    {:<24} {:>6} loaded  {:>9.2f} MB CPU  {:>9.2f} MB GPU",
+                    TEnumReflection<EResourceType>::ConvertValueToString(Type),
+                    Usage.NumResources, Usage.CPUBytes / kMB, Usage.GPUBytes / kMB);
+        Total += Usage;
+    }
+
+    NLog::Debug("    {:<24} {:>6} loaded  {:>9.2f} MB CPU  {:>9.2f} MB GPU",
+                "Total", Total.NumResources, Total.CPUBytes / kMB, Total.GPUBytes / kMB);
+
+    // Streaming vertex rings belong to the renderer rather than to any resource
+    NLog::Debug("    {:<24} {:>6}         {:>9.2f} MB CPU  {:>9.2f} MB GPU",
+                "Dynamic vertex rings", "", 0.0, CDynamicVertexBuffer::TotalGPUMemoryUsage() / kMB);
+
+    // By area, since areas are what pull in most of a session's resources
+    for (CResourceEntry *pEntry : mLoadedResources | std::views::values)
+    {
+        if (pEntry->ResourceType() != EResourceType::Area)
+            continue;
+
+        const SResourceMemoryUsage Usage = DependencyMemoryUsage(pEntry);
+        NLog::Debug("    Area {}: {} resources  {:.2f} MB CPU  {:.2f} MB GPU",
+                    *pEntry->Name(), Usage.NumResources, Usage.CPUBytes / kMB, Usage.GPUBytes / kMB);
+    }
+}
+
 bool CResourceStore::DeleteResourceEntry(CResourceEntry *pEntry)
 {
     const CAssetID ID = pEntry->ID();
@@ -583,6 +706,8 @@ bool CResourceStore::DeleteResourceEntry(CResourceEntry *pEntry)
     if (pEntry->Directory())
         pEntry->Directory()->RemoveChildResource(pEntry);
 
+    mSearchIndex.Remove(pEntry);
+
     const auto It = mResourceEntries.find(ID);
     ASSERT(It != mResourceEntries.end());
     mResourceEntries.erase(It);
@@ -604,6 +729,29 @@ static int wrap_fopen(FILE** pFile, const char *filename, const char *mode)
 }
 #endif
 
+void CResourceStore::OnEntryRenamed(CResourceEntry *pEntry)
+{
+    mSearchIndex.Update(pEntry);
+}
+
+void CResourceStore::OnEntryDeletionChanged(CResourceEntry *pEntry)
+{
+    // The index mirrors MakeResourceView, which skips entries marked for deletion
+    if (pEntry->IsMarkedForDeletion())
+        mSearchIndex.Remove(pEntry);
+    else
+        mSearchIndex.Update(pEntry);
+}
+
+/** Returns the name search index, building it first if nothing has searched this store yet */
+const CResourceSearchIndex& CResourceStore::SearchIndex()
+{
+    if (!mSearchIndex.IsBuilt())
+        mSearchIndex.Build(MakeResourceView());
+
+    return mSearchIndex;
+}
+
 void CResourceStore::ImportNamesFromPakContentsTxt(const TString& rkTxtPath, bool UnnamedOnly)
 {
     // Read file contents -first- then move assets -after-; this
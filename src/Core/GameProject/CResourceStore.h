@@ -2,6 +2,7 @@
 #define CRESOURCESTORE_H
 
 #include "Core/GameProject/CResourceEntry.h"
+#include "Core/GameProject/CResourceSearchIndex.h"
 #include "Core/GameProject/CVirtualDirectory.h"
 #include "Core/Resource/EResType.h"
 #include <Common/CAssetID.h>
@@ -11,10 +12,12 @@
 #include <map>
 #include <memory>
 #include <ranges>
+#include <span>
 
 class CGameExporter;
 class CGameProject;
 class CResource;
+struct SResourceMemoryUsage;
 
 enum class EDatabaseVersion
 {
@@ -34,6 +37,7 @@ class CResourceStore
     CVirtualDirectory *mpDatabaseRoot = nullptr;
     std::map<CAssetID, std::unique_ptr<CResourceEntry>> mResourceEntries;
     std::map<CAssetID, CResourceEntry*> mLoadedResources;
+    CResourceSearchIndex mSearchIndex;
     bool mDatabaseCacheDirty = false;
 
     // Directory paths
@@ -72,7 +76,14 @@ public:
     CResource* LoadResource(const TString& rkPath);
     void TrackLoadedResource(CResourceEntry *pEntry);
     void DestroyUnreferencedResources();
+    void DestroyUnreferencedResources(std::span<CResourceEntry* const> Entries);
+    std::map<EResourceType, SResourceMemoryUsage> MemoryUsageByType() const;
+    SResourceMemoryUsage DependencyMemoryUsage(CResourceEntry *pRoot) const;
+    void DumpMemoryReport() const;
     bool DeleteResourceEntry(CResourceEntry *pEntry);
+    void OnEntryRenamed(CResourceEntry *pEntry);
+    void OnEntryDeletionChanged(CResourceEntry *pEntry);
+    const CResourceSearchIndex& SearchIndex();
 
     void ImportNamesFromPakContentsTxt(const TString& rkTxtPath, bool UnnamedOnly);
 
@@ -89,6 +100,7 @@ public:
     CVirtualDirectory* RootDirectory() const { return mpDatabaseRoot; }
     uint32_t NumTotalResources() const       { return mResourceEntries.size(); }
     uint32_t NumLoadedResources() const      { return mLoadedResources.size(); }
+    const std::map<CAssetID, CResourceEntry*>& LoadedResources() const { return mLoadedResources; }
     bool IsCacheDirty() const                { return mDatabaseCacheDirty; }
 
     // Returns a non-owning filter view into resource entries, which allows for lazily evaluating all entries.
@@ -11,6 +11,9 @@ public:
     virtual void ShowMessageBoxAsync(const std::string& rkInfoBoxTitle, const std::string& rkMessage) = 0;
     virtual bool AskYesNoQuestion(const std::string& rkInfoBoxTitle, const std::string& rkQuestion) = 0;
     virtual bool OpenProject(const std::string& kPath = {}) = 0;
+
+    /** Makes an offscreen OpenGL context current on the calling thread, for tests that render without a viewport */
+    virtual bool MakeOffscreenContextCurrent() = 0;
 };
 extern IUIRelay *gpUIRelay;
 
@@ -1,16 +1,60 @@
 #include "Core/NCoreTests.h"
 
 #include "Core/IUIRelay.h"
+#include "Core/GameProject/CAreaPreloader.h"
 #include "Core/GameProject/CGameProject.h"
 #include "Core/GameProject/CResourceEntry.h"
+#include "Core/IProgressNotifier.h"
+#include "Core/OpenGL/CDynamicVertexBuffer.h"
+#include "Core/OpenGL/CShaderCache.h"
+#include "Core/ParallelUtil.h"
+#include "Core/SRayIntersection.h"
+#include "Core/Render/CCamera.h"
+#include "Core/Render/CGraphics.h"
+#include "Core/Render/CRenderer.h"
+#include "Core/Render/SViewInfo.h"
+#include "Core/Resource/CDependencyTree.h"
+#include "Core/Resource/CTexture.h"
+#include "Core/Resource/CWorld.h"
+#include "Core/Resource/Area/CGameArea.h"
+#include "Core/Resource/Model/CModel.h"
+#include "Core/Resource/Model/SSurface.h"
 #include "Core/Resource/Cooker/CResourceCooker.h"
+#include "Core/Resource/Factory/CTextureDecoder.h"
 #include <Common/FileUtil.h>
 #include <Common/Log.h>
 #include <Common/FileIO/CFileInStream.h>
 #include <Common/FileIO/CFileOutStream.h>
+#include <Common/FileIO/CMemoryInStream.h>
 #include <Common/Math/MathUtil.h>
+#include <fmt/format.h>
 
 #include <algorithm>
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <map>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <sstream>
+#include <string_view>
+#include <thread>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__APPLE__)
+#include <mach/mach.h>
+#else
+#include <unistd.h>
+#endif
 
 namespace NCoreTests
 {
@@ -53,33 +97,323 @@ static bool ParseToken(const char* pkToken, int argc, char* argv[])
     return false;
 }
 
+/** Parameters shared by the tests that open a project */
+struct SProjectTestArgs
+{
+    TString Project;
+    uint32_t MaxAreas = 4;
+};
+
+/** Parses -project and -areas for a project test. These tests are meant to run headless as well
+ *  (e.g. QT_QPA_PLATFORM=offscreen on Mesa llvmpipe), so usage is printed rather than shown in a message box. */
+static std::optional<SProjectTestArgs> ParseProjectTestArgs(const char* pkUsage, int argc, char* argv[])
+{
+    const char* pkProject = ParseParameter("-project", argc, argv);
+    const char* pkMaxAreas = ParseParameter("-areas", argc, argv);
+
+    if (!pkProject)
+    {
+        NLog::Error("Usage: {}", pkUsage);
+        return std::nullopt;
+    }
+
+    SProjectTestArgs Args;
+    Args.Project = pkProject;
+
+    if (pkMaxAreas)
+        Args.MaxAreas = static_cast<uint32_t>(std::atoi(pkMaxAreas));
+
+    return Args;
+}
+
 /** Check commandline input to see if the user is running a test */
-bool RunTests(int argc, char* argv[])
+bool RunTests(int argc, char* argv[], int& rOutExitCode)
 {
+    rOutExitCode = 0;
+
     if (ParseToken("ValidateCooker", argc, argv))
     {
         // Fetch parameters
         const char* pkType = ParseParameter("-type", argc, argv);
         EResourceType Type = TEnumReflection<EResourceType>::ConvertStringToValue(pkType);
         bool AllowDump = ParseToken("-allowdump", argc, argv);
+        const char* pkReport = ParseParameter("-report", argc, argv);
 
         if (Type == EResourceType::Invalid)
         {
-            gpUIRelay->ShowMessageBox("ValidateCooker", "Usage: ValidateCooker -type=<ResourceType> [-allowdump] [-project=<Project>]");
+            gpUIRelay->ShowMessageBox("ValidateCooker", "Usage: ValidateCooker -type=<ResourceType> [-allowdump] [-report=<Report.csv>] [-project=<Project>]");
         }
         else if (gpUIRelay->OpenProject(ParseParameter("-project", argc, argv)))
         {
-            ValidateCooker(Type, AllowDump);
+            std::vector<SCookerValidationResult> Results;
+            const bool Success = ValidateCooker(Type, AllowDump, pkReport ? &Results : nullptr);
+
+            if (pkReport)
+                WriteCookerReport(pkReport, Results);
+
+            rOutExitCode = Success ? 0 : 1;
+        }
+        return true;
+    }
+
+    if (ParseToken("Benchmark", argc, argv))
+    {
+        // Fetch parameters
+        const char* pkProject = ParseParameter("-project", argc, argv);
+        const char* pkOutput = ParseParameter("-out", argc, argv);
+        const char* pkBaseline = ParseParameter("-baseline", argc, argv);
+        const char* pkTypes = ParseParameter("-types", argc, argv);
+        const char* pkTolerance = ParseParameter("-tolerance", argc, argv);
+
+        std::set<EResourceType> Types;
+        bool ValidTypes = true;
+
+        if (pkTypes)
+        {
+            for (const TString& rkTypeName : TString(pkTypes).Split(","))
+            {
+                const EResourceType Type = TEnumReflection<EResourceType>::ConvertStringToValue(*rkTypeName);
+                ValidTypes &= (Type != EResourceType::Invalid);
+                Types.insert(Type);
+            }
+        }
+
+        if (!pkProject || !ValidTypes)
+        {
+            // This mode is meant for machines without a display, so print usage rather than showing a message box
+            NLog::Error("Usage: Benchmark -project=<Project> [-out=<Results.csv>] [-baseline=<Baseline.csv>] "
+                        "[-tolerance=<Fraction>] [-types=<ResourceType>,...]");
+            rOutExitCode = 1;
+        }
+        else
+        {
+            const double Tolerance = (pkTolerance ? std::atof(pkTolerance) : 0.1);
+            const bool Success = RunBenchmarks(pkProject, Types, pkOutput ? pkOutput : "BenchmarkResults.csv",
+                                               pkBaseline ? pkBaseline : "", Tolerance);
+            rOutExitCode = Success ? 0 : 1;
         }
         return true;
     }
 
+    if (ParseToken("ValidatePicking", argc, argv))
+    {
+        const char* pkTolerance = ParseParameter("-tolerance", argc, argv);
+        const auto Args = ParseProjectTestArgs("ValidatePicking -project=<Project> [-areas=<MaxAreas>] [-tolerance=<Fraction>]", argc, argv);
+        const double Tolerance = (pkTolerance ? std::atof(pkTolerance) : 0.05);
+        rOutExitCode = (Args && ValidatePicking(Args->Project, Args->MaxAreas, Tolerance)) ? 0 : 1;
+        return true;
+    }
+
+    if (ParseToken("ValidateGeometryResidency", argc, argv))
+    {
+        const auto Args = ParseProjectTestArgs("ValidateGeometryResidency -project=<Project> [-areas=<MaxAreas>]", argc, argv);
+        rOutExitCode = (Args && ValidateGeometryResidency(Args->Project, Args->MaxAreas)) ? 0 : 1;
+        return true;
+    }
+
+    if (ParseToken("ValidateAreaPreloader", argc, argv))
+    {
+        const auto Args = ParseProjectTestArgs("ValidateAreaPreloader -project=<Project> [-areas=<MaxAreas>]", argc, argv);
+        rOutExitCode = (Args && ValidateAreaPreloader(Args->Project, Args->MaxAreas)) ? 0 : 1;
+        return true;
+    }
+
+    if (ParseToken("ValidateShaderCache", argc, argv))
+    {
+        // Uses its own directory so the real cache isn't touched
+        const char* pkDir = ParseParameter("-dir", argc, argv);
+        rOutExitCode = ValidateShaderCache(pkDir ? pkDir : "ShaderCacheTest/") ? 0 : 1;
+        return true;
+    }
+
+    if (ParseToken("ValidateMemoryAccounting", argc, argv))
+    {
+        const auto Args = ParseProjectTestArgs("ValidateMemoryAccounting -project=<Project>", argc, argv);
+        rOutExitCode = (Args && ValidateMemoryAccounting(Args->Project)) ? 0 : 1;
+        return true;
+    }
+
     // No test being run.
     return false;
 }
 
+/** A cooker validation job; owns the data for one resource while its batch is in flight */
+struct SCookerValidationJob
+{
+    TString CookedPath;
+    bool Opened = false;
+    std::vector<uint8> OriginalData;
+    std::vector<char> NewData;
+    SCookerValidationResult Result;
+};
+
+/** Named section of the original file, used to label mismatch ranges */
+struct SFileSection
+{
+    uint32 Offset;
+    uint32 Size;
+    TString Name;
+};
+
+/** Splits an uncompressed (MP1 and earlier) MREA into its sections. Later games compress their
+ *  sections into blocks, so file offsets don't correspond to sections and nothing is returned. */
+static std::vector<SFileSection> GetMREASectionLayout(const std::vector<uint8>& rkData, EGame Game)
+{
+    std::vector<SFileSection> Sections;
+
+    if (Game > EGame::Prime || rkData.size() < 0x60)
+        return Sections;
+
+    CMemoryInStream MREA(rkData.data(), rkData.size(), std::endian::big);
+    MREA.Seek(0x3C, SEEK_SET);
+    const uint32 NumSections = MREA.ReadU32();
+
+    // Block numbers in the order the header stores them
+    static constexpr std::array kBlockNames { "Geometry", "ScriptLayers", "Collision", "Unknown",
+                                              "Lights", "Visibility", "Path", "AROT" };
+    std::array<uint32, kBlockNames.size()> BlockNums{};
+
+    for (uint32& rNum : BlockNums)
+        rNum = MREA.ReadU32();
+
+    const size_t HeaderEnd = Math::Align(0x60 + size_t{NumSections} * 4, size_t{32});
+
+    if (NumSections == 0 || HeaderEnd > rkData.size())
+        return Sections;
+
+    Sections.push_back(SFileSection{0, static_cast<uint32>(HeaderEnd), "Header"});
+    MREA.Seek(0x60, SEEK_SET);
+    auto Offset = static_cast<uint32>(HeaderEnd);
+
+    for (uint32 SecIdx = 0; SecIdx < NumSections; SecIdx++)
+    {
+        // Name each section after the nearest block that starts at or before it
+        TString Name = fmt::format("Section {}", SecIdx);
+        uint32 BestNum = 0;
+
+        for (size_t BlockIdx = 0; BlockIdx < BlockNums.size(); BlockIdx++)
+        {
+            const uint32 Num = BlockNums[BlockIdx];
+
+            if (Num <= SecIdx && Num >= BestNum && Num != UINT32_MAX)
+            {
+                BestNum = Num;
+                Name = (Num == SecIdx ? fmt::format("{} ({})", kBlockNames[BlockIdx], SecIdx)
+                                      : fmt::format("{}+{} ({})", kBlockNames[BlockIdx], SecIdx - Num, SecIdx));
+            }
+        }
+
+        const uint32 Size = MREA.ReadU32();
+        Sections.push_back(SFileSection{Offset, Size, std::move(Name)});
+        Offset += Size;
+    }
+
+    return Sections;
+}
+
+static TString SectionForOffset(const std::vector<SFileSection>& rkSections, size_t Offset)
+{
+    for (const SFileSection& rkSection : rkSections)
+    {
+        if (Offset >= rkSection.Offset && Offset - rkSection.Offset < rkSection.Size)
+            return rkSection.Name;
+    }
+
+    return "";
+}
+
+/** Compares recooked data against the original and fills out the job's result. Safe to call from worker threads. */
+static void CompareCookedData(SCookerValidationJob& rJob, EGame Game, EResourceType Type)
+{
+    // Differences separated by fewer bytes than this are reported as a single range
+    constexpr size_t kMergeDistance = 16;
+    // Stop recording ranges past this point; a badly broken cooker would otherwise produce one per byte
+    constexpr size_t kMaxMismatches = 256;
+
+    const std::vector<uint8>& rkOld = rJob.OriginalData;
+    const std::vector<char>& rkNew = rJob.NewData;
+    SCookerValidationResult& rResult = rJob.Result;
+    rResult.OriginalSize = rkOld.size();
+    rResult.NewSize = rkNew.size();
+
+    const std::vector<SFileSection> Sections = (Type == EResourceType::Area ? GetMREASectionLayout(rkOld, Game)
+                                                                            : std::vector<SFileSection>{});
+
+    auto AddMismatch = [&](size_t Start, size_t End)
+    {
+        if (!rResult.Mismatches.empty())
+        {
+            SCookerMismatch& rLast = rResult.Mismatches.back();
+
+            if (Start - (rLast.Offset + rLast.Size) < kMergeDistance)
+            {
+                rLast.Size = End - rLast.Offset;
+                return;
+            }
+        }
+
+        if (rResult.Mismatches.size() >= kMaxMismatches)
+        {
+            rResult.MismatchesTruncated = true;
+            return;
+        }
+
+        rResult.Mismatches.push_back(SCookerMismatch{Start, End - Start, SectionForOffset(Sections, Start)});
+    };
+
+    // Collect differing ranges within the data both files have
+    const size_t DataSize = std::min(rkOld.size(), rkNew.size());
+
+    for (size_t Offset = 0; Offset < DataSize; Offset++)
+    {
+        if (rkOld[Offset] == static_cast<uint8>(rkNew[Offset]))
+            continue;
+
+        const size_t Start = Offset;
+
+        while (Offset < DataSize && rkOld[Offset] != static_cast<uint8>(rkNew[Offset]))
+            Offset++;
+
+        AddMismatch(Start, Offset);
+    }
+
+    const bool DataMismatch = !rResult.Mismatches.empty();
+
+    // The original asset can have alignment padding at the end, which is applied by the pak
+    // but usually preserved in extracted files. Missing padding doesn't indicate malformed data.
+    bool MissingData = false;
+
+    if (rkOld.size() > rkNew.size())
+    {
+        size_t End = rkOld.size();
+
+        while (End > DataSize && rkOld[End - 1] == 0xFF)
+            End--;
+
+        if (End > DataSize)
+        {
+            MissingData = true;
+            AddMismatch(DataSize, End);
+        }
+    }
+    else if (rkNew.size() > rkOld.size())
+    {
+        AddMismatch(DataSize, rkNew.size());
+    }
+
+    // Sizes must match once alignment is applied, and data can't be added
+    const size_t kAlignment = (Game >= EGame::Corruption ? 64 : 32);
+
+    if (Math::Align(rkOld.size(), kAlignment) != Math::Align(rkNew.size(), kAlignment) || rkOld.size() < rkNew.size())
+        rResult.pkFailReason = "size mismatch";
+    else if (DataMismatch)
+        rResult.pkFailReason = "data mismatch";
+    else if (MissingData)
+        rResult.pkFailReason = "missing data";
+}
+
 /** Validate all cooker output for the given resource type matches the original asset data */
-bool ValidateCooker(EResourceType ResourceType, bool DumpInvalidFileContents)
+bool ValidateCooker(EResourceType ResourceType, bool DumpInvalidFileContents, std::vector<SCookerValidationResult>* pOutResults)
 {
     NLog::Debug("Validating output of {} cooker...",
                 TEnumReflection<EResourceType>::ConvertValueToString(ResourceType));
@@ -94,106 +428,120 @@ bool ValidateCooker(EResourceType ResourceType, bool DumpInvalidFileContents)
         return false;
     }
 
-    TString ResourcesDir = pProject->ResourcesDir(false);
-    uint NumValid = 0, NumInvalid = 0;
+    const TString ResourcesDir = pProject->ResourcesDir(false);
+    const EGame Game = pProject->Game();
+    std::vector<SCookerValidationJob> Jobs;
 
-    // Iterate through all resources
     for (const auto& It : MakeResourceView(pStore))
     {
         if (It->ResourceType() != ResourceType || !It->HasCookedVersion())
             continue;
 
-        // Get original cooked data
-        TString CookedPath = It->CookedAssetPath(true);
-        CFileInStream FileStream(ResourcesDir / CookedPath, std::endian::big);
+        SCookerValidationJob& rJob = Jobs.emplace_back();
+        rJob.CookedPath = It->CookedAssetPath(true);
+        rJob.Result.pEntry = It.get();
+    }
+
+    // Entries are validated in batches. Reading original files and comparing the output runs on
+    // worker threads; the next batch is read while the current one is being cooked.
+    const size_t kBatchSize = std::max<size_t>(ParallelUtil::WorkerCount(SIZE_MAX) * 4, 16);
 
-        if (!FileStream.IsValid())
-            continue;
+    auto ReadBatch = [&](size_t First)
+    {
+        const size_t Count = std::min(kBatchSize, Jobs.size() - First);
+
+        ParallelUtil::ParallelFor(Count, [&](size_t Index)
+        {
+            SCookerValidationJob& rJob = Jobs[First + Index];
+            CFileInStream FileStream(ResourcesDir / rJob.CookedPath, std::endian::big);
+
+            if (!FileStream.IsValid())
+                return;
 
-        std::vector<uint8> OriginalData(FileStream.Size());
-        FileStream.ReadBytes(OriginalData.data(), OriginalData.size());
-        FileStream.Close();
+            rJob.OriginalData.resize(FileStream.Size());
+            FileStream.ReadBytes(rJob.OriginalData.data(), rJob.OriginalData.size());
+            rJob.Opened = true;
+        });
+    };
 
-        // Generate new cooked data
-        std::vector<char> NewData;
-        CVectorOutStream MemoryStream(&NewData, std::endian::big);
-        CResourceCooker::CookResource(It.get(), MemoryStream);
+    uint NumValid = 0, NumInvalid = 0;
+    std::future<void> PendingRead;
+
+    if (!Jobs.empty())
+        PendingRead = std::async(std::launch::async, ReadBatch, 0);
+
+    for (size_t First = 0; First < Jobs.size(); First += kBatchSize)
+    {
+        const std::span Batch(Jobs.data() + First, std::min(kBatchSize, Jobs.size() - First));
+        PendingRead.get();
+
+        if (First + kBatchSize < Jobs.size())
+            PendingRead = std::async(std::launch::async, ReadBatch, First + kBatchSize);
+
+        // Loading and cooking go through the resource store, which isn't thread-safe, so they stay on this thread
+        for (SCookerValidationJob& rJob : Batch)
+        {
+            if (!rJob.Opened)
+                continue;
+
+            CVectorOutStream MemoryStream(&rJob.NewData, std::endian::big);
+            CResourceCooker::CookResource(rJob.Result.pEntry, MemoryStream);
+        }
 
-        // Start our comparison by making sure the sizes match up
-        const size_t kAlignment         = (It->Game() >= EGame::Corruption ? 64 : 32);
-        const auto kAlignedOriginalSize = Math::Align(OriginalData.size(), kAlignment);
-        const auto kAlignedNewSize      = Math::Align(NewData.size(), kAlignment);
-        const char* pkInvalidReason     = "";
-        bool IsValid                    = false;
+        ParallelUtil::ParallelFor(Batch.size(), [&](size_t Index)
+        {
+            if (Batch[Index].Opened)
+                CompareCookedData(Batch[Index], Game, ResourceType);
+        });
 
-        if (kAlignedOriginalSize == kAlignedNewSize &&
-            OriginalData.size() >= NewData.size())
+        // Print test results
+        for (SCookerValidationJob& rJob : Batch)
         {
-            // Compare actual data. Note that the original asset can have alignment padding
-            // at the end, which is applied by the pak but usually preserved in extracted
-            // files. We do not include this in the comparison as missing padding does not
-            // indicate malformed data.
-            const auto DataSize = std::min(OriginalData.size(), NewData.size());
+            if (!rJob.Opened)
+                continue;
+
+            const SCookerValidationResult& rkResult = rJob.Result;
 
-            if (memcmp(OriginalData.data(), NewData.data(), DataSize) == 0)
+            if (rkResult.IsValid())
             {
-                // Verify any missing data at the end is padding.
-                bool MissingData = false;
+                NLog::Debug("[SUCCESS] {}", *rJob.CookedPath);
+                NumValid++;
+            }
+            else
+            {
+                NLog::Debug("[FAILED: {}] {} ({} bytes, original {}, {} mismatched ranges{})",
+                            rkResult.pkFailReason, *rJob.CookedPath, rkResult.NewSize, rkResult.OriginalSize,
+                            rkResult.Mismatches.size(), rkResult.MismatchesTruncated ? "+" : "");
 
-                if (OriginalData.size() > NewData.size())
+                for (const SCookerMismatch& rkMismatch : rkResult.Mismatches)
                 {
-                    for (size_t i = DataSize; i < OriginalData.size(); i++)
-                    {
-                        if (OriginalData[i] != 0xFF)
-                        {
-                            MissingData = true;
-                            break;
-                        }
-                    }
+                    NLog::Debug("    0x{:X}-0x{:X} {}", rkMismatch.Offset, rkMismatch.Offset + rkMismatch.Size,
+                                *rkMismatch.Section);
                 }
 
-                if (!MissingData)
-                {
-                    // All tests passed!
-                    IsValid = true;
-                }
-                else
-                {
-                    pkInvalidReason = "missing data";
-                }
+                NumInvalid++;
             }
-            else
+
+            if (DumpInvalidFileContents)
             {
-                pkInvalidReason = "data mismatch";
-            }
-        }
-        else
-        {
-            pkInvalidReason = "size mismatch";
-        }
+                TString DumpPath = "dump" / rJob.CookedPath;
+                FileUtil::MakeDirectory(DumpPath.GetFileDirectory());
 
-        // Print test results
-        if (IsValid)
-        {
-            NLog::Debug("[SUCCESS] {}", *CookedPath);
-            NumValid++;
-        }
-        else
-        {
-            NLog::Debug("[FAILED: {}] {}", pkInvalidReason, *CookedPath);
-            NumInvalid++;
-        }
+                CFileOutStream DumpFile(DumpPath, std::endian::big);
+                DumpFile.WriteBytes(rJob.NewData.data(), rJob.NewData.size());
+                DumpFile.Close();
+            }
 
-        if (DumpInvalidFileContents)
-        {
-            TString DumpPath = "dump" / CookedPath;
-            FileUtil::MakeDirectory(DumpPath.GetFileDirectory());
+            if (pOutResults)
+                pOutResults->push_back(std::move(rJob.Result));
 
-            CFileOutStream DumpFile(DumpPath, std::endian::big);
-            DumpFile.WriteBytes(NewData.data(), NewData.size());
-            DumpFile.Close();
+            rJob.OriginalData = {};
+            rJob.NewData = {};
         }
 
+        // Unload this batch so memory doesn't grow with the number of resources validated
+        pStore->DestroyUnreferencedResources();
+
         if (NumInvalid >= 100)
         {
             NLog::Debug("Test aborted; at least 100 invalid resources. Checked {} resources, {} passed, {} failed",
@@ -211,4 +559,1024 @@ bool ValidateCooker(EResourceType ResourceType, bool DumpInvalidFileContents)
     return TestSuccess;
 }
 
+/** Writes cooker validation results as CSV, one row per mismatched range */
+bool WriteCookerReport(const TString& rkPath, const std::vector<SCookerValidationResult>& rkResults)
+{
+    std::ofstream Out(*rkPath);
+
+    if (!Out)
+    {
+        NLog::Error("Failed to write cooker report: {}", *rkPath);
+        return false;
+    }
+
+    Out << "Resource,Result,OriginalSize,NewSize,SizeDelta,MismatchOffset,MismatchSize,Section\n";
+
+    for (const SCookerValidationResult& rkResult : rkResults)
+    {
+        const TString Path = rkResult.pEntry->CookedAssetPath(true);
+        const char* pkStatus = (rkResult.IsValid() ? "valid" : rkResult.pkFailReason);
+        const auto Row = fmt::format("{},{},{},{},{}", *Path, pkStatus, rkResult.OriginalSize, rkResult.NewSize, rkResult.SizeDelta());
+
+        if (rkResult.Mismatches.empty())
+            Out << Row << ",,,\n";
+
+        for (const SCookerMismatch& rkMismatch : rkResult.Mismatches)
+            Out << Row << fmt::format(",{},{},{}\n", rkMismatch.Offset, rkMismatch.Size, *rkMismatch.Section);
+    }
+
+    return true;
+}
+
+/** Progress notifier that discards all updates, for loading projects with no UI */
+class CNullProgressNotifier : public IProgressNotifier
+{
+public:
+    bool ShouldCancel() const override { return false; }
+
+protected:
+    void UpdateProgress(const std::string&, const std::string&, float) override {}
+};
+
+/** Returns the current resident memory usage of the process, in kilobytes.
+ *  Unlike the OS peak counters this can go back down, so it can be sampled per benchmark group. */
+static uint64 ResidentMemoryKB()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS Counters;
+
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &Counters, sizeof(Counters)))
+        return 0;
+
+    return Counters.WorkingSetSize / 1024;
+#elif defined(__APPLE__)
+    mach_task_basic_info Info{};
+    mach_msg_type_number_t Count = MACH_TASK_BASIC_INFO_COUNT;
+
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&Info), &Count) != KERN_SUCCESS)
+        return 0;
+
+    return Info.resident_size / 1024;
+#else
+    // The second field of statm is the resident set size in pages
+    std::ifstream Statm("/proc/self/statm");
+    uint64 TotalPages = 0, ResidentPages = 0;
+
+    if (!(Statm >> TotalPages >> ResidentPages))
+        return 0;
+
+    return ResidentPages * static_cast<uint64>(sysconf(_SC_PAGESIZE)) / 1024;
+#endif
+}
+
+/** Timings for one benchmark, in milliseconds */
+struct SBenchmarkResult
+{
+    TString Name;
+    std::vector<double> Samples;
+    /** Largest rise in resident memory above the group's starting point while one of its resources was held */
+    uint64 PeakIncreaseKB = 0;
+    /** Process resident memory once the group finished; includes anything earlier groups left behind */
+    uint64 ResidentKB = 0;
+
+    explicit SBenchmarkResult(TString InName) : Name(std::move(InName)) {}
+
+    /** Nearest-rank percentile; Samples must be sorted */
+    double Percentile(double Fraction) const
+    {
+        if (Samples.empty())
+            return 0.0;
+
+        const auto Rank = static_cast<size_t>(std::ceil(Fraction * Samples.size()));
+        return Samples[std::clamp<size_t>(Rank, 1, Samples.size()) - 1];
+    }
+};
+
+/** Median time and peak memory increase recorded for a benchmark in a baseline file */
+struct SBaselineEntry
+{
+    double MedianMs = 0.0;
+    uint64 PeakIncreaseKB = 0;
+};
+
+static const char* const skBenchmarkHeader = "Benchmark,Count,TotalMs,MeanMs,P50Ms,P90Ms,P99Ms,MaxMs,PeakIncreaseKB,ResidentKB";
+
+static double ElapsedMs(std::chrono::steady_clock::time_point Start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - Start).count();
+}
+
+static bool WriteBenchmarkResults(const TString& rkPath, std::vector<SBenchmarkResult>& rResults)
+{
+    std::ofstream Out(*rkPath);
+
+    if (!Out)
+    {
+        NLog::Error("Failed to write benchmark results: {}", *rkPath);
+        return false;
+    }
+
+    Out << skBenchmarkHeader << '\n';
+
+    for (SBenchmarkResult& rResult : rResults)
+    {
+        std::ranges::sort(rResult.Samples);
+
+        double Total = 0.0;
+        for (double Sample : rResult.Samples)
+            Total += Sample;
+
+        const size_t Count = rResult.Samples.size();
+        Out << fmt::format("{},{},{:.4f},{:.4f},{:.4f},{:.4f},{:.4f},{:.4f},{},{}\n",
+                           *rResult.Name, Count, Total, Count ? Total / Count : 0.0,
+                           rResult.Percentile(0.5), rResult.Percentile(0.9), rResult.Percentile(0.99),
+                           Count ? rResult.Samples.back() : 0.0, rResult.PeakIncreaseKB, rResult.ResidentKB);
+    }
+
+    return true;
+}
+
+static bool ReadBenchmarkBaseline(const TString& rkPath, std::map<TString, SBaselineEntry>& rOut)
+{
+    std::ifstream In(*rkPath);
+
+    if (!In)
+    {
+        NLog::Error("Failed to open benchmark baseline: {}", *rkPath);
+        return false;
+    }
+
+    std::string Line;
+    std::getline(In, Line);
+
+    if (Line != skBenchmarkHeader)
+    {
+        NLog::Error("Benchmark baseline has an unrecognized format: {}", *rkPath);
+        return false;
+    }
+
+    while (std::getline(In, Line))
+    {
+        std::vector<std::string> Columns;
+        std::stringstream LineStream(Line);
+
+        for (std::string Column; std::getline(LineStream, Column, ',');)
+            Columns.push_back(std::move(Column));
+
+        if (Columns.size() != 10)
+            continue;
+
+        SBaselineEntry& rEntry = rOut[TString(Columns[0])];
+        rEntry.MedianMs = std::atof(Columns[4].c_str());
+        rEntry.PeakIncreaseKB = std::strtoull(Columns[8].c_str(), nullptr, 10);
+    }
+
+    return true;
+}
+
+/** Compares results against a baseline; returns false if anything regressed beyond the tolerance */
+static bool CompareBenchmarkBaseline(const std::vector<SBenchmarkResult>& rkResults,
+                                     const std::map<TString, SBaselineEntry>& rkBaseline, double Tolerance)
+{
+    // Ignore differences this small; they're within timer and allocator noise
+    constexpr double kMinRegressionMs = 0.05;
+    constexpr uint64 kMinRegressionKB = 1024;
+    uint NumRegressions = 0;
+
+    for (const SBenchmarkResult& rkResult : rkResults)
+    {
+        const auto It = rkBaseline.find(rkResult.Name);
+
+        if (It == rkBaseline.end())
+        {
+            NLog::Debug("[NEW] {}", *rkResult.Name);
+            continue;
+        }
+
+        const SBaselineEntry& rkBase = It->second;
+        const double Median = rkResult.Percentile(0.5);
+
+        if (Median > rkBase.MedianMs * (1.0 + Tolerance) && Median - rkBase.MedianMs > kMinRegressionMs)
+        {
+            NLog::Error("[REGRESSION] {}: median {:.4f}ms, baseline {:.4f}ms", *rkResult.Name, Median, rkBase.MedianMs);
+            NumRegressions++;
+        }
+
+        if (rkResult.PeakIncreaseKB > rkBase.PeakIncreaseKB * (1.0 + Tolerance) &&
+            rkResult.PeakIncreaseKB - rkBase.PeakIncreaseKB > kMinRegressionKB)
+        {
+            NLog::Error("[REGRESSION] {}: peak memory increase {}KB, baseline {}KB", *rkResult.Name, rkResult.PeakIncreaseKB, rkBase.PeakIncreaseKB);
+            NumRegressions++;
+        }
+    }
+
+    NLog::Debug("Baseline comparison {}; {} regressions at {:.0f}% tolerance",
+                NumRegressions == 0 ? "SUCCEEDED" : "FAILED", NumRegressions, Tolerance * 100.0);
+
+    return NumRegressions == 0;
+}
+
+/** Time cooked load, cook, texture decode and dependency tree building for every resource in a project */
+bool RunBenchmarks(const TString& rkProjectPath, const std::set<EResourceType>& rkTypes,
+                   const TString& rkOutputPath, const TString& rkBaselinePath, double Tolerance)
+{
+    using Clock = std::chrono::steady_clock;
+    std::vector<SBenchmarkResult> Results;
+
+    // Open the project directly; going through the UI relay would bring up the editor's windows
+    NLog::Debug("Benchmarking project: {}", *rkProjectPath);
+    CNullProgressNotifier Progress;
+
+    uint64 BeforeKB = ResidentMemoryKB();
+    auto Start = Clock::now();
+    std::unique_ptr<CGameProject> pProject = CGameProject::LoadProject(rkProjectPath, &Progress);
+
+    if (!pProject)
+    {
+        NLog::Error("Benchmark failed; couldn't open project: {}", *rkProjectPath);
+        return false;
+    }
+
+    Results.emplace_back("Project.Open").Samples.push_back(ElapsedMs(Start));
+    Results.back().ResidentKB = ResidentMemoryKB();
+    Results.back().PeakIncreaseKB = Results.back().ResidentKB - std::min(BeforeKB, Results.back().ResidentKB);
+
+    CResourceStore* pStore = pProject->ResourceStore();
+    CResourceStore* pOldStore = gpResourceStore;
+    gpResourceStore = pStore;
+
+    // Group entries by type so each type's resources are measured together
+    std::map<EResourceType, std::vector<CResourceEntry*>> EntriesByType;
+
+    for (const auto& It : MakeResourceView(pStore))
+    {
+        if (It->HasCookedVersion() && (rkTypes.empty() || rkTypes.contains(It->ResourceType())))
+            EntriesByType[It->ResourceType()].push_back(It.get());
+    }
+
+    for (const auto& [Type, Entries] : EntriesByType)
+    {
+        const TString TypeName = TEnumReflection<EResourceType>::ConvertValueToString(Type);
+        NLog::Debug("Benchmarking {} {} resources...", Entries.size(), *TypeName);
+
+        // The OS peak counters only ever grow, so a type that stays under an earlier type's peak would report
+        // nothing; instead sample resident memory while each resource is held, relative to where this type started
+        BeforeKB = ResidentMemoryKB();
+        uint64 PeakIncreaseKB = 0;
+        SBenchmarkResult Load(TypeName + ".Load");
+        SBenchmarkResult Cook(TypeName + ".Cook");
+        SBenchmarkResult Decode(TypeName + ".FullDecode");
+        SBenchmarkResult Dependencies(TypeName + ".Dependencies");
+        bool CanCook = true;
+
+        for (CResourceEntry* pEntry : Entries)
+        {
+            // Resources that were pulled in as a dependency and are still held can't be timed cold
+            if (pEntry->IsLoaded())
+                continue;
+
+            // Read the file up front so disk access isn't counted as load time
+            CFileInStream File(pEntry->CookedAssetPath(), std::endian::big);
+
+            if (!File.IsValid())
+                continue;
+
+            std::vector<uint8> Data(File.Size());
+            File.ReadBytes(Data.data(), Data.size());
+            File.Close();
+
+            CMemoryInStream LoadInput(Data.data(), Data.size(), std::endian::big);
+            Start = Clock::now();
+            CResource* pRes = pEntry->LoadCooked(LoadInput);
+            Load.Samples.push_back(ElapsedMs(Start));
+
+            if (!pRes)
+            {
+                NLog::Warn("Failed to load resource: {}", *pEntry->CookedAssetPath(true));
+                continue;
+            }
+
+            if (pEntry->TypeInfo()->CanHaveDependencies())
+            {
+                Start = Clock::now();
+                std::unique_ptr<CDependencyTree> pTree = pRes->BuildDependencyTree();
+                Dependencies.Samples.push_back(ElapsedMs(Start));
+            }
+
+            // Regular loads only partially decode textures; time the full RGBA decode separately
+            if (Type == EResourceType::Texture)
+            {
+                CMemoryInStream DecodeInput(Data.data(), Data.size(), std::endian::big);
+                Start = Clock::now();
+                std::unique_ptr<CTexture> pDecoded = CTextureDecoder::DoFullDecode(DecodeInput, pEntry);
+                Decode.Samples.push_back(ElapsedMs(Start));
+            }
+
+            // Stop cooking this type after the first failure; most types have no cooker
+            if (CanCook)
+            {
+                std::vector<char> CookedData;
+                CVectorOutStream CookOutput(&CookedData, std::endian::big);
+                Start = Clock::now();
+                CanCook = CResourceCooker::CookResource(pEntry, CookOutput);
+
+                if (CanCook)
+                    Cook.Samples.push_back(ElapsedMs(Start));
+            }
+
+            const uint64 HeldKB = ResidentMemoryKB();
+            PeakIncreaseKB = std::max(PeakIncreaseKB, HeldKB - std::min(BeforeKB, HeldKB));
+
+            // Unload the resource along with anything it pulled in before measuring the next one
+            pStore->DestroyUnreferencedResources();
+        }
+
+        const uint64 AfterKB = ResidentMemoryKB();
+
+        for (SBenchmarkResult* pResult : {&Load, &Cook, &Decode, &Dependencies})
+        {
+            if (!pResult->Samples.empty())
+            {
+                pResult->PeakIncreaseKB = PeakIncreaseKB;
+                pResult->ResidentKB = AfterKB;
+                Results.push_back(std::move(*pResult));
+            }
+        }
+    }
+
+    gpResourceStore = pOldStore;
+    pProject.reset();
+
+    if (!WriteBenchmarkResults(rkOutputPath, Results))
+        return false;
+
+    NLog::Debug("Benchmark complete; {} results written to {}", Results.size(), *rkOutputPath);
+
+    if (rkBaselinePath.IsEmpty())
+        return true;
+
+    std::map<TString, SBaselineEntry> Baseline;
+
+    if (!ReadBenchmarkBaseline(rkBaselinePath, Baseline))
+        return false;
+
+    return CompareBenchmarkBaseline(Results, Baseline, Tolerance);
+}
+
+/** Makes an offscreen OpenGL context current and sets up the global render state, for tests that draw */
+static bool InitOffscreenGraphics()
+{
+    if (!gpUIRelay->MakeOffscreenContextCurrent())
+        return false;
+
+    CGraphics::Initialize();
+    glEnable(GL_BLEND);
+    glEnable(GL_PRIMITIVE_RESTART);
+    glPrimitiveRestartIndex(0xFFFF);
+    glDepthFunc(GL_LEQUAL);
+    return true;
+}
+
+/** Loads the areas of every world in the store, up to MaxAreas, running rkFunc on each before unloading it.
+ *  Returns the number of areas visited. */
+static uint32_t ForEachTestArea(CResourceStore* pStore, uint32_t MaxAreas, const std::function<void(CWorld*, CGameArea*)>& rkFunc)
+{
+    uint32_t NumAreas = 0;
+
+    for (const auto& It : MakeResourceView(pStore))
+    {
+        if (NumAreas >= MaxAreas)
+            break;
+
+        if (It->ResourceType() != EResourceType::World)
+            continue;
+
+        TResPtr<CWorld> pWorld = It->Load();
+
+        for (size_t AreaIdx = 0; pWorld && AreaIdx < pWorld->NumAreas() && NumAreas < MaxAreas; AreaIdx++)
+        {
+            CResourceEntry* pAreaEntry = pStore->FindEntry(pWorld->AreaResourceID(AreaIdx));
+            TResPtr<CGameArea> pArea = (pAreaEntry ? pAreaEntry->Load() : nullptr);
+
+            if (!pArea)
+                continue;
+
+            pWorld->SetAreaLayerInfo(pArea);
+            rkFunc(pWorld, pArea);
+            NumAreas++;
+
+            // Unload the area before moving on to the next one
+            pArea = nullptr;
+            pStore->DestroyUnreferencedResources();
+        }
+    }
+
+    return NumAreas;
+}
+
+/** Counts the failed checks of a test, logging each one as it happens */
+class CTestChecks
+{
+    const char* mpkTestName;
+    uint32_t mNumFailures = 0;
+
+public:
+    explicit CTestChecks(const char* pkTestName)
+        : mpkTestName(pkTestName)
+    {}
+
+    void Fail(std::string_view Reason)
+    {
+        NLog::Error("{} test failed: {}", mpkTestName, Reason);
+        mNumFailures++;
+    }
+
+    void Check(bool Condition, std::string_view Description)
+    {
+        if (!Condition)
+            Fail(Description);
+    }
+
+    uint32_t NumFailures() const    { return mNumFailures; }
+    bool Passed() const             { return mNumFailures == 0; }
+};
+
+/** Opens a project for a test and makes its store the global one until the fixture goes out of scope.
+ *  Tests that draw can have an offscreen OpenGL context set up first. */
+class CTestProject
+{
+    std::unique_ptr<CGameProject> mpProject;
+    CResourceStore* mpOldStore = nullptr;
+
+public:
+    CTestProject(const TString& rkProjectPath, const char* pkTestName, bool NeedsGraphics)
+    {
+        if (NeedsGraphics && !InitOffscreenGraphics())
+        {
+            NLog::Error("{} test failed; couldn't create an OpenGL context", pkTestName);
+            return;
+        }
+
+        CNullProgressNotifier Progress;
+        mpProject = CGameProject::LoadProject(rkProjectPath, &Progress);
+
+        if (!mpProject)
+        {
+            NLog::Error("{} test failed; couldn't open project: {}", pkTestName, *rkProjectPath);
+            return;
+        }
+
+        mpOldStore = gpResourceStore;
+        gpResourceStore = mpProject->ResourceStore();
+    }
+
+    ~CTestProject()
+    {
+        if (mpProject)
+            gpResourceStore = mpOldStore;
+    }
+
+    CTestProject(const CTestProject&) = delete;
+    CTestProject& operator=(const CTestProject&) = delete;
+
+    bool IsValid() const            { return mpProject != nullptr; }
+    CResourceStore* Store() const   { return mpProject->ResourceStore(); }
+};
+
+/** Compare ID buffer picks against CPU ray casts over a grid of screen positions in each tested area */
+bool ValidatePicking(const TString& rkProjectPath, uint32_t MaxAreas, double Tolerance)
+{
+    NLog::Debug("Validating picking for project: {}", *rkProjectPath);
+
+    CTestProject Project(rkProjectPath, "Picking", true);
+
+    if (!Project.IsValid())
+        return false;
+
+    CResourceStore* pStore = Project.Store();
+
+    // Small viewport and a coarse grid; IDs only need to resolve around each sample
+    constexpr uint32 kViewportSize = 256;
+    constexpr int kGridSize = 8;
+    constexpr int kNumYawAngles = 4;
+
+    CScene Scene;
+    CRenderer Renderer;
+    Renderer.SetViewportSize(kViewportSize, kViewportSize);
+
+    CCamera Camera;
+    Camera.SetAspectRatio(1.f);
+
+    SViewInfo ViewInfo{};
+    ViewInfo.pScene = &Scene;
+    ViewInfo.pRenderer = &Renderer;
+    ViewInfo.pCamera = &Camera;
+    ViewInfo.GameMode = false;
+    ViewInfo.ShowFlags = EShowFlag::MergedWorld | EShowFlag::ObjectGeometry | EShowFlag::WorldCollision;
+
+    uint32_t NumSamples = 0;
+    uint32_t NumMismatches = 0;
+
+    const auto NodeName = [](const SRayIntersection& rkHit) { return rkHit.pNode ? *rkHit.pNode->Name() : "nothing"; };
+
+    const uint32_t NumAreas = ForEachTestArea(pStore, MaxAreas, [&](CWorld* pWorld, CGameArea* pArea)
+    {
+        Scene.SetActiveArea(pWorld, pArea);
+        Camera.Snap(pArea->AABox().Center());
+
+        // Look around from the middle of the area
+        for (int YawIdx = 0; YawIdx < kNumYawAngles; YawIdx++)
+        {
+            const float Yaw = YawIdx * Math::skHalfPi;
+            Camera.SetYaw(Yaw);
+            ViewInfo.ViewFrustum = Camera.FrustumPlanes();
+            CGraphics::sMVPBlock.ProjectionMatrix = Camera.ProjectionMatrix();
+
+            for (int Y = 0; Y < kGridSize; Y++)
+            {
+                for (int X = 0; X < kGridSize; X++)
+                {
+                    // Sample the center of each grid cell
+                    const CVector2f DeviceCoords(((X + 0.5f) / kGridSize) * 2.f - 1.f,
+                                                 ((Y + 0.5f) / kGridSize) * 2.f - 1.f);
+
+                    const SRayIntersection Ray = Scene.SceneRayCast(Camera.CastRay(DeviceCoords), ViewInfo);
+                    const SRayIntersection Pick = Scene.ScenePick(&Renderer, ViewInfo, DeviceCoords);
+                    NumSamples++;
+
+                    if (Ray.Hit != Pick.Hit || Ray.pNode != Pick.pNode)
+                    {
+                        NumMismatches++;
+                        NLog::Debug("Pick mismatch in {} at ({}, {}), yaw {}: ray hit {}, ID pick hit {}",
+                                    *pArea->Entry()->Name(), DeviceCoords.X, DeviceCoords.Y, Yaw,
+                                    NodeName(Ray), NodeName(Pick));
+                    }
+                }
+            }
+        }
+
+        Scene.ClearScene();
+    });
+
+    if (NumSamples == 0)
+    {
+        NLog::Error("Picking test failed; no areas could be loaded");
+        return false;
+    }
+
+    // Some disagreement is expected along silhouettes, where the pick searches neighbouring pixels,
+    // and on alpha-tested billboards, which the ray cast treats as solid
+    const double MismatchRate = static_cast<double>(NumMismatches) / NumSamples;
+    const bool Success = MismatchRate <= Tolerance;
+
+    if (Success)
+        NLog::Debug("Picking test passed; {}/{} samples disagreed across {} areas", NumMismatches, NumSamples, NumAreas);
+    else
+        NLog::Error("Picking test failed; {}/{} samples disagreed across {} areas (tolerance {:.1f}%)",
+                    NumMismatches, NumSamples, NumAreas, Tolerance * 100.0);
+
+    return Success;
+}
+
+/** Check that compacted world geometry still picks the same, and is restored once and recompacted when switching
+ *  between the merged terrain and the split world models */
+bool ValidateGeometryResidency(const TString& rkProjectPath, uint32_t MaxAreas)
+{
+    NLog::Debug("Validating geometry residency for project: {}", *rkProjectPath);
+
+    CTestProject Project(rkProjectPath, "Geometry residency", true);
+
+    if (!Project.IsValid())
+        return false;
+
+    CResourceStore* pStore = Project.Store();
+
+    const EGeometryResidency OldResidency = CBasicModel::GeometryResidency();
+    CBasicModel::SetGeometryResidency(EGeometryResidency::PositionsOnly);
+    CTestChecks Checks("Geometry residency");
+
+    const auto Fail = [&](const CGameArea* pkArea, const char* pkReason) {
+        Checks.Fail(fmt::format("{}: {}", *pkArea->Entry()->Name(), pkReason));
+    };
+
+    const auto AllWorldModels = [](const CGameArea* pkArea, const auto& rkPredicate) {
+        for (size_t iMdl = 0; iMdl < pkArea->NumWorldModels(); iMdl++)
+        {
+            if (!rkPredicate(pkArea->TerrainModel(iMdl)))
+                return false;
+        }
+        return true;
+    };
+
+    const auto IsFull = [](const CModel* pkModel) { return pkModel->HasFullGeometry(); };
+    const auto IsCompacted = [](const CModel* pkModel) {
+        for (size_t iSurf = 0; iSurf < pkModel->GetSurfaceCount(); iSurf++)
+        {
+            if (!pkModel->GetSurface(iSurf)->Compacted)
+                return false;
+        }
+        return true;
+    };
+
+    const uint32_t NumAreas = ForEachTestArea(pStore, MaxAreas, [&](CWorld*, CGameArea* pArea)
+    {
+        if (pArea->NumWorldModels() == 0 || pArea->NumStaticModels() == 0)
+            return;
+
+        // Cast a ray down through the middle of every surface while the full vertex data is still there
+        std::vector<std::pair<bool, float>> ReferenceHits;
+
+        const auto SurfaceRay = [](const SSurface* pkSurf) {
+            return CRay(pkSurf->AABox.Center() + CVector3f(0.f, 0.f, pkSurf->AABox.Size().Z + 1.f), CVector3f(0.f, 0.f, -1.f));
+        };
+
+        for (size_t iMdl = 0; iMdl < pArea->NumWorldModels(); iMdl++)
+        {
+            const CModel* pkModel = pArea->TerrainModel(iMdl);
+
+            for (size_t iSurf = 0; iSurf < pkModel->GetSurfaceCount(); iSurf++)
+                ReferenceHits.push_back(pkModel->GetSurface(iSurf)->IntersectsRay(SurfaceRay(pkModel->GetSurface(iSurf)), true));
+        }
+
+        const size_t FullBytes = pArea->MemoryUsage().CPUBytes;
+
+        // Uploading all of the merged terrain compacts the shared surfaces
+        for (size_t iMdl = 0; iMdl < pArea->NumStaticModels(); iMdl++)
+        {
+            if (!AllWorldModels(pArea, IsFull))
+                Fail(pArea, "Surfaces were compacted before all of the merged terrain was uploaded");
+
+            pArea->StaticModel(iMdl)->BufferGL();
+        }
+
+        if (!AllWorldModels(pArea, IsCompacted))
+            Fail(pArea, "Surfaces weren't compacted after uploading the merged terrain");
+
+        if (pArea->MemoryUsage().CPUBytes >= FullBytes)
+            Fail(pArea, "Compacting surfaces didn't reduce CPU memory usage");
+
+        // Compacted surfaces must pick exactly like the full ones
+        size_t HitIdx = 0;
+
+        for (size_t iMdl = 0; iMdl < pArea->NumWorldModels(); iMdl++)
+        {
+            const CModel* pkModel = pArea->TerrainModel(iMdl);
+
+            for (size_t iSurf = 0; iSurf < pkModel->GetSurfaceCount(); iSurf++)
+            {
+                if (pkModel->GetSurface(iSurf)->IntersectsRay(SurfaceRay(pkModel->GetSurface(iSurf)), true) != ReferenceHits[HitIdx++])
+                    Fail(pArea, "A compacted surface doesn't pick the same as the full surface");
+            }
+        }
+
+        // Switching to the split world restores everything on the first upload, then keeps it until the last one
+        for (size_t iMdl = 0; iMdl < pArea->NumWorldModels(); iMdl++)
+        {
+            pArea->TerrainModel(iMdl)->BufferGL();
+
+            if (iMdl + 1 < pArea->NumWorldModels() && !AllWorldModels(pArea, IsFull))
+                Fail(pArea, "Surfaces were compacted again before all of the world models were uploaded");
+        }
+
+        if (!AllWorldModels(pArea, IsCompacted))
+            Fail(pArea, "Surfaces weren't compacted again after uploading the world models");
+    });
+
+    CBasicModel::SetGeometryResidency(OldResidency);
+
+    if (NumAreas == 0)
+    {
+        NLog::Error("Geometry residency test failed; no areas could be loaded");
+        return false;
+    }
+
+    if (Checks.Passed())
+        NLog::Debug("Geometry residency test passed for {} areas", NumAreas);
+    else
+        NLog::Error("Geometry residency test failed; {} errors across {} areas", Checks.NumFailures(), NumAreas);
+
+    return Checks.Passed();
+}
+
+/** Stands in for the driver's program binary calls, recording what the shader cache hands it */
+class CMockProgramLoader final : public IProgramBinaryLoader
+{
+public:
+    bool AcceptBinaries = true;
+    uint32_t NumLoads = 0;
+    /** The program the driver currently has linked */
+    CShaderCache::SProgramBinary Program;
+
+    bool LoadProgramBinary(uint32_t Format, const std::vector<uint8_t>& rkData) override
+    {
+        NumLoads++;
+
+        if (!AcceptBinaries)
+            return false;
+
+        Program.Format = Format;
+        Program.Data = rkData;
+        return true;
+    }
+
+    bool GetProgramBinary(uint32_t& rOutFormat, std::vector<uint8_t>& rOutData) const override
+    {
+        if (Program.Data.empty())
+            return false;
+
+        rOutFormat = Program.Format;
+        rOutData = Program.Data;
+        return true;
+    }
+};
+
+/** Exercise the shader cache's key hashing, round trip, and rejection of stale and corrupt entries. No GL required. */
+bool ValidateShaderCache(const TString& rkCacheDir)
+{
+    NLog::Debug("Validating shader cache in {}", *rkCacheDir);
+    CTestChecks Checks("Shader cache");
+
+    // Key hashing
+    const uint64_t SourceHash = CShaderCache::HashSource("void main() {}", "out vec4 Color;");
+    Checks.Check(SourceHash == CShaderCache::HashSource("void main() {}", "out vec4 Color;"), "Source hash isn't stable");
+    Checks.Check(SourceHash != CShaderCache::HashSource("void main() {}", "out vec4 Colour;"), "Source hash ignores the pixel shader");
+    Checks.Check(CShaderCache::HashSource("ab", "c") != CShaderCache::HashSource("a", "bc"), "Source hash ignores the split between stages");
+
+    // Round trip
+    CShaderCache::SetCacheDirectory(rkCacheDir);
+    CShaderCache::Initialize("Test Vendor\nTest Renderer\n1.0\n");
+    Checks.Check(CShaderCache::IsEnabled(), "Cache couldn't be enabled");
+
+    constexpr uint64_t kMaterialHash = 0x0123456789ABCDEF;
+    CShaderCache::SProgramBinary Binary;
+    Binary.Format = 0x1234;
+
+    for (uint32_t i = 0; i < 256; i++)
+        Binary.Data.push_back(static_cast<uint8_t>(i * 7));
+
+    // Clear out an entry left by an earlier run, and note what else is in the directory
+    CShaderCache::Remove(kMaterialHash);
+    std::set<std::string> ExistingFiles;
+    std::error_code Error;
+
+    for (const auto& rkFile : std::filesystem::directory_iterator(*rkCacheDir, Error))
+        ExistingFiles.insert(rkFile.path().string());
+
+    CShaderCache::SProgramBinary Loaded;
+    Checks.Check(CShaderCache::Store(kMaterialHash, SourceHash, Binary), "Entry couldn't be written");
+    Checks.Check(CShaderCache::Load(kMaterialHash, SourceHash, Loaded), "Entry couldn't be read back");
+    Checks.Check(Loaded.Format == Binary.Format && Loaded.Data == Binary.Data, "Entry didn't round trip");
+
+    // Stale entries: different source, or a different driver
+    Checks.Check(!CShaderCache::Load(kMaterialHash, SourceHash + 1, Loaded), "Entry for other source was accepted");
+    CShaderCache::Initialize("Test Vendor\nTest Renderer\n2.0\n");
+    Checks.Check(!CShaderCache::Load(kMaterialHash, SourceHash, Loaded), "Entry from another driver was accepted");
+    CShaderCache::Initialize("Test Vendor\nTest Renderer\n1.0\n");
+
+    // Corrupt entries: damaged binary data, or a truncated file. The entry is the file the store added to the directory.
+    TString Path;
+
+    for (const auto& rkFile : std::filesystem::directory_iterator(*rkCacheDir, Error))
+    {
+        if (!ExistingFiles.contains(rkFile.path().string()))
+            Path = rkFile.path().string().c_str();
+    }
+
+    std::vector<uint8> FileData;
+    Checks.Check(!Path.IsEmpty() && FileUtil::LoadFileToBuffer(Path, FileData), "Entry file couldn't be found");
+
+    if (!FileData.empty())
+    {
+        std::vector<uint8> Damaged = FileData;
+        Damaged.back() ^= 0xFF;
+        FileUtil::SaveBufferToFile(Path, Damaged);
+        Checks.Check(!CShaderCache::Load(kMaterialHash, SourceHash, Loaded), "Entry with damaged data was accepted");
+
+        std::vector<uint8> Truncated(FileData.begin(), FileData.begin() + FileData.size() / 2);
+        FileUtil::SaveBufferToFile(Path, Truncated);
+        Checks.Check(!CShaderCache::Load(kMaterialHash, SourceHash, Loaded), "Truncated entry was accepted");
+    }
+
+    CShaderCache::Remove(kMaterialHash);
+    Checks.Check(Path.IsEmpty() || !FileUtil::Exists(Path), "Entry wasn't removed");
+
+    // Program loading through a mock driver: a compiled program is stored, and its binary is loaded back in place of compiling
+    CMockProgramLoader Compiled;
+    Compiled.Program = Binary;
+    Checks.Check(CShaderCache::StoreProgram(kMaterialHash, SourceHash, Compiled), "Compiled program couldn't be stored");
+
+    CMockProgramLoader Accepting;
+    Checks.Check(CShaderCache::LoadProgram(kMaterialHash, SourceHash, Accepting), "Cached program wasn't loaded");
+    Checks.Check(Accepting.NumLoads == 1 && Accepting.Program.Format == Binary.Format && Accepting.Program.Data == Binary.Data,
+                 "Driver didn't receive the cached binary");
+
+    // A rejected binary is removed, so the caller recompiles and stores the new binary
+    CMockProgramLoader Rejecting;
+    Rejecting.AcceptBinaries = false;
+    Checks.Check(!CShaderCache::LoadProgram(kMaterialHash, SourceHash, Rejecting), "Rejected binary was reported as loaded");
+    Checks.Check(Rejecting.NumLoads == 1, "Rejected binary wasn't offered to the driver");
+    Checks.Check(!CShaderCache::Load(kMaterialHash, SourceHash, Loaded), "Rejected entry wasn't removed");
+
+    Rejecting.Program = Binary;
+    Rejecting.Program.Data.assign(64, 0xAB);
+    Checks.Check(CShaderCache::StoreProgram(kMaterialHash, SourceHash, Rejecting), "Recompiled program couldn't be stored");
+
+    CMockProgramLoader Reloaded;
+    Checks.Check(CShaderCache::LoadProgram(kMaterialHash, SourceHash, Reloaded) && Reloaded.Program.Data == Rejecting.Program.Data,
+                 "Recompiled program didn't replace the rejected binary");
+
+    // Nothing reaches the driver while the cache is disabled
+    CShaderCache::Shutdown();
+    CMockProgramLoader Disabled;
+    Checks.Check(!CShaderCache::LoadProgram(kMaterialHash, SourceHash, Disabled) && Disabled.NumLoads == 0,
+                 "Disabled cache offered a binary to the driver");
+
+    CShaderCache::Initialize("Test Vendor\nTest Renderer\n1.0\n");
+    CShaderCache::Remove(kMaterialHash);
+    CShaderCache::Shutdown();
+
+    if (Checks.Passed())
+        NLog::Debug("Shader cache test passed");
+
+    return Checks.Passed();
+}
+
+/** Check that a texture and a model report their client memory once loaded and their GPU memory once uploaded */
+bool ValidateMemoryAccounting(const TString& rkProjectPath)
+{
+    NLog::Debug("Validating memory accounting for project: {}", *rkProjectPath);
+
+    CTestProject Project(rkProjectPath, "Memory accounting", true);
+
+    if (!Project.IsValid())
+        return false;
+
+    CResourceStore* pStore = Project.Store();
+    CTestChecks Checks("Memory accounting");
+
+    // Use the first resource of each type that loads
+    const auto FindFirst = [pStore](EResourceType Type) -> CResource* {
+        for (const auto& It : MakeResourceView(pStore))
+        {
+            if (It->ResourceType() != Type)
+                continue;
+
+            if (CResource* pRes = It->Load())
+                return pRes;
+        }
+        return nullptr;
+    };
+
+    TResPtr<CTexture> pTexture = FindFirst(EResourceType::Texture);
+    TResPtr<CModel> pModel = FindFirst(EResourceType::Model);
+    Checks.Check(pTexture != nullptr, "No texture could be loaded");
+    Checks.Check(pModel != nullptr, "No model could be loaded");
+
+    if (pTexture)
+    {
+        Checks.Check(pTexture->MemoryUsage().CPUBytes > 0, "Texture reported no CPU memory");
+        Checks.Check(pTexture->BufferGL(), "Texture couldn't be uploaded");
+        Checks.Check(pTexture->MemoryUsage().GPUBytes > 0, "Texture reported no GPU memory after uploading");
+    }
+
+    if (pModel)
+    {
+        Checks.Check(pModel->MemoryUsage().CPUBytes > 0, "Model reported no CPU memory");
+        pModel->BufferGL();
+        Checks.Check(pModel->MemoryUsage().GPUBytes > 0, "Model reported no GPU memory after uploading");
+    }
+
+    // Dynamic vertex rings are counted separately from resources
+    {
+        const size_t RingBytesBefore = CDynamicVertexBuffer::TotalGPUMemoryUsage();
+        CDynamicVertexBuffer Rings;
+        Rings.SetActiveAttribs(EVertexAttribute::Position | EVertexAttribute::Tex0);
+        Rings.SetVertexCount(4);
+        Checks.Check(Rings.GPUMemoryUsage() > 0, "Dynamic vertex buffer reported no GPU memory");
+        Checks.Check(CDynamicVertexBuffer::TotalGPUMemoryUsage() == RingBytesBefore + Rings.GPUMemoryUsage(),
+                     "Dynamic vertex ring total doesn't include a new buffer");
+
+        Rings.ClearBuffers();
+        Checks.Check(CDynamicVertexBuffer::TotalGPUMemoryUsage() == RingBytesBefore, "Dynamic vertex ring total wasn't released");
+    }
+
+    pStore->DumpMemoryReport();
+
+    if (Checks.Passed())
+        NLog::Debug("Memory accounting test passed");
+
+    return Checks.Passed();
+}
+
+/** Preload areas without a GL context, checking that each one is decoded and that evicting them unloads everything they brought in */
+bool ValidateAreaPreloader(const TString& rkProjectPath, uint32_t MaxAreas)
+{
+    NLog::Debug("Validating area preloader for project: {}", *rkProjectPath);
+
+    CTestProject Project(rkProjectPath, "Area preloader", false);
+
+    if (!Project.IsValid())
+        return false;
+
+    CResourceStore* pStore = Project.Store();
+    CTestChecks Checks("Area preloader");
+
+    // Preload from the first world that has areas
+    TResPtr<CWorld> pWorld;
+
+    for (const auto& It : MakeResourceView(pStore))
+    {
+        if (It->ResourceType() != EResourceType::World)
+            continue;
+
+        pWorld = It->Load();
+
+        if (pWorld && pWorld->NumAreas() > 0)
+            break;
+
+        pWorld = nullptr;
+    }
+
+    if (!pWorld)
+    {
+        NLog::Error("Area preloader test failed; no world with areas could be loaded");
+        return false;
+    }
+
+    // Everything loaded now must still be loaded after the preloaded areas are evicted, and nothing else
+    std::set<CAssetID> LoadedBefore;
+
+    for (const CAssetID& rkID : pStore->LoadedResources() | std::views::keys)
+        LoadedBefore.insert(rkID);
+
+    CAreaPreloader Preloader(pStore, UINT64_MAX);
+    std::vector<CAssetID> AreaIDs;
+
+    for (size_t AreaIdx = 0; AreaIdx < pWorld->NumAreas() && AreaIDs.size() < MaxAreas; AreaIdx++)
+    {
+        AreaIDs.push_back(pWorld->AreaResourceID(AreaIdx));
+        Preloader.RequestArea(AreaIDs.back());
+    }
+
+    // Reads finish on the worker thread; decode them as they come in
+    const auto Start = std::chrono::steady_clock::now();
+    constexpr auto kTimeout = std::chrono::seconds(60);
+
+    while (Preloader.HasPendingRequests() && std::chrono::steady_clock::now() - Start < kTimeout)
+    {
+        if (!Preloader.Update())
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    Checks.Check(!Preloader.HasPendingRequests(), "Areas were still pending after the timeout");
+
+    for (const CAssetID& rkAreaID : AreaIDs)
+    {
+        CResourceEntry* pEntry = pStore->FindEntry(rkAreaID);
+        const TString Name = pEntry ? pEntry->Name() : rkAreaID.ToString();
+
+        if (!Preloader.IsPreloaded(rkAreaID) || !pEntry || !pEntry->IsLoaded())
+        {
+            Checks.Fail(fmt::format("{} wasn't preloaded", *Name));
+            continue;
+        }
+
+        const CGameArea* pkArea = static_cast<const CGameArea*>(pEntry->Resource());
+        Checks.Check(pkArea->NumScriptLayers() > 0, fmt::format("{} was preloaded without script layers", *Name));
+    }
+
+    Checks.Check(Preloader.MemoryUsed() > 0, "Preloaded areas reported no memory");
+
+    // A zero budget evicts every area
+    Preloader.SetMemoryBudget(0);
+    Checks.Check(Preloader.MemoryUsed() == 0, "Memory was still counted after evicting every area");
+
+    for (const CAssetID& rkAreaID : AreaIDs)
+        Checks.Check(!Preloader.IsPreloaded(rkAreaID), "An area was still preloaded after being evicted");
+
+    uint32_t NumStillLoaded = 0;
+
+    for (const CAssetID& rkID : pStore->LoadedResources() | std::views::keys)
+    {
+        if (!LoadedBefore.contains(rkID))
+            NumStillLoaded++;
+    }
+
+    Checks.Check(NumStillLoaded == 0, fmt::format("{} resources brought in by preloaded areas were left loaded", NumStillLoaded));
+
+    for (const CAssetID& rkID : LoadedBefore)
+    {
+        if (!pStore->LoadedResources().contains(rkID))
+        {
+            Checks.Fail("Evicting an area unloaded a resource that was loaded before it");
+            break;
+        }
+    }
+
+    if (Checks.Passed())
+        NLog::Debug("Area preloader test passed for {} areas", AreaIDs.size());
+
+    return Checks.Passed();
+}
+
 } // end namespace NCoreTests
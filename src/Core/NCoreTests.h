@@ -2,16 +2,82 @@
 #define NCORETESTS_H
 
 #include "Core/Resource/EResType.h"
+#include <Common/TString.h>
+
+#include <cstdint>
+#include <set>
+#include <vector>
+
+class CResourceEntry;
 
 /** Unit tests for Core */
 namespace NCoreTests
 {
 
-/** Check commandline input to see if the user is running a unit test */
-bool RunTests(int argc, char *argv[]);
+/** A range of recooked data that differs from the original asset */
+struct SCookerMismatch
+{
+    size_t Offset;
+    size_t Size;
+    /** Section of the original file the range starts in, where the format's layout is known */
+    TString Section;
+};
+
+/** Cooker validation result for one resource */
+struct SCookerValidationResult
+{
+    CResourceEntry* pEntry = nullptr;
+    const char* pkFailReason = nullptr;
+    size_t OriginalSize = 0;
+    size_t NewSize = 0;
+    std::vector<SCookerMismatch> Mismatches;
+    bool MismatchesTruncated = false;
+
+    bool IsValid() const        { return pkFailReason == nullptr; }
+    int64_t SizeDelta() const   { return static_cast<int64_t>(NewSize) - static_cast<int64_t>(OriginalSize); }
+};
+
+/** Check commandline input to see if the user is running a unit test.
+ *  Returns whether a test was run; rOutExitCode is set to the process exit code for its result. */
+bool RunTests(int argc, char *argv[], int& rOutExitCode);
+
+/** Validate all cooker output for the given resource type matches the original asset data.
+ *  Per-resource results, including every mismatched range, are appended to pOutResults if provided. */
+bool ValidateCooker(EResourceType ResourceType, bool DumpInvalidFileContents,
+                    std::vector<SCookerValidationResult>* pOutResults = nullptr);
+
+/** Writes cooker validation results as CSV, one row per mismatched range */
+bool WriteCookerReport(const TString& rkPath, const std::vector<SCookerValidationResult>& rkResults);
+
+/** Time cooked load, cook, texture decode and dependency tree building for every resource in a project.
+ *  Opens the project directly rather than through the UI, so no GL context is required. Results are
+ *  written as CSV to rkOutputPath. If rkBaselinePath is set, the results are compared against that file
+ *  and the benchmark fails if any median time or per-type peak memory increase regressed by more than Tolerance. */
+bool RunBenchmarks(const TString& rkProjectPath, const std::set<EResourceType>& rkTypes,
+                   const TString& rkOutputPath, const TString& rkBaselinePath, double Tolerance);
+
+/** Load up to MaxAreas areas of a project and compare ID buffer picking against the CPU ray cast on a grid of
+ *  screen positions. Fails if the fraction of samples where they hit different nodes exceeds Tolerance.
+ *  Renders through an offscreen context from the UI relay, so it runs without a window. */
+bool ValidatePicking(const TString& rkProjectPath, uint32_t MaxAreas, double Tolerance);
+
+/** Upload the world geometry of up to MaxAreas areas with positions-only residency, checking that shared surfaces
+ *  are only compacted once every model using them is uploaded, that compacted surfaces pick the same as before,
+ *  and that switching from the merged terrain to the world models restores the geometry once. */
+bool ValidateGeometryResidency(const TString& rkProjectPath, uint32_t MaxAreas);
+
+/** Check shader cache key hashing, that entries round trip through rkCacheDir, and that entries from another
+ *  driver or source, or with damaged or truncated data, are rejected. Program loading runs against a mock driver,
+ *  checking that a rejected binary is removed and replaced once the program is recompiled. Reconfigures the global cache. */
+bool ValidateShaderCache(const TString& rkCacheDir);
+
+/** Load and upload a texture and a model from a project, checking both report non-zero CPU and GPU memory,
+ *  and that dynamic vertex buffer rings are counted in the renderer's total. Logs the store's memory report. */
+bool ValidateMemoryAccounting(const TString& rkProjectPath);
 
-/** Validate all cooker output for the given resource type matches the original asset data */
-bool ValidateCooker(EResourceType ResourceType, bool DumpInvalidFileContents);
+/** Preload up to MaxAreas areas of a project through CAreaPreloader without a GL context, checking that each one is
+ *  read and decoded, and that evicting them all unloads every resource they brought in and nothing else. */
+bool ValidateAreaPreloader(const TString& rkProjectPath, uint32_t MaxAreas);
 
 }
 
@@ -2,11 +2,18 @@
 #include "CVertexArrayManager.h"
 
 #include <array>
+#include <cstring>
 
 constexpr std::array<uint32_t, 12> gskAttribSize{
     0xC, 0xC, 0x4, 0x4, 0x8, 0x8, 0x8, 0x8, 0x8, 0x8, 0x8, 0x8
 };
 
+// Persistently mapped rings need buffer storage; otherwise each update maps its own unsynchronized range
+static bool SupportsPersistentMapping()
+{
+    return GLEW_ARB_buffer_storage;
+}
+
 CDynamicVertexBuffer::CDynamicVertexBuffer() = default;
 
 CDynamicVertexBuffer::~CDynamicVertexBuffer()
@@ -25,6 +32,13 @@ void CDynamicVertexBuffer::SetVertexCount(uint32_t NumVerts)
 void CDynamicVertexBuffer::Bind()
 {
     CVertexArrayManager::Current()->BindVAO(this);
+
+    // Point each attribute at its most recent update in the ring
+    for (uint32_t iAttrib = 0; iAttrib < mRings.size(); iAttrib++)
+    {
+        if (mBufferedFlags.HasFlag(EVertexAttribute(1U << iAttrib)))
+            SetAttribPointer(iAttrib);
+    }
 }
 
 void CDynamicVertexBuffer::Unbind()
@@ -60,18 +74,72 @@ void CDynamicVertexBuffer::BufferAttrib(EVertexAttribute Attrib, const void *pkD
     default:                            return;
     }
 
-    glBindBuffer(GL_ARRAY_BUFFER, mAttribBuffers[Index]);
-    glBufferSubData(GL_ARRAY_BUFFER, 0, gskAttribSize[Index] * mNumVertices, pkData);
+    SAttribRing& rRing = mRings[Index];
+    const uint32_t Size = gskAttribSize[Index] * mNumVertices;
+
+    if (!mBufferedFlags.HasFlag(Attrib) || Size == 0)
+        return;
+
+    if (rRing.Cursor + Size > rRing.Capacity)
+    {
+        rRing.Cursor = 0;
+        smFrameStats.NumWraps++;
+    }
+
+    const uint32_t RegionSize = rRing.Capacity / skNumRingRegions;
+
+    if (rRing.Cursor % RegionSize == 0)
+        AcquireRegion(rRing, rRing.Cursor / RegionSize);
+
+    if (rRing.pMapped != nullptr)
+    {
+        std::memcpy(rRing.pMapped + rRing.Cursor, pkData, Size);
+    }
+    else
+    {
+        // The region fences already guarantee the GPU is done with this range, so skip the driver's own sync
+        glBindBuffer(GL_ARRAY_BUFFER, rRing.Buffer);
+        void *pDst = glMapBufferRange(GL_ARRAY_BUFFER, rRing.Cursor, Size,
+                                      GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+
+        if (pDst != nullptr)
+        {
+            std::memcpy(pDst, pkData, Size);
+            glUnmapBuffer(GL_ARRAY_BUFFER);
+        }
+        else
+        {
+            glBufferSubData(GL_ARRAY_BUFFER, rRing.Cursor, Size, pkData);
+        }
+    }
+
+    rRing.DrawOffset = rRing.Cursor;
+    rRing.Cursor += Size;
+
+    smFrameStats.NumUpdates++;
+    smFrameStats.NumBytes += Size;
 }
 
 void CDynamicVertexBuffer::ClearBuffers()
 {
-    for (size_t iAttrib = 0; iAttrib < mAttribBuffers.size(); iAttrib++)
+    for (size_t iAttrib = 0; iAttrib < mRings.size(); iAttrib++)
     {
         const auto Bit = EVertexAttribute(1U << iAttrib);
+        SAttribRing& rRing = mRings[iAttrib];
 
-        if (mBufferedFlags.HasFlag(Bit))
-            glDeleteBuffers(1, &mAttribBuffers[iAttrib]);
+        if (!mBufferedFlags.HasFlag(Bit))
+            continue;
+
+        for (GLsync& rFence : rRing.RegionFences)
+        {
+            if (rFence != nullptr)
+                glDeleteSync(rFence);
+        }
+
+        // Deleting the buffer also releases a persistent mapping
+        glDeleteBuffers(1, &rRing.Buffer);
+        smTotalRingBytes -= rRing.Capacity;
+        rRing = SAttribRing{};
     }
 
     mBufferedFlags.Reset(EVertexAttribute::None);
@@ -83,52 +151,120 @@ GLuint CDynamicVertexBuffer::CreateVAO()
     glGenVertexArrays(1, &VertexArray);
     glBindVertexArray(VertexArray);
 
-    for (uint32_t iAttrib = 0; iAttrib < mAttribBuffers.size(); iAttrib++)
+    for (uint32_t iAttrib = 0; iAttrib < mRings.size(); iAttrib++)
     {
-        const bool HasAttrib = (3 << (iAttrib * 2)) != 0;
+        if (!mBufferedFlags.HasFlag(EVertexAttribute(1U << iAttrib)))
+            continue;
 
-        if (HasAttrib)
-        {
-            glBindBuffer(GL_ARRAY_BUFFER, mAttribBuffers[iAttrib]);
-            GLuint NumComponents;
-            GLenum DataType;
-
-            if (iAttrib == 2 || iAttrib == 3)
-            {
-                NumComponents = 4;
-                DataType = GL_UNSIGNED_BYTE;
-            }
-            else
-            {
-                NumComponents = gskAttribSize[iAttrib] / 4;
-                DataType = GL_FLOAT;
-            }
-
-            glVertexAttribPointer(iAttrib, NumComponents, DataType, GL_FALSE, 0, nullptr);
-            glEnableVertexAttribArray(iAttrib);
-        }
+        SetAttribPointer(iAttrib);
+        glEnableVertexAttribArray(iAttrib);
     }
 
     glBindVertexArray(0);
     return VertexArray;
 }
 
+size_t CDynamicVertexBuffer::GPUMemoryUsage() const
+{
+    // Each active attribute's whole ring is allocated up front
+    size_t Bytes = 0;
+
+    for (size_t iAttrib = 0; iAttrib < mRings.size(); iAttrib++)
+    {
+        if (mBufferedFlags.HasFlag(EVertexAttribute(1U << iAttrib)))
+            Bytes += mRings[iAttrib].Capacity;
+    }
+
+    return Bytes;
+}
+
+// ************ STATIC ************
+void CDynamicVertexBuffer::BeginFrame()
+{
+    smLastFrameStats = smFrameStats;
+    smFrameStats = SStreamStats{};
+}
+
 // ************ PRIVATE ************
 void CDynamicVertexBuffer::InitBuffers()
 {
     if (mBufferedFlags)
         ClearBuffers();
 
-    for (size_t iAttrib = 0; iAttrib < mAttribBuffers.size(); iAttrib++)
+    for (size_t iAttrib = 0; iAttrib < mRings.size(); iAttrib++)
     {
-        const bool HasAttrib = ((3 << (iAttrib * 2)) != 0);
+        if (!mAttribFlags.HasFlag(EVertexAttribute(1U << iAttrib)))
+            continue;
+
+        SAttribRing& rRing = mRings[iAttrib];
+        rRing.Capacity = gskAttribSize[iAttrib] * mNumVertices * skUpdatesPerRing;
+        smTotalRingBytes += rRing.Capacity;
 
-        if (HasAttrib)
+        glGenBuffers(1, &rRing.Buffer);
+        glBindBuffer(GL_ARRAY_BUFFER, rRing.Buffer);
+
+        if (SupportsPersistentMapping() && rRing.Capacity > 0)
         {
-            glGenBuffers(1, &mAttribBuffers[iAttrib]);
-            glBindBuffer(GL_ARRAY_BUFFER, mAttribBuffers[iAttrib]);
-            glBufferData(GL_ARRAY_BUFFER, gskAttribSize[iAttrib] * mNumVertices, nullptr, GL_DYNAMIC_DRAW);
+            constexpr GLbitfield kFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+            glBufferStorage(GL_ARRAY_BUFFER, rRing.Capacity, nullptr, kFlags);
+            rRing.pMapped = static_cast<uint8_t*>(glMapBufferRange(GL_ARRAY_BUFFER, 0, rRing.Capacity, kFlags));
+        }
+        else
+        {
+            glBufferData(GL_ARRAY_BUFFER, rRing.Capacity, nullptr, GL_STREAM_DRAW);
         }
     }
+
     mBufferedFlags = mAttribFlags;
 }
+
+void CDynamicVertexBuffer::AcquireRegion(SAttribRing& rRing, uint32_t Region)
+{
+    // Fence the region we're leaving, so it isn't overwritten until the GPU has drawn from it
+    const uint32_t PrevRegion = (Region + skNumRingRegions - 1) % skNumRingRegions;
+
+    if (rRing.RegionFences[PrevRegion] == nullptr)
+        rRing.RegionFences[PrevRegion] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    GLsync& rFence = rRing.RegionFences[Region];
+
+    if (rFence == nullptr)
+        return;
+
+    GLenum Result = glClientWaitSync(rFence, 0, 0);
+
+    if (Result == GL_TIMEOUT_EXPIRED)
+    {
+        smFrameStats.NumStalls++;
+
+        do
+        {
+            Result = glClientWaitSync(rFence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+        }
+        while (Result == GL_TIMEOUT_EXPIRED);
+    }
+
+    glDeleteSync(rFence);
+    rFence = nullptr;
+}
+
+void CDynamicVertexBuffer::SetAttribPointer(uint32_t Index)
+{
+    GLint NumComponents;
+    GLenum DataType;
+
+    if (Index == 2 || Index == 3)
+    {
+        NumComponents = 4;
+        DataType = GL_UNSIGNED_BYTE;
+    }
+    else
+    {
+        NumComponents = static_cast<GLint>(gskAttribSize[Index] / 4);
+        DataType = GL_FLOAT;
+    }
+
+    const auto Offset = static_cast<uintptr_t>(mRings[Index].DrawOffset);
+    glBindBuffer(GL_ARRAY_BUFFER, mRings[Index].Buffer);
+    glVertexAttribPointer(Index, NumComponents, DataType, GL_FALSE, 0, reinterpret_cast<const void*>(Offset));
+}
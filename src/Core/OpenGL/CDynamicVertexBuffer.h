@@ -4,14 +4,49 @@
 #include "Core/Resource/Model/EVertexAttribute.h"
 
 #include <array>
+#include <cstddef>
+#include <cstdint>
 #include <GL/glew.h>
 
 class CDynamicVertexBuffer
 {
+public:
+    // Streaming statistics, accumulated across every dynamic vertex buffer
+    struct SStreamStats
+    {
+        uint32_t NumUpdates = 0;   // Number of attribute updates
+        uint64_t NumBytes = 0;     // Bytes written into ring buffers
+        uint32_t NumWraps = 0;     // Times a ring buffer wrapped back to the start
+        uint32_t NumStalls = 0;    // Times the CPU had to wait for the GPU to release ring space
+    };
+
+private:
+    // Number of updates that fit in each attribute's ring, and the number of fenced regions it's split into.
+    // The ring size is a multiple of the region count, so an update never straddles two regions.
+    static constexpr uint32_t skUpdatesPerRing = 256;
+    static constexpr uint32_t skNumRingRegions = 4;
+
+    // Every update is written to fresh space in the attribute's ring, so the GPU can keep reading
+    // earlier updates while the CPU writes the next one. A region is only rewritten once the fence
+    // placed after its last use has signaled.
+    struct SAttribRing
+    {
+        GLuint Buffer = 0;
+        uint8_t *pMapped = nullptr;     // Persistent mapping; null when buffer storage isn't supported
+        uint32_t Capacity = 0;
+        uint32_t Cursor = 0;            // Where the next update will be written
+        uint32_t DrawOffset = 0;        // Offset of the most recent update
+        std::array<GLsync, skNumRingRegions> RegionFences{};
+    };
+
     FVertexDescription mAttribFlags{EVertexAttribute::None};
     FVertexDescription mBufferedFlags{EVertexAttribute::None};
     uint32_t mNumVertices = 0;
-    std::array<GLuint, 12> mAttribBuffers{};
+    std::array<SAttribRing, 12> mRings{};
+
+    static inline SStreamStats smFrameStats;
+    static inline SStreamStats smLastFrameStats;
+    static inline size_t smTotalRingBytes = 0;
 
 public:
     CDynamicVertexBuffer();
@@ -23,8 +58,18 @@ public:
     void BufferAttrib(EVertexAttribute Attrib, const void *pkData);
     void ClearBuffers();
     GLuint CreateVAO();
+    size_t GPUMemoryUsage() const;
+
+    static void BeginFrame();
+    static const SStreamStats& LastFrameStats() { return smLastFrameStats; }
+
+    // Ring storage allocated by every dynamic vertex buffer. These aren't owned by resources.
+    static size_t TotalGPUMemoryUsage()         { return smTotalRingBytes; }
+
 private:
     void InitBuffers();
+    void AcquireRegion(SAttribRing& rRing, uint32_t Region);
+    void SetAttribPointer(uint32_t Index);
 };
 
 #endif // CDYNAMICVERTEXBUFFER_H
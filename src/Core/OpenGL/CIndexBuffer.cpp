@@ -80,6 +80,17 @@ void CIndexBuffer::DrawElements(uint32_t offset, uint32_t size)
     Unbind();
 }
 
+void CIndexBuffer::MultiDrawElements(const uint32_t* offsets, const GLsizei* sizes, size_t count)
+{
+    std::vector<const void*> ByteOffsets(count);
+    for (size_t i = 0; i < count; i++)
+        ByteOffsets[i] = (char*)0 + (offsets[i] * 2);
+
+    Bind();
+    glMultiDrawElements(mPrimitiveType, sizes, GL_UNSIGNED_SHORT, ByteOffsets.data(), static_cast<GLsizei>(count));
+    Unbind();
+}
+
 bool CIndexBuffer::IsBuffered() const
 {
     return mBuffered;
@@ -90,6 +101,16 @@ uint32_t CIndexBuffer::GetSize() const
     return mIndices.size();
 }
 
+size_t CIndexBuffer::ClientMemoryUsage() const
+{
+    return mIndices.capacity() * sizeof(uint16_t);
+}
+
+size_t CIndexBuffer::GPUMemoryUsage() const
+{
+    return mBuffered ? mIndices.size() * sizeof(uint16_t) : 0;
+}
+
 GLenum CIndexBuffer::GetPrimitiveType() const
 {
     return mPrimitiveType;
@@ -29,9 +29,12 @@ public:
     void Unbind();
     void DrawElements();
     void DrawElements(uint32_t offset, uint32_t size);
+    void MultiDrawElements(const uint32_t* offsets, const GLsizei* sizes, size_t count);
     bool IsBuffered() const;
 
     uint32_t GetSize() const;
+    size_t ClientMemoryUsage() const;
+    size_t GPUMemoryUsage() const;
     GLenum GetPrimitiveType() const;
     void SetPrimitiveType(GLenum type);
 
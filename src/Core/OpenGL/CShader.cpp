@@ -34,6 +34,51 @@ static void DumpShaderSource(GLuint shader, const std::string& out)
         ShaderOut << pInfoLog.get();
 }
 
+static bool CheckCompileStatus(GLuint shader, std::string_view typePrefix, std::string_view typeName)
+{
+    GLint CompileStatus{};
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &CompileStatus);
+
+    if (CompileStatus == GL_FALSE)
+    {
+        const auto out = fmt::format("dump/Bad{}_{:08d}.txt", typePrefix, gFailedCompileCount);
+        DumpShaderSource(shader, out);
+        NLog::Error("Unable to compile {} shader; dumped to {}", typeName, out);
+
+        gFailedCompileCount++;
+        return false;
+    }
+
+    // Debug dump
+    if (gDebugDumpShaders == true)
+    {
+        const auto out = fmt::format("dump/{}_{:08d}.txt", typePrefix, gSuccessfulCompileCount);
+        DumpShaderSource(shader, out);
+        NLog::Debug("Debug shader dumping enabled; dumped to {}", out);
+
+        gSuccessfulCompileCount++;
+    }
+
+    return true;
+}
+
+static void DumpLinkLog(GLuint program)
+{
+    const auto out = fmt::format("dump/BadLink_{:08d}.txt", gFailedCompileCount);
+    NLog::Error("Unable to link shaders. Dumped error log to {}", out);
+
+    GLint LogLen{};
+    glGetProgramiv(program, GL_INFO_LOG_LENGTH, &LogLen);
+    auto pInfoLog = std::make_unique_for_overwrite<GLchar[]>(LogLen);
+    glGetProgramInfoLog(program, LogLen, nullptr, pInfoLog.get());
+
+    std::ofstream LinkOut(out);
+    if (LogLen > 0)
+        LinkOut << pInfoLog.get();
+
+    gFailedCompileCount++;
+}
+
 CShader::CShader()
 {
     smNumShaders++;
@@ -76,28 +121,11 @@ bool CShader::CompileVertexSource(std::string_view source)
     glCompileShader(mVertexShader);
 
     // Shader should be compiled - check for errors
-    GLint CompileStatus{};
-    glGetShaderiv(mVertexShader, GL_COMPILE_STATUS, &CompileStatus);
-
-    if (CompileStatus == GL_FALSE)
+    if (!CheckCompileStatus(mVertexShader, "VS", "vertex"))
     {
-        const auto out = fmt::format("dump/BadVS_{:08d}.txt", gFailedCompileCount);
-        DumpShaderSource(mVertexShader, out);
-        NLog::Error("Unable to compile vertex shader; dumped to {}", out);
-
-        gFailedCompileCount++;
         glDeleteShader(mVertexShader);
         return false;
     }
-    // Debug dump
-    else if (gDebugDumpShaders == true)
-    {
-        const auto out = fmt::format("dump/VS_{:08d}.txt", gSuccessfulCompileCount);
-        DumpShaderSource(mVertexShader, out);
-        NLog::Debug("Debug shader dumping enabled; dumped to {}", out);
-
-        gSuccessfulCompileCount++;
-    }
 
     mVertexShaderExists = true;
     return true;
@@ -113,30 +141,12 @@ bool CShader::CompilePixelSource(std::string_view source)
     glCompileShader(mPixelShader);
 
     // Shader should be compiled - check for errors
-    GLint CompileStatus{};
-    glGetShaderiv(mPixelShader, GL_COMPILE_STATUS, &CompileStatus);
-
-    if (CompileStatus == GL_FALSE)
+    if (!CheckCompileStatus(mPixelShader, "PS", "pixel"))
     {
-        const auto out = fmt::format("dump/BadPS_{:08d}.txt", gFailedCompileCount);
-        NLog::Error("Unable to compile pixel shader; dumped to {}", out);
-        DumpShaderSource(mPixelShader, out);
-
-        gFailedCompileCount++;
         glDeleteShader(mPixelShader);
         return false;
     }
 
-    // Debug dump
-    if (gDebugDumpShaders == true)
-    {
-        const auto out = fmt::format("dump/PS_{:08d}.txt", gSuccessfulCompileCount);
-        NLog::Debug("Debug shader dumping enabled; dumped to {}", out);
-        DumpShaderSource(mPixelShader, out);
-
-        gSuccessfulCompileCount++;
-    }
-
     mPixelShaderExists = true;
     return true;
 }
@@ -147,6 +157,10 @@ bool CShader::LinkShaders()
         return false;
 
     mProgram = glCreateProgram();
+
+    if (SupportsProgramBinaries())
+        glProgramParameteri(mProgram, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
     glAttachShader(mProgram, mVertexShader);
     glAttachShader(mProgram, mPixelShader);
     glLinkProgram(mProgram);
@@ -162,34 +176,130 @@ bool CShader::LinkShaders()
 
     if (LinkStatus == GL_FALSE)
     {
-        const auto out = fmt::format("dump/BadLink_{:08d}.txt", gFailedCompileCount);
-        NLog::Error("Unable to link shaders. Dumped error log to {}", out);
+        DumpLinkLog(mProgram);
+        glDeleteProgram(mProgram);
+        return false;
+    }
 
-        GLint LogLen{};
-        glGetProgramiv(mProgram, GL_INFO_LOG_LENGTH, &LogLen);
-        auto pInfoLog = std::make_unique_for_overwrite<GLchar[]>(LogLen);
-        glGetProgramInfoLog(mProgram, LogLen, nullptr, pInfoLog.get());
+    OnProgramLinked();
+    return true;
+}
 
-        std::ofstream LinkOut(out);
-        if (LogLen > 0)
-            LinkOut << pInfoLog.get();
+void CShader::BeginCompile(std::string_view vertexSource, std::string_view pixelSource)
+{
+    // Issue the compile and link without querying any status, so drivers that compile in the
+    // background can return immediately. Errors are collected later in FinishCompile().
+    const auto* VertexPtr = vertexSource.data();
+    const auto VertexLen = int(vertexSource.size());
+    const auto* PixelPtr = pixelSource.data();
+    const auto PixelLen = int(pixelSource.size());
+
+    mVertexShader = glCreateShader(GL_VERTEX_SHADER);
+    glShaderSource(mVertexShader, 1, &VertexPtr, &VertexLen);
+    glCompileShader(mVertexShader);
+    mVertexShaderExists = true;
+
+    mPixelShader = glCreateShader(GL_FRAGMENT_SHADER);
+    glShaderSource(mPixelShader, 1, &PixelPtr, &PixelLen);
+    glCompileShader(mPixelShader);
+    mPixelShaderExists = true;
+
+    mProgram = glCreateProgram();
+
+    if (SupportsProgramBinaries())
+        glProgramParameteri(mProgram, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
+    glAttachShader(mProgram, mVertexShader);
+    glAttachShader(mProgram, mPixelShader);
+    glLinkProgram(mProgram);
+
+    mCompilePending = true;
+}
+
+bool CShader::IsCompileComplete() const
+{
+    if (!mCompilePending || !SupportsParallelCompile())
+        return true;
+
+    GLint Complete = GL_FALSE;
+    glGetProgramiv(mProgram, GL_COMPLETION_STATUS_KHR, &Complete);
+    return Complete == GL_TRUE;
+}
+
+bool CShader::FinishCompile()
+{
+    if (!mCompilePending)
+        return mProgramExists;
+
+    mCompilePending = false;
+
+    const bool VertexCompiled = CheckCompileStatus(mVertexShader, "VS", "vertex");
+    const bool PixelCompiled = CheckCompileStatus(mPixelShader, "PS", "pixel");
+
+    glDeleteShader(mVertexShader);
+    glDeleteShader(mPixelShader);
+    mVertexShaderExists = false;
+    mPixelShaderExists = false;
+
+    GLint LinkStatus{};
+    glGetProgramiv(mProgram, GL_LINK_STATUS, &LinkStatus);
+
+    if (!VertexCompiled || !PixelCompiled || LinkStatus == GL_FALSE)
+    {
+        // A failed compile always fails the link too; only the compile log is interesting then
+        if (VertexCompiled && PixelCompiled)
+            DumpLinkLog(mProgram);
 
-        gFailedCompileCount++;
         glDeleteProgram(mProgram);
+        mProgram = 0;
         return false;
     }
 
-    mMVPBlockIndex = GetUniformBlockIndex("MVPBlock");
-    mVertexBlockIndex = GetUniformBlockIndex("VertexBlock");
-    mPixelBlockIndex = GetUniformBlockIndex("PixelBlock");
-    mLightBlockIndex = GetUniformBlockIndex("LightBlock");
-    mBoneTransformBlockIndex = GetUniformBlockIndex("BoneTransformBlock");
+    OnProgramLinked();
+    return true;
+}
 
-    CacheCommonUniforms();
-    mProgramExists = true;
+bool CShader::LoadProgramBinary(GLenum Format, const std::vector<uint8_t>& rkData)
+{
+    if (mProgramExists || !SupportsProgramBinaries())
+        return false;
+
+    mProgram = glCreateProgram();
+    glProgramBinary(mProgram, Format, rkData.data(), static_cast<GLsizei>(rkData.size()));
+
+    // Drivers are free to reject binaries, e.g. after an update; the caller falls back to compiling
+    GLint LinkStatus{};
+    glGetProgramiv(mProgram, GL_LINK_STATUS, &LinkStatus);
+
+    if (LinkStatus == GL_FALSE)
+    {
+        glDeleteProgram(mProgram);
+        mProgram = 0;
+        return false;
+    }
+
+    OnProgramLinked();
     return true;
 }
 
+bool CShader::GetProgramBinary(GLenum& rOutFormat, std::vector<uint8_t>& rOutData) const
+{
+    if (!mProgramExists || !SupportsProgramBinaries())
+        return false;
+
+    GLint BinaryLength = 0;
+    glGetProgramiv(mProgram, GL_PROGRAM_BINARY_LENGTH, &BinaryLength);
+
+    if (BinaryLength <= 0)
+        return false;
+
+    GLsizei Written = 0;
+    rOutData.resize(static_cast<size_t>(BinaryLength));
+    glGetProgramBinary(mProgram, BinaryLength, &Written, &rOutFormat, rOutData.data());
+    rOutData.resize(static_cast<size_t>(Written));
+    return Written > 0;
+}
+
 bool CShader::IsValidProgram() const
 {
     return mProgramExists;
@@ -259,6 +369,25 @@ std::unique_ptr<CShader> CShader::FromResourceFile(const TString& rkShaderName)
     return std::make_unique<CShader>(VertexShaderText, PixelShaderText);
 }
 
+bool CShader::SupportsProgramBinaries()
+{
+    static const bool skSupported = [] {
+        if (!GLEW_ARB_get_program_binary)
+            return false;
+
+        GLint NumFormats = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &NumFormats);
+        return NumFormats > 0;
+    }();
+
+    return skSupported;
+}
+
+bool CShader::SupportsParallelCompile()
+{
+    return GLEW_KHR_parallel_shader_compile || GLEW_ARB_parallel_shader_compile;
+}
+
 CShader* CShader::CurrentShader()
 {
     return spCurrentShader;
@@ -270,6 +399,18 @@ void CShader::KillCachedShader()
 }
 
 // ************ PRIVATE ************
+void CShader::OnProgramLinked()
+{
+    mMVPBlockIndex = GetUniformBlockIndex("MVPBlock");
+    mVertexBlockIndex = GetUniformBlockIndex("VertexBlock");
+    mPixelBlockIndex = GetUniformBlockIndex("PixelBlock");
+    mLightBlockIndex = GetUniformBlockIndex("LightBlock");
+    mBoneTransformBlockIndex = GetUniformBlockIndex("BoneTransformBlock");
+
+    CacheCommonUniforms();
+    mProgramExists = true;
+}
+
 void CShader::CacheCommonUniforms()
 {
     for (size_t iTex = 0; iTex < 8; iTex++)
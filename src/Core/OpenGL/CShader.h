@@ -4,14 +4,19 @@
 #include <Common/TString.h>
 #include <GL/glew.h>
 #include <array>
+#include <cstdint>
 #include <memory>
 #include <string_view>
+#include <vector>
 
 class CShader
 {
+    friend class CShaderGenerator;
+
     bool mVertexShaderExists = false;
     bool mPixelShaderExists = false;
     bool mProgramExists = false;
+    bool mCompilePending = false;
     GLuint mVertexShader = 0;
     GLuint mPixelShader = 0;
     GLuint mProgram = 0;
@@ -36,7 +41,13 @@ public:
     bool CompileVertexSource(std::string_view source);
     bool CompilePixelSource(std::string_view source);
     bool LinkShaders();
+    void BeginCompile(std::string_view vertexSource, std::string_view pixelSource);
+    bool IsCompileComplete() const;
+    bool FinishCompile();
+    bool LoadProgramBinary(GLenum Format, const std::vector<uint8_t>& rkData);
+    bool GetProgramBinary(GLenum& rOutFormat, std::vector<uint8_t>& rOutData) const;
     bool IsValidProgram() const;
+    bool IsCompilePending() const { return mCompilePending; }
     GLuint GetProgramID() const;
     GLuint GetUniformLocation(const char* pkUniform) const;
     GLuint GetUniformBlockIndex(const char* pkUniformBlock) const;
@@ -52,7 +63,11 @@ public:
 
     static int NumShaders() { return smNumShaders; }
 
+    static bool SupportsProgramBinaries();
+    static bool SupportsParallelCompile();
+
 private:
+    void OnProgramLinked();
     void CacheCommonUniforms();
 };
 
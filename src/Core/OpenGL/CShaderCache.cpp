@@ -0,0 +1,179 @@
+#include "Core/OpenGL/CShaderCache.h"
+
+#include <Common/FileUtil.h>
+#include <Common/Log.h>
+#include <Common/FileIO/CFileInStream.h>
+#include <Common/FileIO/CFileOutStream.h>
+#include <Common/Hash/CFNV1A.h>
+
+#include <fmt/format.h>
+
+constexpr uint32_t gkShaderCacheMagic = 0x50575343; // "PWSC"
+
+// Bump this whenever the entry layout changes
+constexpr uint32_t gkShaderCacheVersion = 2;
+
+static uint64_t HashBinary(const std::vector<uint8_t>& rkData)
+{
+    CFNV1A Hash(CFNV1A::EHashLength::k64Bit);
+    Hash.HashData(rkData.data(), rkData.size());
+    return Hash.GetHash64();
+}
+
+void CShaderCache::SetCacheDirectory(const TString& rkDir)
+{
+    smCacheDir = rkDir;
+}
+
+void CShaderCache::Initialize(std::string_view DriverString)
+{
+    if (smCacheDir.IsEmpty())
+        return;
+
+    if (!FileUtil::IsDirectory(smCacheDir) && !FileUtil::MakeDirectory(smCacheDir))
+    {
+        NLog::Warn("Couldn't create shader cache directory {}; shader caching is disabled", *smCacheDir);
+        return;
+    }
+
+    CFNV1A Hash(CFNV1A::EHashLength::k64Bit);
+    Hash.HashData(DriverString.data(), DriverString.size());
+    smDriverHash = Hash.GetHash64();
+    smEnabled = true;
+
+    NLog::Debug("Shader cache enabled at {}", *smCacheDir);
+}
+
+void CShaderCache::Shutdown()
+{
+    smEnabled = false;
+    smDriverHash = 0;
+}
+
+uint64_t CShaderCache::HashSource(std::string_view VertexSource, std::string_view PixelSource)
+{
+    // Hash the lengths too, so moving text from one stage to the other changes the key
+    const uint64_t VertexLength = VertexSource.size();
+    const uint64_t PixelLength = PixelSource.size();
+
+    CFNV1A Hash(CFNV1A::EHashLength::k64Bit);
+    Hash.HashData(&VertexLength, sizeof(VertexLength));
+    Hash.HashData(VertexSource.data(), VertexSource.size());
+    Hash.HashData(&PixelLength, sizeof(PixelLength));
+    Hash.HashData(PixelSource.data(), PixelSource.size());
+    return Hash.GetHash64();
+}
+
+bool CShaderCache::Load(uint64_t MaterialHash, uint64_t SourceHash, SProgramBinary& rOut)
+{
+    if (!smEnabled)
+        return false;
+
+    const TString Path = EntryPath(MaterialHash);
+
+    if (!FileUtil::Exists(Path))
+        return false;
+
+    CFileInStream File(Path, std::endian::little);
+
+    if (!File.IsValid())
+        return false;
+
+    // Any mismatch means the entry is stale; it will be overwritten once the shader is recompiled
+    if (File.ReadU32() != gkShaderCacheMagic || File.ReadU32() != gkShaderCacheVersion)
+        return false;
+
+    if (File.ReadU64() != smDriverHash || File.ReadU64() != SourceHash)
+        return false;
+
+    rOut.Format = File.ReadU32();
+    const uint32_t DataSize = File.ReadU32();
+    const uint64_t DataHash = File.ReadU64();
+
+    if (DataSize == 0 || File.Tell() + DataSize > File.Size())
+        return false;
+
+    rOut.Data.resize(DataSize);
+    File.ReadBytes(rOut.Data.data(), DataSize);
+
+    // A damaged binary could make the driver misbehave, so don't hand it over
+    if (HashBinary(rOut.Data) != DataHash)
+    {
+        NLog::Warn("Shader cache entry {} is corrupt; ignoring it", *Path);
+        rOut.Data.clear();
+        return false;
+    }
+
+    return true;
+}
+
+bool CShaderCache::Store(uint64_t MaterialHash, uint64_t SourceHash, const SProgramBinary& rkBinary)
+{
+    if (!smEnabled || rkBinary.Data.empty())
+        return false;
+
+    const TString Path = EntryPath(MaterialHash);
+    CFileOutStream File(Path, std::endian::little);
+
+    if (!File.IsValid())
+    {
+        NLog::Warn("Couldn't write shader cache entry {}", *Path);
+        return false;
+    }
+
+    File.WriteU32(gkShaderCacheMagic);
+    File.WriteU32(gkShaderCacheVersion);
+    File.WriteU64(smDriverHash);
+    File.WriteU64(SourceHash);
+    File.WriteU32(rkBinary.Format);
+    File.WriteU32(static_cast<uint32_t>(rkBinary.Data.size()));
+    File.WriteU64(HashBinary(rkBinary.Data));
+    File.WriteBytes(rkBinary.Data.data(), rkBinary.Data.size());
+    return true;
+}
+
+void CShaderCache::Remove(uint64_t MaterialHash)
+{
+    if (!smEnabled)
+        return;
+
+    const TString Path = EntryPath(MaterialHash);
+
+    if (FileUtil::Exists(Path))
+        FileUtil::DeleteFile(Path);
+}
+
+/** Links a program from its cached binary. If the driver rejects the binary (usually after a driver update),
+ *  the entry is removed and false is returned, so the caller compiles from source and stores the new binary. */
+bool CShaderCache::LoadProgram(uint64_t MaterialHash, uint64_t SourceHash, IProgramBinaryLoader& rLoader)
+{
+    SProgramBinary Binary;
+
+    if (!Load(MaterialHash, SourceHash, Binary))
+        return false;
+
+    if (rLoader.LoadProgramBinary(Binary.Format, Binary.Data))
+        return true;
+
+    NLog::Debug("Driver rejected cached shader {:016X}; recompiling", MaterialHash);
+    Remove(MaterialHash);
+    return false;
+}
+
+bool CShaderCache::StoreProgram(uint64_t MaterialHash, uint64_t SourceHash, const IProgramBinaryLoader& rkLoader)
+{
+    if (!smEnabled)
+        return false;
+
+    SProgramBinary Binary;
+
+    if (!rkLoader.GetProgramBinary(Binary.Format, Binary.Data))
+        return false;
+
+    return Store(MaterialHash, SourceHash, Binary);
+}
+
+TString CShaderCache::EntryPath(uint64_t MaterialHash)
+{
+    return smCacheDir + TString(fmt::format("{:016X}.bin", MaterialHash));
+}
@@ -0,0 +1,60 @@
+#ifndef CSHADERCACHE_H
+#define CSHADERCACHE_H
+
+#include <Common/TString.h>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+/** The GL program calls the shader cache depends on. CShaderGenerator implements these on top of CShader;
+ *  tests can substitute their own, so the load and fallback logic can run without a driver. */
+class IProgramBinaryLoader
+{
+public:
+    virtual ~IProgramBinaryLoader() = default;
+
+    /** Links the program from a cached binary. Returns false if the driver rejects it. */
+    virtual bool LoadProgramBinary(uint32_t Format, const std::vector<uint8_t>& rkData) = 0;
+    /** Retrieves the binary of a program that was linked from source */
+    virtual bool GetProgramBinary(uint32_t& rOutFormat, std::vector<uint8_t>& rOutData) const = 0;
+};
+
+/**
+ * On-disk cache of linked program binaries for generated material shaders, so they
+ * don't have to be compiled again every session. Entries are keyed by the material's
+ * parameter hash, and are only used if both the driver and the generated source match
+ * the ones they were created with and the stored binary passes its checksum. Binaries are handed to and
+ * taken from the driver through an IProgramBinaryLoader.
+ */
+class CShaderCache
+{
+public:
+    struct SProgramBinary
+    {
+        uint32_t Format = 0;
+        std::vector<uint8_t> Data;
+    };
+
+private:
+    static inline TString smCacheDir;
+    static inline uint64_t smDriverHash = 0;
+    static inline bool smEnabled = false;
+
+    static TString EntryPath(uint64_t MaterialHash);
+
+public:
+    static void SetCacheDirectory(const TString& rkDir);
+    static void Initialize(std::string_view DriverString);
+    static void Shutdown();
+    static bool IsEnabled() { return smEnabled; }
+
+    static uint64_t HashSource(std::string_view VertexSource, std::string_view PixelSource);
+    static bool Load(uint64_t MaterialHash, uint64_t SourceHash, SProgramBinary& rOut);
+    static bool Store(uint64_t MaterialHash, uint64_t SourceHash, const SProgramBinary& rkBinary);
+    static void Remove(uint64_t MaterialHash);
+
+    static bool LoadProgram(uint64_t MaterialHash, uint64_t SourceHash, IProgramBinaryLoader& rLoader);
+    static bool StoreProgram(uint64_t MaterialHash, uint64_t SourceHash, const IProgramBinaryLoader& rkLoader);
+};
+
+#endif // CSHADERCACHE_H
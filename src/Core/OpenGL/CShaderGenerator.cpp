@@ -2,10 +2,12 @@
 
 #include <Common/Macros.h>
 #include "Core/OpenGL/CShader.h"
+#include "Core/OpenGL/CShaderCache.h"
 #include "Core/Resource/CMaterial.h"
 #include <array>
 #include <fstream>
 #include <sstream>
+#include <string>
 #include <string_view>
 #include <GL/glew.h>
 
@@ -147,7 +149,7 @@ CShaderGenerator::CShaderGenerator() = default;
 
 CShaderGenerator::~CShaderGenerator() = default;
 
-bool CShaderGenerator::CreateVertexShader(const CMaterial& rkMat)
+std::string CShaderGenerator::GenerateVertexSource(const CMaterial& rkMat)
 {
     std::stringstream ShaderCode;
 
@@ -366,7 +368,7 @@ bool CShaderGenerator::CreateVertexShader(const CMaterial& rkMat)
 
 
     // Done!
-    return mpShader->CompileVertexSource(ShaderCode.str());
+    return ShaderCode.str();
 }
 
 static std::string GetColorInputExpression(const CMaterialPass* pPass, ETevColorInput iInput)
@@ -399,7 +401,7 @@ static std::string GetAlphaInputExpression(const CMaterialPass* pPass, ETevAlpha
     return std::string(gkTevAlpha[iInput]);
 }
 
-bool CShaderGenerator::CreatePixelShader(const CMaterial& rkMat)
+std::string CShaderGenerator::GeneratePixelSource(const CMaterial& rkMat)
 {
     std::stringstream ShaderCode;
     ShaderCode << "#version 330 core\n"
@@ -527,7 +529,48 @@ bool CShaderGenerator::CreatePixelShader(const CMaterial& rkMat)
                << "}\n\n";
 
     // Done!
-    return mpShader->CompilePixelSource(ShaderCode.str());
+    return ShaderCode.str();
+}
+
+namespace
+{
+/** Hands the shader cache's program binary calls to a CShader */
+class CShaderBinaryLoader final : public IProgramBinaryLoader
+{
+    CShader *mpShader;
+
+public:
+    explicit CShaderBinaryLoader(CShader *pShader)
+        : mpShader(pShader)
+    {}
+
+    bool LoadProgramBinary(uint32_t Format, const std::vector<uint8_t>& rkData) override
+    {
+        return mpShader->LoadProgramBinary(Format, rkData);
+    }
+
+    bool GetProgramBinary(uint32_t& rOutFormat, std::vector<uint8_t>& rOutData) const override
+    {
+        GLenum Format = 0;
+
+        if (!mpShader->GetProgramBinary(Format, rOutData))
+            return false;
+
+        rOutFormat = Format;
+        return true;
+    }
+};
+}
+
+bool CShaderGenerator::LoadCachedProgram(const CMaterial& rkMat, uint64_t SourceHash)
+{
+    CShaderBinaryLoader Loader(mpShader);
+    return CShaderCache::LoadProgram(rkMat.ParametersHash(), SourceHash, Loader);
+}
+
+void CShaderGenerator::StoreCachedProgram(CShader& rShader, uint64_t ParametersHash, uint64_t SourceHash)
+{
+    CShaderCache::StoreProgram(ParametersHash, SourceHash, CShaderBinaryLoader(&rShader));
 }
 
 CShader* CShaderGenerator::GenerateShader(const CMaterial& rkMat)
@@ -535,9 +578,90 @@ CShader* CShaderGenerator::GenerateShader(const CMaterial& rkMat)
     CShaderGenerator Generator;
     Generator.mpShader = new CShader();
 
-    bool Success = Generator.CreateVertexShader(rkMat);
-    if (Success) Success = Generator.CreatePixelShader(rkMat);
+    // Generating source is cheap next to compiling it, so always generate it and use it to validate cached binaries
+    const std::string VertexSource = Generator.GenerateVertexSource(rkMat);
+    const std::string PixelSource = Generator.GeneratePixelSource(rkMat);
+    const uint64_t SourceHash = CShaderCache::HashSource(VertexSource, PixelSource);
+
+    if (Generator.LoadCachedProgram(rkMat, SourceHash))
+        return Generator.mpShader;
+
+    bool Success = Generator.mpShader->CompileVertexSource(VertexSource);
+    if (Success) Success = Generator.mpShader->CompilePixelSource(PixelSource);
+
+    if (Generator.mpShader->LinkShaders())
+        StoreCachedProgram(*Generator.mpShader, rkMat.ParametersHash(), SourceHash);
+
+    return Generator.mpShader;
+}
+
+CShader* CShaderGenerator::GenerateShaderAsync(const CMaterial& rkMat)
+{
+    CShaderGenerator Generator;
+    Generator.mpShader = new CShader();
+
+    std::string VertexSource = Generator.GenerateVertexSource(rkMat);
+    std::string PixelSource = Generator.GeneratePixelSource(rkMat);
+    const uint64_t SourceHash = CShaderCache::HashSource(VertexSource, PixelSource);
+
+    // Cached binaries load quickly enough to use right away
+    if (Generator.LoadCachedProgram(rkMat, SourceHash))
+        return Generator.mpShader;
+
+    SPendingShader Pending{Generator.mpShader, rkMat.ParametersHash(), SourceHash, {}, {}, false};
 
-    Generator.mpShader->LinkShaders();
+    if (CShader::SupportsParallelCompile())
+    {
+        // The driver compiles in the background; we only need to poll for completion
+        Generator.mpShader->BeginCompile(VertexSource, PixelSource);
+        Pending.Submitted = true;
+    }
+    else
+    {
+        // Defer the blocking compile to ProcessPendingShaders(), which spreads them out over several frames
+        Generator.mpShader->mCompilePending = true;
+        Pending.VertexSource = std::move(VertexSource);
+        Pending.PixelSource = std::move(PixelSource);
+    }
+
+    smPendingShaders.push_back(std::move(Pending));
     return Generator.mpShader;
 }
+
+void CShaderGenerator::ProcessPendingShaders()
+{
+    size_t NumBlockingCompiles = 0;
+
+    for (auto Iter = smPendingShaders.begin(); Iter != smPendingShaders.end();)
+    {
+        SPendingShader& rPending = *Iter;
+
+        if (!rPending.Submitted)
+        {
+            if (NumBlockingCompiles >= skMaxBlockingCompilesPerFrame)
+                break;
+
+            rPending.pShader->BeginCompile(rPending.VertexSource, rPending.PixelSource);
+            rPending.Submitted = true;
+            NumBlockingCompiles++;
+        }
+
+        if (!rPending.pShader->IsCompileComplete())
+        {
+            ++Iter;
+            continue;
+        }
+
+        if (rPending.pShader->FinishCompile())
+            StoreCachedProgram(*rPending.pShader, rPending.ParametersHash, rPending.SourceHash);
+
+        Iter = smPendingShaders.erase(Iter);
+    }
+}
+
+void CShaderGenerator::CancelPendingShader(const CShader* pkShader)
+{
+    std::erase_if(smPendingShaders, [pkShader](const SPendingShader& rkPending) {
+        return rkPending.pShader == pkShader;
+    });
+}
@@ -1,6 +1,10 @@
 #ifndef SHADERGEN_H
 #define SHADERGEN_H
 
+#include <cstdint>
+#include <deque>
+#include <string>
+
 class CMaterial;
 class CShader;
 
@@ -23,13 +27,34 @@ class CShaderGenerator
 {
     CShader *mpShader = nullptr;
 
+    // Shaders that have been handed out but aren't linked yet. Completed in submission order.
+    struct SPendingShader
+    {
+        CShader *pShader;
+        uint64_t ParametersHash;
+        uint64_t SourceHash;
+        std::string VertexSource;
+        std::string PixelSource;
+        bool Submitted;
+    };
+    static inline std::deque<SPendingShader> smPendingShaders;
+
+    // Without parallel compile support every compile blocks, so only this many are started per frame
+    static constexpr size_t skMaxBlockingCompilesPerFrame = 2;
+
     CShaderGenerator();
     ~CShaderGenerator();
-    bool CreateVertexShader(const CMaterial& rkMat);
-    bool CreatePixelShader(const CMaterial& rkMat);
+    std::string GenerateVertexSource(const CMaterial& rkMat);
+    std::string GeneratePixelSource(const CMaterial& rkMat);
+    bool LoadCachedProgram(const CMaterial& rkMat, uint64_t SourceHash);
+    static void StoreCachedProgram(CShader& rShader, uint64_t ParametersHash, uint64_t SourceHash);
 
 public:
     static CShader* GenerateShader(const CMaterial& rkMat);
+    static CShader* GenerateShaderAsync(const CMaterial& rkMat);
+    static void ProcessPendingShaders();
+    static void CancelPendingShader(const CShader* pkShader);
+    static size_t NumPendingShaders() { return smPendingShaders.size(); }
 };
 
 #endif // SHADERGEN_H
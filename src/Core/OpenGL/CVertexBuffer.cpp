@@ -176,6 +176,8 @@ void CVertexBuffer::Clear()
         glDeleteBuffers(static_cast<GLsizei>(mAttribBuffers.size()), mAttribBuffers.data());
 
     mBuffered = false;
+    mClientDataReleased = false;
+    mNumReleasedVertices = 0;
     mPositions.clear();
     mNormals.clear();
     mColors[0].clear();
@@ -190,6 +192,10 @@ void CVertexBuffer::Clear()
 
 void CVertexBuffer::Buffer()
 {
+    // The GL buffers are the only copy left; nothing to re-upload
+    if (mClientDataReleased)
+        return;
+
     // Make sure we don't end up with two buffers for the same data...
     if (mBuffered)
     {
@@ -243,6 +249,27 @@ void CVertexBuffer::Buffer()
     mBuffered = true;
 }
 
+void CVertexBuffer::ReleaseClientData()
+{
+    if (!mBuffered || mClientDataReleased)
+        return;
+
+    mNumReleasedVertices = mPositions.size();
+    mClientDataReleased = true;
+
+    std::vector<CVector3f>().swap(mPositions);
+    std::vector<CVector3f>().swap(mNormals);
+
+    for (auto& colors : mColors)
+        std::vector<CColor>().swap(colors);
+
+    for (auto& coords : mTexCoords)
+        std::vector<CVector2f>().swap(coords);
+
+    std::vector<TBoneIndices>().swap(mBoneIndices);
+    std::vector<TBoneWeights>().swap(mBoneWeights);
+}
+
 void CVertexBuffer::Bind()
 {
     if (!mBuffered)
@@ -280,7 +307,51 @@ void CVertexBuffer::SetSkin(CSkin *pSkin)
 
 size_t CVertexBuffer::Size() const
 {
-    return mPositions.size();
+    return mClientDataReleased ? mNumReleasedVertices : mPositions.size();
+}
+
+size_t CVertexBuffer::ClientMemoryUsage() const
+{
+    size_t Bytes = (mPositions.capacity() + mNormals.capacity()) * sizeof(CVector3f) +
+                   mBoneIndices.capacity() * sizeof(TBoneIndices) +
+                   mBoneWeights.capacity() * sizeof(TBoneWeights);
+
+    for (const auto& colors : mColors)
+        Bytes += colors.capacity() * sizeof(CColor);
+
+    for (const auto& coords : mTexCoords)
+        Bytes += coords.capacity() * sizeof(CVector2f);
+
+    return Bytes;
+}
+
+size_t CVertexBuffer::GPUMemoryUsage() const
+{
+    if (!mBuffered)
+        return 0;
+
+    // Buffer() uploads one array per enabled attribute
+    size_t VertexSize = 0;
+
+    for (size_t iAttrib = 0; iAttrib < mAttribBuffers.size(); iAttrib++)
+    {
+        const auto Attrib = EVertexAttribute::Position << iAttrib;
+        if (!mVtxDesc.HasFlag(Attrib))
+            continue;
+
+        if (iAttrib < 2)
+            VertexSize += sizeof(CVector3f);
+        else if (iAttrib < 4)
+            VertexSize += sizeof(CColor);
+        else if (iAttrib < 12)
+            VertexSize += sizeof(CVector2f);
+        else if (iAttrib == 12)
+            VertexSize += sizeof(TBoneIndices);
+        else if (iAttrib == 13)
+            VertexSize += sizeof(TBoneWeights);
+    }
+
+    return VertexSize * Size();
 }
 
 GLuint CVertexBuffer::CreateVAO()
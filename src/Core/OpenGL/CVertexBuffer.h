@@ -26,6 +26,8 @@ class CVertexBuffer
     std::vector<TBoneIndices> mBoneIndices;           // Vectors of bone indices
     std::vector<TBoneWeights> mBoneWeights;           // Vectors of bone weights
     bool mBuffered = false;                           // Bool value that indicates whether the attributes have been buffered.
+    bool mClientDataReleased = false;                 // The CPU-side attribute arrays were freed after uploading them.
+    size_t mNumReleasedVertices = 0;                  // Vertex count at the time the CPU-side arrays were freed.
 
 public:
     CVertexBuffer();
@@ -39,6 +41,7 @@ public:
     void Reserve(size_t Size);
     void Clear();
     void Buffer();
+    void ReleaseClientData();
     void Bind();
     void Unbind();
     bool IsBuffered() const;
@@ -46,6 +49,8 @@ public:
     void SetVertexDesc(FVertexDescription Desc);
     void SetSkin(CSkin *pSkin);
     size_t Size() const;
+    size_t ClientMemoryUsage() const;
+    size_t GPUMemoryUsage() const;
     GLuint CreateVAO();
 };
 
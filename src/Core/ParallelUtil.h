@@ -0,0 +1,52 @@
+#ifndef PARALLELUTIL_H
+#define PARALLELUTIL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace ParallelUtil
+{
+    // Number of worker threads to use for a batch of independent tasks
+    inline size_t WorkerCount(size_t NumTasks)
+    {
+        const size_t HardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+        return std::min(NumTasks, HardwareThreads);
+    }
+
+    // Calls Function(Index) for every index in [0, NumTasks) on a pool of worker threads.
+    // Tasks are handed out one at a time, so uneven task sizes still balance well.
+    // Returns once every task has completed; runs inline when there's nothing to parallelize.
+    template <typename FuncT>
+    void ParallelFor(size_t NumTasks, FuncT&& Function)
+    {
+        const size_t NumWorkers = WorkerCount(NumTasks);
+
+        if (NumWorkers <= 1)
+        {
+            for (size_t TaskIdx = 0; TaskIdx < NumTasks; TaskIdx++)
+                Function(TaskIdx);
+
+            return;
+        }
+
+        std::atomic<size_t> NextTask{0};
+        std::vector<std::thread> Workers;
+        Workers.reserve(NumWorkers);
+
+        for (size_t WorkerIdx = 0; WorkerIdx < NumWorkers; WorkerIdx++)
+        {
+            Workers.emplace_back([&] {
+                for (size_t TaskIdx = NextTask++; TaskIdx < NumTasks; TaskIdx = NextTask++)
+                    Function(TaskIdx);
+            });
+        }
+
+        for (auto& Worker : Workers)
+            Worker.join();
+    }
+}
+
+#endif // PARALLELUTIL_H
@@ -129,6 +129,13 @@ CRay CCamera::CastRay(const CVector2f& DeviceCoords) const
     return {RayOrigin, RayDir};
 }
 
+// Maps a point in normalized device coordinates (depth in [-1,1]) back into world space
+CVector3f CCamera::UnprojectPoint(const CVector3f& DeviceCoords) const
+{
+    const CMatrix4f InverseVP = (ViewMatrix().Transpose() * ProjectionMatrix().Transpose()).Inverse();
+    return DeviceCoords * InverseVP;
+}
+
 void CCamera::SetMoveMode(ECameraMoveMode Mode)
 {
     mMode = Mode;
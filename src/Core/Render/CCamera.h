@@ -61,6 +61,7 @@ public:
     void ProcessKeyInput(FKeyInputs KeyFlags, double DeltaTime);
     void ProcessMouseInput(FKeyInputs KeyFlags, FMouseInputs MouseFlags, float XMovement, float YMovement);
     CRay CastRay(const CVector2f& DeviceCoords) const;
+    CVector3f UnprojectPoint(const CVector3f& DeviceCoords) const;
     void LoadMatrices() const;
     CTransform4f GetCameraTransform() const;
 
@@ -194,6 +194,25 @@ void CDrawUtil::DrawBillboard(CTexture* pTexture, const CVector3f& Position, con
     CGraphics::sMVPBlock.ModelMatrix = CTransform4f::TranslationMatrix(Position);
     CGraphics::UpdateMVPBlock();
 
+    // Alpha-tested ID output in the pick pass, so clicks through transparent texels miss
+    if (mPickPassActive)
+    {
+        mpPickBillboardShader->SetCurrent();
+
+        static GLuint PickScaleLoc = mpPickBillboardShader->GetUniformLocation("BillboardScale");
+        glUniform2f(PickScaleLoc, Scale.X, Scale.Y);
+
+        static GLuint PickColorLoc = mpPickBillboardShader->GetUniformLocation("ColorIn");
+        glUniform4f(PickColorLoc, mPickColor.R, mPickColor.G, mPickColor.B, mPickColor.A);
+
+        pTexture->Bind(0);
+        CMaterial::KillCachedMaterial();
+        glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+        glDepthMask(GL_TRUE);
+        DrawSquare();
+        return;
+    }
+
     // Set uniforms
     mpBillboardShader->SetCurrent();
 
@@ -223,6 +242,13 @@ void CDrawUtil::DrawLightBillboard(ELightType Type, const CColor& LightColor, co
     CGraphics::sMVPBlock.ModelMatrix = CTransform4f::TranslationMatrix(Position);
     CGraphics::UpdateMVPBlock();
 
+    // The mask only tints the light texture; its alpha is the same test as a regular billboard
+    if (mPickPassActive)
+    {
+        DrawBillboard(GetLightTexture(Type), Position, Scale);
+        return;
+    }
+
     // Set uniforms
     mpLightBillboardShader->SetCurrent();
 
@@ -256,8 +282,54 @@ void CDrawUtil::DrawLightBillboard(ELightType Type, const CColor& LightColor, co
 
 }
 
+void CDrawUtil::BeginPickPass()
+{
+    Init();
+    mPickPassActive = true;
+    mPickColor = CColor::TransparentBlack();
+    glDisable(GL_BLEND);
+}
+
+void CDrawUtil::EndPickPass()
+{
+    mPickPassActive = false;
+    glEnable(GL_BLEND);
+    CMaterial::KillCachedMaterial();
+}
+
+void CDrawUtil::SetPickID(uint32_t ID)
+{
+    ASSERT(ID <= 0xFFFFFF);
+    mPickColor = CColor::Integral(static_cast<uint8_t>(ID & 0xFF),
+                                  static_cast<uint8_t>((ID >> 8) & 0xFF),
+                                  static_cast<uint8_t>((ID >> 16) & 0xFF),
+                                  0xFF);
+}
+
+uint32_t CDrawUtil::DecodePickID(const uint8_t *pkRGBA)
+{
+    return pkRGBA[0] | (pkRGBA[1] << 8) | (pkRGBA[2] << 16);
+}
+
+void CDrawUtil::UsePickShader()
+{
+    Init();
+    mpColorShader->SetCurrent();
+
+    static GLuint ColorLoc = mpColorShader->GetUniformLocation("ColorIn");
+    glUniform4f(ColorLoc, mPickColor.R, mPickColor.G, mPickColor.B, mPickColor.A);
+
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+    glDepthMask(GL_TRUE);
+
+    CMaterial::KillCachedMaterial();
+}
+
 void CDrawUtil::UseColorShader(const CColor& kColor)
 {
+    if (mPickPassActive)
+        return UsePickShader();
+
     Init();
     mpColorShader->SetCurrent();
 
@@ -269,6 +341,9 @@ void CDrawUtil::UseColorShader(const CColor& kColor)
 
 void CDrawUtil::UseColorShaderLighting(const CColor& kColor)
 {
+    if (mPickPassActive)
+        return UsePickShader();
+
     Init();
     mpColorShaderLighting->SetCurrent();
 
@@ -288,6 +363,9 @@ void CDrawUtil::UseTextureShader()
 
 void CDrawUtil::UseTextureShader(const CColor& TintColor)
 {
+    if (mPickPassActive)
+        return UsePickShader();
+
     Init();
     mpTextureShader->SetCurrent();
 
@@ -299,6 +377,9 @@ void CDrawUtil::UseTextureShader(const CColor& TintColor)
 
 void CDrawUtil::UseCollisionShader(bool IsFloor, bool IsUnstandable, const CColor& TintColor /*= CColor::skWhite*/)
 {
+    if (mPickPassActive)
+        return UsePickShader();
+
     Init();
     mpCollisionShader->SetCurrent();
 
@@ -531,6 +612,7 @@ void CDrawUtil::InitShaders()
     mpTextureShader        = CShader::FromResourceFile("TextureShader");
     mpCollisionShader      = CShader::FromResourceFile("CollisionShader");
     mpTextShader           = CShader::FromResourceFile("TextShader");
+    mpPickBillboardShader  = CShader::FromResourceFile("PickBillboardShader");
 }
 
 void CDrawUtil::InitTextures()
@@ -564,5 +646,6 @@ void CDrawUtil::Shutdown()
     mpTextureShader.reset();
     mpCollisionShader.reset();
     mpTextShader.reset();
+    mpPickBillboardShader.reset();
     mDrawUtilInitialized = false;
 }
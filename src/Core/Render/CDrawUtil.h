@@ -58,6 +58,11 @@ class CDrawUtil
     static inline std::unique_ptr<CShader> mpTextureShader;
     static inline std::unique_ptr<CShader> mpCollisionShader;
     static inline std::unique_ptr<CShader> mpTextShader;
+    static inline std::unique_ptr<CShader> mpPickBillboardShader;
+
+    // ID pass state; while active, every shader setup writes the current pick color instead
+    static inline bool mPickPassActive = false;
+    static inline CColor mPickColor = CColor::TransparentBlack();
 
     // Textures
     static inline TResPtr<CTexture> mpCheckerTexture;
@@ -103,6 +108,15 @@ public:
     static void UseTextureShader(const CColor& TintColor);
     static void UseCollisionShader(bool IsFloor, bool IsUnstandable, const CColor& TintColor = CColor::White());
 
+    static void BeginPickPass();
+    static void EndPickPass();
+    static bool IsPickPass() { return mPickPassActive; }
+    static void UsePickShader();
+
+    // Pick IDs are packed into the RGB channels of an RGBA8 target; 0 is reserved for "nothing here"
+    static void SetPickID(uint32_t ID);
+    static uint32_t DecodePickID(const uint8_t *pkRGBA);
+
     static CShader* GetTextShader();
     static void LoadCheckerboardTexture(uint32_t GLTextureUnit);
     static CTexture* GetLightTexture(ELightType Type);
@@ -1,6 +1,7 @@
 #include "Core/Render/CGraphics.h"
 
 #include "Core/OpenGL/CShader.h"
+#include "Core/OpenGL/CShaderCache.h"
 #include "Core/OpenGL/CUniformBuffer.h"
 #include "Core/OpenGL/CVertexArrayManager.h"
 #include "Core/Render/CBoneTransformData.h"
@@ -10,6 +11,8 @@
 #include <Common/Math/CVector3f.h>
 #include <Common/Math/CTransform4f.h>
 
+#include <string>
+
 // ************ MEMBER INITIALIZATION ************
 std::unique_ptr<CUniformBuffer> CGraphics::mpMVPBlockBuffer;
 std::unique_ptr<CUniformBuffer> CGraphics::mpVertexBlockBuffer;
@@ -47,6 +50,26 @@ void CGraphics::Initialize()
         glewInit();
         glGetError(); // This is to work around a glew bug - error is always set after initializing
 
+        // Let the driver compile material shaders on as many threads as it likes
+        if (GLEW_KHR_parallel_shader_compile)
+            glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+        else if (GLEW_ARB_parallel_shader_compile)
+            glMaxShaderCompilerThreadsARB(0xFFFFFFFF);
+
+        if (CShader::SupportsProgramBinaries())
+        {
+            // Cached program binaries are only valid for the driver that produced them
+            std::string DriverString;
+
+            for (const GLenum Name : {GL_VENDOR, GL_RENDERER, GL_VERSION})
+            {
+                if (const auto* pkString = reinterpret_cast<const char*>(glGetString(Name)))
+                    DriverString.append(pkString).push_back('\n');
+            }
+
+            CShaderCache::Initialize(DriverString);
+        }
+
         NLog::Debug("Creating uniform buffers");
         mpMVPBlockBuffer = std::make_unique<CUniformBuffer>(sizeof(sMVPBlock));
         mpVertexBlockBuffer = std::make_unique<CUniformBuffer>(sizeof(sVertexBlock));
@@ -70,6 +93,7 @@ void CGraphics::Shutdown()
         return;
 
     NLog::Debug("Shutting down CGraphics");
+    CShaderCache::Shutdown();
     mpMVPBlockBuffer.reset();
     mpVertexBlockBuffer.reset();
     mpPixelBlockBuffer.reset();
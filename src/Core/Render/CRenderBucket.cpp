@@ -87,6 +87,24 @@ void CRenderBucket::CSubBucket::Draw(const SViewInfo& rkViewInfo)
     }
 }
 
+void CRenderBucket::CSubBucket::DrawPick(const SViewInfo& rkViewInfo, std::vector<SRenderablePtr>& rPickTable)
+{
+    const FRenderOptions Options = rkViewInfo.pRenderer->RenderOptions();
+
+    for (size_t iPtr = 0; iPtr < mSize; iPtr++)
+    {
+        const SRenderablePtr& rkPtr = mRenderables[iPtr];
+
+        // Selection outlines aren't part of the object's pickable surface
+        if (rkPtr.Command == ERenderCommand::DrawSelection)
+            continue;
+
+        rPickTable.push_back(rkPtr);
+        CDrawUtil::SetPickID(static_cast<uint32_t>(rPickTable.size()));
+        rkPtr.pRenderable->Draw(Options, rkPtr.ComponentIndex, rkPtr.Command, rkViewInfo);
+    }
+}
+
 // ************ CRenderBucket ************
 CRenderBucket::CRenderBucket() = default;
 CRenderBucket::~CRenderBucket() = default;
@@ -111,3 +129,10 @@ void CRenderBucket::Draw(const SViewInfo& rkViewInfo)
     mTransparentSubBucket.Sort(rkViewInfo.pCamera, mEnableDepthSortDebugVisualization);
     mTransparentSubBucket.Draw(rkViewInfo);
 }
+
+void CRenderBucket::DrawPick(const SViewInfo& rkViewInfo, std::vector<SRenderablePtr>& rPickTable)
+{
+    // Everything writes depth in the pick pass, so draw order doesn't matter and there's no need to sort
+    mOpaqueSubBucket.DrawPick(rkViewInfo, rPickTable);
+    mTransparentSubBucket.DrawPick(rkViewInfo, rPickTable);
+}
@@ -26,6 +26,7 @@ class CRenderBucket
         void Sort(const CCamera *pkCamera, bool DebugVisualization);
         void Clear();
         void Draw(const SViewInfo& rkViewInfo);
+        void DrawPick(const SViewInfo& rkViewInfo, std::vector<SRenderablePtr>& rPickTable);
     };
 
     CSubBucket mOpaqueSubBucket;
@@ -38,6 +39,9 @@ public:
     void Add(const SRenderablePtr& rkPtr, bool Transparent);
     void Clear();
     void Draw(const SViewInfo& rkViewInfo);
+
+    // Draws every renderable with its index in rPickTable (plus one) as a flat ID color
+    void DrawPick(const SViewInfo& rkViewInfo, std::vector<SRenderablePtr>& rPickTable);
 };
 
 #endif // CRENDERBUCKET_H
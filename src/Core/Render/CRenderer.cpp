@@ -1,13 +1,17 @@
 #include "Core/Render/CRenderer.h"
 
+#include "Core/OpenGL/CDynamicVertexBuffer.h"
 #include "Core/Render/CCamera.h"
 #include "Core/Render/CDrawUtil.h"
 #include "Core/Render/CGraphics.h"
 #include "Core/Render/SRenderablePtr.h"
 #include "Core/Render/SViewInfo.h"
+#include "Core/Resource/CMaterial.h"
 #include "Core/Resource/Factory/CTextureDecoder.h"
 #include <Common/Math/CTransform4f.h>
 
+#include <algorithm>
+
 // ************ STATIC MEMBER INITIALIZATION ************
 uint32_t CRenderer::sNumRenderers = 0;
 
@@ -336,6 +340,10 @@ void CRenderer::BeginFrame()
     CGraphics::SetActiveContext(mContextIndex);
     glGetIntegerv(GL_FRAMEBUFFER_BINDING, &mDefaultFramebuffer);
 
+    // Pick up any material shaders that finished compiling since the last frame
+    CMaterial::ProcessPendingShaders();
+    CDynamicVertexBuffer::BeginFrame();
+
     mSceneFramebuffer.SetMultisamplingEnabled(true);
     mSceneFramebuffer.Resize(mViewportWidth, mViewportHeight);
     mSceneFramebuffer.Bind();
@@ -360,6 +368,133 @@ void CRenderer::ClearDepthBuffer()
     glClear(GL_DEPTH_BUFFER_BIT);
 }
 
+SPickResult CRenderer::RenderPickBuffer(const SViewInfo& rkViewInfo, const CVector2f& DeviceCoords, uint32_t Radius)
+{
+    if (!mInitialized)
+        Init();
+
+    SPickResult Out;
+
+    const auto Width = static_cast<int32_t>(mViewportWidth);
+    const auto Height = static_cast<int32_t>(mViewportHeight);
+    const auto CenterX = static_cast<int32_t>((DeviceCoords.X + 1.f) * 0.5f * mViewportWidth);
+    const auto CenterY = static_cast<int32_t>((DeviceCoords.Y + 1.f) * 0.5f * mViewportHeight);
+    const auto Extent = static_cast<int32_t>(Radius);
+
+    // Only the pixels around the cursor are rasterized and read back
+    const int32_t MinX = std::max(CenterX - Extent, 0);
+    const int32_t MinY = std::max(CenterY - Extent, 0);
+    const int32_t MaxX = std::min(CenterX + Extent + 1, Width);
+    const int32_t MaxY = std::min(CenterY + Extent + 1, Height);
+
+    if (MinX >= MaxX || MinY >= MaxY)
+    {
+        mBackgroundBucket.Clear();
+        mMidgroundBucket.Clear();
+        mForegroundBucket.Clear();
+        mUIBucket.Clear();
+        return Out;
+    }
+
+    const int32_t RegionW = MaxX - MinX;
+    const int32_t RegionH = MaxY - MinY;
+    std::vector<uint8_t> RegionIDs(RegionW * RegionH * 4, 0);
+    std::vector<float> RegionDepth(RegionW * RegionH, 1.f);
+    std::vector<uint8_t> LayerIDs(RegionIDs.size());
+    std::vector<float> LayerDepth(RegionDepth.size());
+
+    GLint PrevFramebuffer = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &PrevFramebuffer);
+    CGraphics::SetActiveContext(mContextIndex);
+
+    mPickFramebuffer.SetMultisamplingEnabled(false);
+    mPickFramebuffer.Resize(mViewportWidth, mViewportHeight);
+    mPickFramebuffer.Bind();
+    glViewport(0, 0, mViewportWidth, mViewportHeight);
+    glEnable(GL_SCISSOR_TEST);
+    glScissor(MinX, MinY, RegionW, RegionH);
+
+    if (mOptions.HasFlag(ERenderOption::EnableBackfaceCull))
+        glEnable(GL_CULL_FACE);
+    else
+        glDisable(GL_CULL_FACE);
+
+    glDepthRange(0.f, 1.f);
+    glClearColor(0.f, 0.f, 0.f, 0.f);
+    rkViewInfo.pCamera->LoadMatrices();
+    CDrawUtil::BeginPickPass();
+    mPickTable.clear();
+
+    // Depth groups are separated by depth clears, so each one is read back on its own;
+    // later groups draw over earlier ones, same as in RenderBuckets. UI isn't pickable.
+    for (CRenderBucket* pBucket : {&mBackgroundBucket, &mMidgroundBucket, &mForegroundBucket})
+    {
+        glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+        glDepthMask(GL_TRUE);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        const size_t NumPrevious = mPickTable.size();
+        pBucket->DrawPick(rkViewInfo, mPickTable);
+        pBucket->Clear();
+
+        if (mPickTable.size() == NumPrevious)
+            continue;
+
+        glReadPixels(MinX, MinY, RegionW, RegionH, GL_RGBA, GL_UNSIGNED_BYTE, LayerIDs.data());
+        glReadPixels(MinX, MinY, RegionW, RegionH, GL_DEPTH_COMPONENT, GL_FLOAT, LayerDepth.data());
+
+        for (size_t iPixel = 0; iPixel < LayerDepth.size(); iPixel++)
+        {
+            if (CDrawUtil::DecodePickID(&LayerIDs[iPixel * 4]) != 0)
+            {
+                std::copy_n(&LayerIDs[iPixel * 4], 4, &RegionIDs[iPixel * 4]);
+                RegionDepth[iPixel] = LayerDepth[iPixel];
+            }
+        }
+    }
+    mUIBucket.Clear();
+
+    CDrawUtil::EndPickPass();
+    glDisable(GL_SCISSOR_TEST);
+    glClearColor(mClearColor.R, mClearColor.G, mClearColor.B, mClearColor.A);
+    glBindFramebuffer(GL_FRAMEBUFFER, PrevFramebuffer);
+
+    // Take the hit closest to the requested pixel
+    int32_t BestDistSq = INT32_MAX;
+
+    for (int32_t Y = 0; Y < RegionH; Y++)
+    {
+        for (int32_t X = 0; X < RegionW; X++)
+        {
+            const int32_t PixelIdx = (Y * RegionW) + X;
+            const uint32_t ID = CDrawUtil::DecodePickID(&RegionIDs[PixelIdx * 4]);
+
+            if (ID == 0 || ID > mPickTable.size())
+                continue;
+
+            const int32_t DX = MinX + X - CenterX;
+            const int32_t DY = MinY + Y - CenterY;
+            const int32_t DistSq = (DX * DX) + (DY * DY);
+
+            if (DistSq < BestDistSq)
+            {
+                const SRenderablePtr& rkPtr = mPickTable[ID - 1];
+                BestDistSq = DistSq;
+                Out.Hit = true;
+                Out.pRenderable = rkPtr.pRenderable;
+                Out.ComponentIndex = rkPtr.ComponentIndex;
+                Out.Depth = RegionDepth[PixelIdx];
+                Out.DeviceCoords = CVector2f(
+                    ((static_cast<float>(MinX + X) + 0.5f) / mViewportWidth) * 2.f - 1.f,
+                    ((static_cast<float>(MinY + Y) + 0.5f) / mViewportHeight) * 2.f - 1.f
+                );
+            }
+        }
+    }
+
+    return Out;
+}
+
 // ************ PRIVATE ************
 void CRenderer::InitFramebuffer()
 {
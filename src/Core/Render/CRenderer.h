@@ -6,11 +6,14 @@
 #include "Core/Render/EDepthGroup.h"
 #include "Core/Render/ERenderCommand.h"
 #include "Core/Render/FRenderOptions.h"
+#include "Core/Render/SRenderablePtr.h"
 
 #include <Common/CColor.h>
 #include <Common/Math/CAABox.h>
+#include <Common/Math/CVector2f.h>
 
 #include <array>
+#include <vector>
 
 class CAABox;
 class CModel;
@@ -44,6 +47,17 @@ enum class EBloomMode
  *
  * for more complaints about the rendering system implementation, see CSceneNode
  */
+struct SPickResult
+{
+    bool Hit = false;
+    IRenderable *pRenderable = nullptr;
+    int32_t ComponentIndex = -1;
+
+    // Location of the picked pixel, in normalized device coordinates, with window-space depth in [0,1]
+    CVector2f DeviceCoords{CVector2f::Zero()};
+    float Depth = 1.f;
+};
+
 class CRenderer
 {
     FRenderOptions mOptions{ERenderOption::EnableUVScroll | ERenderOption::EnableBackfaceCull};
@@ -64,6 +78,10 @@ class CRenderer
     std::array<CFramebuffer, 3> mBloomFramebuffers;
     GLint mDefaultFramebuffer = 0;
 
+    // ID picking
+    CFramebuffer mPickFramebuffer;
+    std::vector<SRenderablePtr> mPickTable;
+
     CRenderBucket mBackgroundBucket;
     CRenderBucket mMidgroundBucket;
     CRenderBucket mForegroundBucket;
@@ -98,6 +116,10 @@ public:
     void EndFrame();
     void ClearDepthBuffer();
 
+    // Draws the queued buckets as flat IDs to an offscreen target and returns the visible
+    // renderable closest to DeviceCoords, searching up to Radius pixels away. Clears the buckets.
+    SPickResult RenderPickBuffer(const SViewInfo& rkViewInfo, const CVector2f& DeviceCoords, uint32_t Radius = 2);
+
     // Private
 private:
     void InitFramebuffer();
@@ -21,6 +21,15 @@ struct SCollisionRenderSettings
     bool TintUnwalkableTris = true;
 
     SCollisionRenderSettings() = default;
+
+    /** Whether surfaces with the given material are hidden from rendering and picking */
+    bool IsMaterialHidden(const CCollisionMaterial& rkMat) const
+    {
+        if (HideMaterial & rkMat)
+            return true;
+
+        return HideMask != 0 && (rkMat.RawFlags() & HideMask) != 0;
+    }
 };
 
 struct SViewInfo
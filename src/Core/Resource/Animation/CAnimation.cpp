@@ -5,7 +5,57 @@
 #include <Common/Math/CVector3f.h>
 #include "Core/Resource/Animation/CAnimEventData.h"
 
+#include <algorithm>
+#include <array>
 #include <cfloat>
+#include <cmath>
+#include <cstring>
+
+float CAnimation::sCompressionTolerance = 0.0001f;
+std::atomic<uint32_t> CAnimation::sNextKeyGeneration{0};
+
+namespace
+{
+
+// Slerps NumRots quaternion pairs stored as separate component arrays. Written without
+// per-element calls or early-outs so the compiler can vectorize the loop.
+void BatchSlerp(size_t NumRots, float t,
+                const float* pLowW, const float* pLowX, const float* pLowY, const float* pLowZ,
+                const float* pHighW, const float* pHighX, const float* pHighY, const float* pHighZ,
+                float* pOutW, float* pOutX, float* pOutY, float* pOutZ)
+{
+    for (size_t i = 0; i < NumRots; i++)
+    {
+        const float CosHalfTheta = (pLowW[i] * pHighW[i]) + (pLowX[i] * pHighX[i]) + (pLowY[i] * pHighY[i]) + (pLowZ[i] * pHighZ[i]);
+        const float ClampedCos = std::clamp(CosHalfTheta, -1.f, 1.f);
+        const float SinHalfTheta = std::sqrt(1.f - (ClampedCos * ClampedCos));
+        const float HalfTheta = std::acos(ClampedCos);
+
+        const bool Identical = std::fabs(CosHalfTheta) >= 1.f;
+        const bool Degenerate = SinHalfTheta < 0.001f;
+        const float InvSin = Degenerate ? 0.f : 1.f / SinHalfTheta;
+
+        float ScalarA = Degenerate ? 0.5f : std::sin((1.f - t) * HalfTheta) * InvSin;
+        float ScalarB = Degenerate ? 0.5f : std::sin(t * HalfTheta) * InvSin;
+        ScalarA = Identical ? 1.f : ScalarA;
+        ScalarB = Identical ? 0.f : ScalarB;
+
+        pOutW[i] = (pLowW[i] * ScalarA) + (pHighW[i] * ScalarB);
+        pOutX[i] = (pLowX[i] * ScalarA) + (pHighX[i] * ScalarB);
+        pOutY[i] = (pLowY[i] * ScalarA) + (pHighY[i] * ScalarB);
+        pOutZ[i] = (pLowZ[i] * ScalarA) + (pHighZ[i] * ScalarB);
+    }
+}
+
+template <typename T>
+void AppendKeyData(std::vector<uint8_t>& rData, const T& rkValue)
+{
+    const size_t Offset = rData.size();
+    rData.resize(Offset + sizeof(T));
+    std::memcpy(rData.data() + Offset, &rkValue, sizeof(T));
+}
+
+} // anonymous namespace
 
 CAnimation::CAnimation(CResourceEntry *pEntry /*= 0*/)
     : CResource(pEntry)
@@ -21,51 +71,380 @@ std::unique_ptr<CDependencyTree> CAnimation::BuildDependencyTree()
     return pTree;
 }
 
-void CAnimation::EvaluateTransform(float Time, uint32_t BoneID, CVector3f *pOutTranslation, CQuaternion *pOutRotation, CVector3f *pOutScale) const
+CAnimation::SBoneChannelInfo& CAnimation::BoneInfo(uint32_t BoneID)
 {
-    const bool kInterpolate = true;
-    if (!pOutTranslation && !pOutRotation && !pOutScale)
-        return;
-    if (mDuration == 0.f)
-        return;
+    if (BoneID >= mBoneInfo.size())
+        mBoneInfo.resize(BoneID + 1);
+
+    return mBoneInfo[BoneID];
+}
+
+void CAnimation::SetChannels(const std::vector<TScaleChannel>& rkScales, const std::vector<TRotationChannel>& rkRotations,
+                             const std::vector<TTranslationChannel>& rkTranslations)
+{
+    const float Tolerance = sCompressionTolerance;
+    mKeyData.clear();
+
+    const auto PackVectorChannel = [this, Tolerance](const std::vector<CVector3f>& rkKeys)
+    {
+        SChannel Channel;
+        Channel.Offset = static_cast<uint32_t>(mKeyData.size());
+
+        if (rkKeys.empty())
+            return Channel;
+
+        CVector3f Min = rkKeys[0];
+        CVector3f Max = rkKeys[0];
+        float MaxDelta = 0.f;
+
+        for (const CVector3f& rkKey : rkKeys)
+        {
+            Min = CVector3f(std::min(Min.X, rkKey.X), std::min(Min.Y, rkKey.Y), std::min(Min.Z, rkKey.Z));
+            Max = CVector3f(std::max(Max.X, rkKey.X), std::max(Max.Y, rkKey.Y), std::max(Max.Z, rkKey.Z));
+            MaxDelta = std::max({MaxDelta, std::fabs(rkKey.X - rkKeys[0].X), std::fabs(rkKey.Y - rkKeys[0].Y), std::fabs(rkKey.Z - rkKeys[0].Z)});
+        }
+
+        // Constant channel - keep only the first key
+        if (MaxDelta <= Tolerance)
+        {
+            Channel.Format = EKeyFormat::Float;
+            Channel.Constant = true;
+            Channel.Stride = sizeof(float) * 3;
+            AppendKeyData(mKeyData, std::array<float, 3>{rkKeys[0].X, rkKeys[0].Y, rkKeys[0].Z});
+            return Channel;
+        }
+
+        const CVector3f Step = (Max - Min) / 65535.f;
+
+        if (std::max({Step.X, Step.Y, Step.Z}) * 0.5f <= Tolerance)
+        {
+            Channel.Format = EKeyFormat::Quantized;
+            Channel.Stride = sizeof(uint16_t) * 3;
+            Channel.QuantMin = Min;
+            Channel.QuantStep = Step;
+
+            const auto Quantize = [](float Value, float Base, float StepSize) -> uint16_t
+            {
+                if (StepSize <= 0.f)
+                    return 0;
+
+                return static_cast<uint16_t>(std::clamp(std::round((Value - Base) / StepSize), 0.f, 65535.f));
+            };
+
+            for (const CVector3f& rkKey : rkKeys)
+            {
+                AppendKeyData(mKeyData, std::array<uint16_t, 3>{
+                    Quantize(rkKey.X, Min.X, Step.X),
+                    Quantize(rkKey.Y, Min.Y, Step.Y),
+                    Quantize(rkKey.Z, Min.Z, Step.Z)
+                });
+            }
+
+            return Channel;
+        }
+
+        Channel.Format = EKeyFormat::Float;
+        Channel.Stride = sizeof(float) * 3;
+
+        for (const CVector3f& rkKey : rkKeys)
+            AppendKeyData(mKeyData, std::array<float, 3>{rkKey.X, rkKey.Y, rkKey.Z});
+
+        return Channel;
+    };
+
+    const auto PackRotationChannel = [this, Tolerance](const std::vector<CQuaternion>& rkKeys)
+    {
+        SChannel Channel;
+        Channel.Offset = static_cast<uint32_t>(mKeyData.size());
+
+        if (rkKeys.empty())
+            return Channel;
+
+        float MaxDelta = 0.f;
+
+        for (const CQuaternion& rkKey : rkKeys)
+        {
+            MaxDelta = std::max({MaxDelta, std::fabs(rkKey.W - rkKeys[0].W), std::fabs(rkKey.X - rkKeys[0].X),
+                                 std::fabs(rkKey.Y - rkKeys[0].Y), std::fabs(rkKey.Z - rkKeys[0].Z)});
+        }
+
+        const bool Constant = (MaxDelta <= Tolerance);
+        const size_t NumKeys = Constant ? 1 : rkKeys.size();
+        Channel.Constant = Constant;
+
+        // Quaternion components are in [-1, 1], so 16-bit fixed point has a fixed worst-case error
+        if ((0.5f / 32767.f) <= Tolerance)
+        {
+            Channel.Format = EKeyFormat::Quantized;
+            Channel.Stride = sizeof(int16_t) * 4;
+
+            const auto Quantize = [](float Value) -> int16_t
+            {
+                return static_cast<int16_t>(std::clamp(std::round(Value * 32767.f), -32767.f, 32767.f));
+            };
+
+            for (size_t iKey = 0; iKey < NumKeys; iKey++)
+            {
+                const CQuaternion& rkKey = rkKeys[iKey];
+                AppendKeyData(mKeyData, std::array<int16_t, 4>{Quantize(rkKey.W), Quantize(rkKey.X), Quantize(rkKey.Y), Quantize(rkKey.Z)});
+            }
+        }
+        else
+        {
+            Channel.Format = EKeyFormat::Float;
+            Channel.Stride = sizeof(float) * 4;
+
+            for (size_t iKey = 0; iKey < NumKeys; iKey++)
+            {
+                const CQuaternion& rkKey = rkKeys[iKey];
+                AppendKeyData(mKeyData, std::array<float, 4>{rkKey.W, rkKey.X, rkKey.Y, rkKey.Z});
+            }
+        }
+
+        return Channel;
+    };
+
+    mScaleChannels.clear();
+    mScaleChannels.reserve(rkScales.size());
+    for (const auto& rkChannel : rkScales)
+        mScaleChannels.push_back(PackVectorChannel(rkChannel));
+
+    mRotationChannels.clear();
+    mRotationChannels.reserve(rkRotations.size());
+    for (const auto& rkChannel : rkRotations)
+        mRotationChannels.push_back(PackRotationChannel(rkChannel));
+
+    mTranslationChannels.clear();
+    mTranslationChannels.reserve(rkTranslations.size());
+    for (const auto& rkChannel : rkTranslations)
+        mTranslationChannels.push_back(PackVectorChannel(rkChannel));
+
+    mKeyData.shrink_to_fit();
+
+    mKeyGeneration = ++sNextKeyGeneration;
+}
+
+CVector3f CAnimation::DecodeVector(const SChannel& rkChannel, uint32_t Key) const
+{
+    const uint8_t *pkData = mKeyData.data() + rkChannel.Offset + (rkChannel.Constant ? 0 : Key * rkChannel.Stride);
+
+    if (rkChannel.Format == EKeyFormat::Quantized)
+    {
+        std::array<uint16_t, 3> Values;
+        std::memcpy(Values.data(), pkData, sizeof(Values));
+
+        return CVector3f(rkChannel.QuantMin.X + (rkChannel.QuantStep.X * Values[0]),
+                         rkChannel.QuantMin.Y + (rkChannel.QuantStep.Y * Values[1]),
+                         rkChannel.QuantMin.Z + (rkChannel.QuantStep.Z * Values[2]));
+    }
+
+    std::array<float, 3> Values;
+    std::memcpy(Values.data(), pkData, sizeof(Values));
+    return CVector3f(Values[0], Values[1], Values[2]);
+}
+
+CQuaternion CAnimation::DecodeRotation(const SChannel& rkChannel, uint32_t Key) const
+{
+    const uint8_t *pkData = mKeyData.data() + rkChannel.Offset + (rkChannel.Constant ? 0 : Key * rkChannel.Stride);
+    CQuaternion Out;
+
+    if (rkChannel.Format == EKeyFormat::Quantized)
+    {
+        std::array<int16_t, 4> Values;
+        std::memcpy(Values.data(), pkData, sizeof(Values));
+
+        Out.W = static_cast<float>(Values[0]) / 32767.f;
+        Out.X = static_cast<float>(Values[1]) / 32767.f;
+        Out.Y = static_cast<float>(Values[2]) / 32767.f;
+        Out.Z = static_cast<float>(Values[3]) / 32767.f;
+    }
+    else
+    {
+        std::array<float, 4> Values;
+        std::memcpy(Values.data(), pkData, sizeof(Values));
+
+        Out.W = Values[0];
+        Out.X = Values[1];
+        Out.Y = Values[2];
+        Out.Z = Values[3];
+    }
+
+    return Out;
+}
+
+SAnimKeyTime CAnimation::ComputeKeyTime(float Time) const
+{
+    SAnimKeyTime Out;
+
+    if (mDuration == 0.f || mNumKeys < 2)
+        return Out;
 
     if (Time >= mDuration)
         Time = mDuration;
     if (Time >= FLT_EPSILON)
         Time -= FLT_EPSILON;
 
-    float t = fmodf(Time, mTickInterval) / mTickInterval;
-    uint32 LowKey = (uint32) (Time / mTickInterval);
-    if (LowKey == (mNumKeys - 1))
-        LowKey = mNumKeys - 2;
+    Out.Interp = fmodf(Time, mTickInterval) / mTickInterval;
+    Out.LowKey = (uint32) (Time / mTickInterval);
+    if (Out.LowKey >= (mNumKeys - 1))
+        Out.LowKey = mNumKeys - 2;
+
+    Out.Valid = true;
+    return Out;
+}
+
+void CAnimation::SamplePoseInto(SAnimPose& rPose, const SAnimKeyTime& rkKey) const
+{
+    rPose.KeyTime = rkKey;
+    rPose.Scales.assign(mScaleChannels.size(), CVector3f::One());
+    rPose.Rotations.assign(mRotationChannels.size(), CQuaternion::Identity());
+    rPose.Translations.assign(mTranslationChannels.size(), CVector3f::Zero());
+
+    if (!rkKey.Valid)
+        return;
+
+    const uint32_t LowKey = rkKey.LowKey;
+    const float t = rkKey.Interp;
 
-    uint8 ScaleChannel = mBoneInfo[BoneID].ScaleChannelIdx;
-    uint8 RotChannel = mBoneInfo[BoneID].RotationChannelIdx;
-    uint8 TransChannel = mBoneInfo[BoneID].TranslationChannelIdx;
+    for (size_t iChan = 0; iChan < mScaleChannels.size(); iChan++)
+    {
+        const SChannel& rkChannel = mScaleChannels[iChan];
+
+        if (rkChannel.Format != EKeyFormat::Empty)
+            rPose.Scales[iChan] = rkChannel.Constant ? DecodeVector(rkChannel, 0) : Math::Lerp<CVector3f>(DecodeVector(rkChannel, LowKey), DecodeVector(rkChannel, LowKey + 1), t);
+    }
 
-    if (ScaleChannel != 0xFF && pOutScale)
+    for (size_t iChan = 0; iChan < mTranslationChannels.size(); iChan++)
     {
-        const CVector3f& rkLow = mScaleChannels[ScaleChannel][LowKey];
-        const CVector3f& rkHigh = mScaleChannels[ScaleChannel][LowKey + 1];
-        *pOutScale = (kInterpolate ? Math::Lerp<CVector3f>(rkLow, rkHigh, t) : rkLow);
+        const SChannel& rkChannel = mTranslationChannels[iChan];
+
+        if (rkChannel.Format != EKeyFormat::Empty)
+            rPose.Translations[iChan] = rkChannel.Constant ? DecodeVector(rkChannel, 0) : Math::Lerp<CVector3f>(DecodeVector(rkChannel, LowKey), DecodeVector(rkChannel, LowKey + 1), t);
     }
 
-    if (RotChannel != 0xFF && pOutRotation)
+    // Gather rotation key pairs into component arrays and slerp every channel in one pass
+    const size_t NumRots = mRotationChannels.size();
+    std::array<std::vector<float>, 12> Components;
+
+    for (auto& rArray : Components)
+        rArray.resize(NumRots);
+
+    for (size_t iChan = 0; iChan < NumRots; iChan++)
     {
-        const CQuaternion& rkLow = mRotationChannels[RotChannel][LowKey];
-        const CQuaternion& rkHigh = mRotationChannels[RotChannel][LowKey + 1];
-        *pOutRotation = (kInterpolate ? rkLow.Slerp(rkHigh, t) : rkLow);
+        const SChannel& rkChannel = mRotationChannels[iChan];
+        CQuaternion Low = CQuaternion::Identity();
+        CQuaternion High = CQuaternion::Identity();
+
+        if (rkChannel.Format != EKeyFormat::Empty)
+        {
+            Low = DecodeRotation(rkChannel, LowKey);
+            High = rkChannel.Constant ? Low : DecodeRotation(rkChannel, LowKey + 1);
+        }
+
+        Components[0][iChan] = Low.W;
+        Components[1][iChan] = Low.X;
+        Components[2][iChan] = Low.Y;
+        Components[3][iChan] = Low.Z;
+        Components[4][iChan] = High.W;
+        Components[5][iChan] = High.X;
+        Components[6][iChan] = High.Y;
+        Components[7][iChan] = High.Z;
     }
 
-    if (TransChannel != 0xFF && pOutTranslation)
+    BatchSlerp(NumRots, t,
+               Components[0].data(), Components[1].data(), Components[2].data(), Components[3].data(),
+               Components[4].data(), Components[5].data(), Components[6].data(), Components[7].data(),
+               Components[8].data(), Components[9].data(), Components[10].data(), Components[11].data());
+
+    for (size_t iChan = 0; iChan < NumRots; iChan++)
     {
-        const CVector3f& rkLow = mTranslationChannels[TransChannel][LowKey];
-        const CVector3f& rkHigh = mTranslationChannels[TransChannel][LowKey + 1];
-        *pOutTranslation = (kInterpolate ? Math::Lerp<CVector3f>(rkLow, rkHigh, t) : rkLow);
+        CQuaternion& rRot = rPose.Rotations[iChan];
+        rRot.W = Components[8][iChan];
+        rRot.X = Components[9][iChan];
+        rRot.Y = Components[10][iChan];
+        rRot.Z = Components[11][iChan];
     }
 }
 
+void CAnimation::SamplePose(float Time, SAnimPose& rPose) const
+{
+    // Skip resampling if the pose already holds this frame, e.g. when the animation is paused
+    const SAnimKeyTime Key = ComputeKeyTime(Time);
+    const SAnimKeyTime& rkHeld = rPose.KeyTime;
+
+    if (rPose.SourceGeneration == mKeyGeneration && rkHeld.Valid == Key.Valid && rkHeld.LowKey == Key.LowKey && rkHeld.Interp == Key.Interp)
+        return;
+
+    SamplePoseInto(rPose, Key);
+    rPose.SourceGeneration = mKeyGeneration;
+}
+
+void CAnimation::PoseTransform(const SAnimPose& rkPose, uint32_t BoneID, CVector3f *pOutTranslation, CQuaternion *pOutRotation, CVector3f *pOutScale) const
+{
+    if (!rkPose.KeyTime.Valid || BoneID >= mBoneInfo.size())
+        return;
+
+    const SBoneChannelInfo& rkInfo = mBoneInfo[BoneID];
+
+    if (rkInfo.ScaleChannelIdx != 0xFF && pOutScale)
+        *pOutScale = rkPose.Scales[rkInfo.ScaleChannelIdx];
+
+    if (rkInfo.RotationChannelIdx != 0xFF && pOutRotation)
+        *pOutRotation = rkPose.Rotations[rkInfo.RotationChannelIdx];
+
+    if (rkInfo.TranslationChannelIdx != 0xFF && pOutTranslation)
+        *pOutTranslation = rkPose.Translations[rkInfo.TranslationChannelIdx];
+}
+
+void CAnimation::EvaluateTransform(float Time, uint32_t BoneID, CVector3f *pOutTranslation, CQuaternion *pOutRotation, CVector3f *pOutScale) const
+{
+    if (!pOutTranslation && !pOutRotation && !pOutScale)
+        return;
+
+    // Only decodes this bone's channels; use SamplePose when evaluating a whole skeleton
+    const SAnimKeyTime Key = ComputeKeyTime(Time);
+    if (!Key.Valid || BoneID >= mBoneInfo.size())
+        return;
+
+    const SBoneChannelInfo& rkInfo = mBoneInfo[BoneID];
+    const uint32_t LowKey = Key.LowKey;
+    const float t = Key.Interp;
+
+    // Empty channels give the same defaults as a sampled pose
+    const auto SampleVector = [&](const SChannel& rkChannel, const CVector3f& rkDefault) {
+        if (rkChannel.Format == EKeyFormat::Empty)
+            return rkDefault;
+
+        return rkChannel.Constant ? DecodeVector(rkChannel, 0) : Math::Lerp<CVector3f>(DecodeVector(rkChannel, LowKey), DecodeVector(rkChannel, LowKey + 1), t);
+    };
+
+    if (rkInfo.ScaleChannelIdx != 0xFF && pOutScale)
+        *pOutScale = SampleVector(mScaleChannels[rkInfo.ScaleChannelIdx], CVector3f::One());
+
+    if (rkInfo.RotationChannelIdx != 0xFF && pOutRotation)
+    {
+        const SChannel& rkChannel = mRotationChannels[rkInfo.RotationChannelIdx];
+
+        if (rkChannel.Format == EKeyFormat::Empty)
+            *pOutRotation = CQuaternion::Identity();
+        else if (rkChannel.Constant)
+            *pOutRotation = DecodeRotation(rkChannel, 0);
+        else
+            *pOutRotation = DecodeRotation(rkChannel, LowKey).Slerp(DecodeRotation(rkChannel, LowKey + 1), t);
+    }
+
+    if (rkInfo.TranslationChannelIdx != 0xFF && pOutTranslation)
+        *pOutTranslation = SampleVector(mTranslationChannels[rkInfo.TranslationChannelIdx], CVector3f::Zero());
+}
+
 bool CAnimation::HasTranslation(uint32_t BoneID) const
 {
-    return (mBoneInfo[BoneID].TranslationChannelIdx != 0xFF);
+    return BoneID < mBoneInfo.size() && mBoneInfo[BoneID].TranslationChannelIdx != 0xFF;
+}
+
+size_t CAnimation::KeyDataSize() const
+{
+    return mKeyData.size() +
+           (mScaleChannels.size() + mRotationChannels.size() + mTranslationChannels.size()) * sizeof(SChannel) +
+           mBoneInfo.size() * sizeof(SBoneChannelInfo);
 }
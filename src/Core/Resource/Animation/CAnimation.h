@@ -3,14 +3,34 @@
 
 #include "Core/Resource/CResource.h"
 #include "Core/Resource/TResPtr.h"
+#include <Common/Math/CQuaternion.h>
+#include <Common/Math/CVector3f.h>
 
-#include <array>
+#include <atomic>
 #include <cstdint>
 #include <vector>
 
 class CAnimEventData;
-class CQuaternion;
-class CVector3f;
+
+// Key pair and interpolation factor for a given time. Identical for every bone
+// in the animation, so it can be computed once per frame and shared.
+struct SAnimKeyTime
+{
+    uint32_t LowKey = 0;
+    float Interp = 0.f;
+    bool Valid = false;
+};
+
+// Every channel of an animation sampled at a single point in time. Owned by whoever samples it,
+// so separate threads or nodes can each keep their own.
+struct SAnimPose
+{
+    SAnimKeyTime KeyTime;
+    uint32_t SourceGeneration = 0;  // Key data the pose was sampled from; 0 if never sampled
+    std::vector<CVector3f> Scales;
+    std::vector<CQuaternion> Rotations;
+    std::vector<CVector3f> Translations;
+};
 
 class CAnimation : public CResource
 {
@@ -25,9 +45,30 @@ class CAnimation : public CResource
     float mTickInterval = 0.0333333f;
     uint32_t mNumKeys = 0;
 
-    std::vector<TScaleChannel> mScaleChannels;
-    std::vector<TRotationChannel> mRotationChannels;
-    std::vector<TTranslationChannel> mTranslationChannels;
+    // Keys for every channel are packed into one buffer. Channels whose keys never move
+    // by more than the compression tolerance store a single key, and the rest are quantized
+    // to 16 bits per component whenever that stays within the tolerance.
+    enum class EKeyFormat : uint8_t
+    {
+        Empty,
+        Float,
+        Quantized
+    };
+
+    struct SChannel
+    {
+        uint32_t Offset = 0;
+        uint32_t Stride = 0;
+        EKeyFormat Format = EKeyFormat::Empty;
+        bool Constant = false;
+        CVector3f QuantMin;
+        CVector3f QuantStep;
+    };
+
+    std::vector<uint8_t> mKeyData;
+    std::vector<SChannel> mScaleChannels;
+    std::vector<SChannel> mRotationChannels;
+    std::vector<SChannel> mTranslationChannels;
 
     struct SBoneChannelInfo
     {
@@ -35,22 +76,45 @@ class CAnimation : public CResource
         uint8_t RotationChannelIdx = 0xFF;
         uint8_t TranslationChannelIdx = 0xFF;
     };
-    std::array<SBoneChannelInfo, 100> mBoneInfo;
+    std::vector<SBoneChannelInfo> mBoneInfo;
+
+    // Identifies the current key data, so a caller's pose can tell whether it's still up to date.
+    // Unique across every animation, since a pose may be reused with a different animation.
+    uint32_t mKeyGeneration = 0;
+    static std::atomic<uint32_t> sNextKeyGeneration;
 
     TResPtr<CAnimEventData> mpEventData;
 
+    static float sCompressionTolerance;
+
+    SBoneChannelInfo& BoneInfo(uint32_t BoneID);
+    void SetChannels(const std::vector<TScaleChannel>& rkScales, const std::vector<TRotationChannel>& rkRotations,
+                     const std::vector<TTranslationChannel>& rkTranslations);
+    CVector3f DecodeVector(const SChannel& rkChannel, uint32_t Key) const;
+    CQuaternion DecodeRotation(const SChannel& rkChannel, uint32_t Key) const;
+    void SamplePoseInto(SAnimPose& rPose, const SAnimKeyTime& rkKey) const;
+
 public:
     explicit CAnimation(CResourceEntry *pEntry = nullptr);
     ~CAnimation() override;
 
     std::unique_ptr<CDependencyTree> BuildDependencyTree() override;
+    SResourceMemoryUsage MemoryUsage() const override { return {.NumResources = 1, .CPUBytes = KeyDataSize()}; }
+    SAnimKeyTime ComputeKeyTime(float Time) const;
+    void SamplePose(float Time, SAnimPose& rPose) const;
+    void PoseTransform(const SAnimPose& rkPose, uint32_t BoneID, CVector3f *pOutTranslation, CQuaternion *pOutRotation, CVector3f *pOutScale) const;
     void EvaluateTransform(float Time, uint32_t BoneID, CVector3f *pOutTranslation, CQuaternion *pOutRotation, CVector3f *pOutScale) const;
     bool HasTranslation(uint32_t BoneID) const;
+    size_t KeyDataSize() const;
 
     float Duration() const               { return mDuration; }
     uint32_t NumKeys() const             { return mNumKeys; }
     float TickInterval() const           { return mTickInterval; }
     CAnimEventData* EventData() const    { return mpEventData; }
+
+    // Maximum error allowed per key component when compacting channels on load
+    static float CompressionTolerance()                 { return sCompressionTolerance; }
+    static void SetCompressionTolerance(float Tolerance) { sCompressionTolerance = Tolerance; }
 };
 
 #endif // CANIMATION_H
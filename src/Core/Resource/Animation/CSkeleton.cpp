@@ -14,35 +14,6 @@ CBone::CBone(CSkeleton *pSkel)
 {
 }
 
-void CBone::UpdateTransform(CBoneTransformData& rData, const SBoneTransformInfo& rkParentTransform, CAnimation *pAnim, float Time, bool AnchorRoot)
-{
-    // Get transform data
-    SBoneTransformInfo TransformInfo;
-    TransformInfo.Position = mLocalPosition;
-
-    if (pAnim)
-        pAnim->EvaluateTransform(Time, mID, &TransformInfo.Position, &TransformInfo.Rotation, &TransformInfo.Scale);
-
-    if (AnchorRoot && IsRoot())
-        TransformInfo.Position = CVector3f::Zero();
-
-    // Apply parent transform
-    TransformInfo.Position = rkParentTransform.Position + (rkParentTransform.Rotation * (rkParentTransform.Scale * TransformInfo.Position));
-    TransformInfo.Rotation = rkParentTransform.Rotation * TransformInfo.Rotation;
-
-    // Calculate transform
-    CTransform4f& rTransform = rData[mID];
-    rTransform.SetIdentity();
-    rTransform.Scale(TransformInfo.Scale);
-    rTransform.Rotate(TransformInfo.Rotation);
-    rTransform.Translate(TransformInfo.Position);
-    rTransform *= mInvBind;
-
-    // Calculate children
-    for (auto* child : mChildren)
-        child->UpdateTransform(rData, TransformInfo, pAnim, Time, AnchorRoot);
-}
-
 CVector3f CBone::TransformedPosition(const CBoneTransformData& rkData) const
 {
     return rkData[mID] * Position();
@@ -105,10 +76,129 @@ uint32_t CSkeleton::MaxBoneID() const
     return (*iter)->ID();
 }
 
-void CSkeleton::UpdateTransform(CBoneTransformData& rData, CAnimation *pAnim, float Time, bool AnchorRoot)
+void CSkeleton::SPoseScratch::Resize(size_t NumBones)
+{
+    for (auto* pArray : {&RotW, &RotX, &RotY, &RotZ})
+        pArray->resize(NumBones);
+
+    Positions.resize(NumBones);
+    Scales.resize(NumBones);
+}
+
+void CSkeleton::UpdateTransform(CBoneTransformData& rData, CAnimation *pAnim, float Time, bool AnchorRoot) const
 {
     ASSERT(rData.NumTrackedBones() >= MaxBoneID());
-    mpRootBone->UpdateTransform(rData, SBoneTransformInfo(), pAnim, Time, AnchorRoot);
+    thread_local SPoseScratch tScratch;
+    EvaluateLocalPose(tScratch, pAnim, Time);
+    ConcatenatePose(tScratch, AnchorRoot);
+    WriteBoneMatrices(tScratch, rData);
+}
+
+void CSkeleton::EvaluateLocalPose(SPoseScratch& rScratch, CAnimation *pAnim, float Time) const
+{
+    const size_t NumBones = mFlat.BoneIDs.size();
+    rScratch.Resize(NumBones);
+
+    // Sample every channel once; the animation slerps all rotation channels in a single batch
+    if (pAnim)
+        pAnim->SamplePose(Time, rScratch.Pose);
+
+    for (size_t iBone = 0; iBone < NumBones; iBone++)
+    {
+        CVector3f& rPosition = rScratch.Positions[iBone];
+        CVector3f& rScale = rScratch.Scales[iBone];
+        CQuaternion Rotation = CQuaternion::Identity();
+        rPosition = mFlat.LocalPositions[iBone];
+        rScale = CVector3f::One();
+
+        if (pAnim)
+            pAnim->PoseTransform(rScratch.Pose, mFlat.BoneIDs[iBone], &rPosition, &Rotation, &rScale);
+
+        rScratch.RotW[iBone] = Rotation.W;
+        rScratch.RotX[iBone] = Rotation.X;
+        rScratch.RotY[iBone] = Rotation.Y;
+        rScratch.RotZ[iBone] = Rotation.Z;
+    }
+}
+
+void CSkeleton::ConcatenatePose(SPoseScratch& rScratch, bool AnchorRoot) const
+{
+    // Bones are in topological order, so each parent is already in model space by the time
+    // its children are reached. Positions and rotations are converted in place.
+    const size_t NumBones = mFlat.BoneIDs.size();
+
+    for (size_t iBone = 0; iBone < NumBones; iBone++)
+    {
+        CVector3f& rPosition = rScratch.Positions[iBone];
+
+        if (AnchorRoot && mFlat.IsRoot[iBone])
+            rPosition = CVector3f::Zero();
+
+        const int32_t Parent = mFlat.ParentIndices[iBone];
+        if (Parent < 0)
+            continue;
+
+        const float PW = rScratch.RotW[Parent];
+        const float PX = rScratch.RotX[Parent];
+        const float PY = rScratch.RotY[Parent];
+        const float PZ = rScratch.RotZ[Parent];
+
+        // Position = ParentPosition + (ParentRotation * (ParentScale * Position))
+        const CVector3f V = rScratch.Scales[Parent] * rPosition;
+        const float TX = 2.f * ((PY * V.Z) - (PZ * V.Y));
+        const float TY = 2.f * ((PZ * V.X) - (PX * V.Z));
+        const float TZ = 2.f * ((PX * V.Y) - (PY * V.X));
+        const CVector3f Rotated(V.X + (PW * TX) + ((PY * TZ) - (PZ * TY)),
+                                V.Y + (PW * TY) + ((PZ * TX) - (PX * TZ)),
+                                V.Z + (PW * TZ) + ((PX * TY) - (PY * TX)));
+        rPosition = rScratch.Positions[Parent] + Rotated;
+
+        // Rotation = ParentRotation * Rotation
+        const float W = rScratch.RotW[iBone];
+        const float X = rScratch.RotX[iBone];
+        const float Y = rScratch.RotY[iBone];
+        const float Z = rScratch.RotZ[iBone];
+        rScratch.RotW[iBone] = (PW * W) - (PX * X) - (PY * Y) - (PZ * Z);
+        rScratch.RotX[iBone] = (PW * X) + (PX * W) + (PY * Z) - (PZ * Y);
+        rScratch.RotY[iBone] = (PW * Y) - (PX * Z) + (PY * W) + (PZ * X);
+        rScratch.RotZ[iBone] = (PW * Z) + (PX * Y) - (PY * X) + (PZ * W);
+    }
+}
+
+void CSkeleton::WriteBoneMatrices(const SPoseScratch& rkScratch, CBoneTransformData& rData) const
+{
+    // Builds Translate * Rotate * Scale * InvBind directly from the quaternion components.
+    // The inverse bind matrix is a pure translation, so it folds into the translation column.
+    const size_t NumBones = mFlat.BoneIDs.size();
+
+    for (size_t iBone = 0; iBone < NumBones; iBone++)
+    {
+        const float W = rkScratch.RotW[iBone];
+        const float X = rkScratch.RotX[iBone];
+        const float Y = rkScratch.RotY[iBone];
+        const float Z = rkScratch.RotZ[iBone];
+        const CVector3f& rkScale = rkScratch.Scales[iBone];
+        const CVector3f& rkPosition = rkScratch.Positions[iBone];
+        const CVector3f& rkInvBind = mFlat.InvBindTranslations[iBone];
+
+        const float R00 = (1.f - 2.f * ((Y * Y) + (Z * Z))) * rkScale.X;
+        const float R01 = (2.f * ((X * Y) - (W * Z))) * rkScale.Y;
+        const float R02 = (2.f * ((X * Z) + (W * Y))) * rkScale.Z;
+        const float R10 = (2.f * ((X * Y) + (W * Z))) * rkScale.X;
+        const float R11 = (1.f - 2.f * ((X * X) + (Z * Z))) * rkScale.Y;
+        const float R12 = (2.f * ((Y * Z) - (W * X))) * rkScale.Z;
+        const float R20 = (2.f * ((X * Z) - (W * Y))) * rkScale.X;
+        const float R21 = (2.f * ((Y * Z) + (W * X))) * rkScale.Y;
+        const float R22 = (1.f - 2.f * ((X * X) + (Y * Y))) * rkScale.Z;
+
+        CTransform4f& rTransform = rData[mFlat.BoneIDs[iBone]];
+        rTransform[0][0] = R00; rTransform[0][1] = R01; rTransform[0][2] = R02;
+        rTransform[1][0] = R10; rTransform[1][1] = R11; rTransform[1][2] = R12;
+        rTransform[2][0] = R20; rTransform[2][1] = R21; rTransform[2][2] = R22;
+        rTransform[0][3] = rkPosition.X + (R00 * rkInvBind.X) + (R01 * rkInvBind.Y) + (R02 * rkInvBind.Z);
+        rTransform[1][3] = rkPosition.Y + (R10 * rkInvBind.X) + (R11 * rkInvBind.Y) + (R12 * rkInvBind.Z);
+        rTransform[2][3] = rkPosition.Z + (R20 * rkInvBind.X) + (R21 * rkInvBind.Y) + (R22 * rkInvBind.Z);
+    }
 }
 
 void CSkeleton::Draw(FRenderOptions /*Options*/, const CBoneTransformData *pkData)
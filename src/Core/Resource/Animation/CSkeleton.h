@@ -16,13 +16,6 @@
 class CBoneTransformData;
 class CBone;
 
-struct SBoneTransformInfo
-{
-    CVector3f Position{CVector3f::Zero()};
-    CQuaternion Rotation{CQuaternion::Identity()};
-    CVector3f Scale{CVector3f::One()};
-};
-
 class CSkeleton : public CResource
 {
     DECLARE_RESOURCE_TYPE(Skeleton)
@@ -31,12 +24,41 @@ class CSkeleton : public CResource
     CBone *mpRootBone = nullptr;
     std::vector<std::unique_ptr<CBone>> mBones;
 
+    // Flattened bone hierarchy used for pose evaluation. Bones are stored in
+    // topological order (parents always precede their children) in parallel arrays.
+    struct SFlatHierarchy
+    {
+        std::vector<uint32_t> BoneIDs;
+        std::vector<int32_t> ParentIndices;
+        std::vector<CVector3f> LocalPositions;
+        std::vector<CVector3f> InvBindTranslations;
+        std::vector<uint8_t> IsRoot;
+    };
+    SFlatHierarchy mFlat;
+
+    // Scratch buffers for UpdateTransform; rotations are kept as separate component arrays
+    // so the matrix loop can be vectorized. These are per-thread rather than per-skeleton,
+    // so nodes sharing a skeleton can be updated concurrently.
+    struct SPoseScratch
+    {
+        std::vector<float> RotW, RotX, RotY, RotZ;
+        std::vector<CVector3f> Positions;
+        std::vector<CVector3f> Scales;
+        SAnimPose Pose;
+
+        void Resize(size_t NumBones);
+    };
+
     static constexpr float skSphereRadius = 0.025f;
 
+    void EvaluateLocalPose(SPoseScratch& rScratch, CAnimation *pAnim, float Time) const;
+    void ConcatenatePose(SPoseScratch& rScratch, bool AnchorRoot) const;
+    void WriteBoneMatrices(const SPoseScratch& rkScratch, CBoneTransformData& rData) const;
+
 public:
     explicit CSkeleton(CResourceEntry *pEntry = nullptr);
     ~CSkeleton() override;
-    void UpdateTransform(CBoneTransformData& rData, CAnimation *pAnim, float Time, bool AnchorRoot);
+    void UpdateTransform(CBoneTransformData& rData, CAnimation *pAnim, float Time, bool AnchorRoot) const;
     CBone* BoneByID(uint32_t BoneID) const;
     CBone* BoneByName(std::string_view name) const;
     uint32_t MaxBoneID() const;
@@ -61,12 +83,10 @@ class CBone
     CQuaternion mRotation;
     CQuaternion mLocalRotation;
     TString mName;
-    CTransform4f mInvBind;
     bool mSelected = false;
 
 public:
     explicit CBone(CSkeleton *pSkel);
-    void UpdateTransform(CBoneTransformData& rData, const SBoneTransformInfo& rkParentTransform, CAnimation *pAnim, float Time, bool AnchorRoot);
     CVector3f TransformedPosition(const CBoneTransformData& rkData) const;
     CQuaternion TransformedRotation(const CBoneTransformData& rkData) const;
     bool IsRoot() const;
@@ -1,12 +1,17 @@
 #include "Core/Resource/Area/CGameArea.h"
 
+#include "Core/GameProject/CResourceEntry.h"
+#include "Core/Resource/Factory/CAreaLoader.h"
 #include "Core/Resource/Model/SSurface.h"
 #include "Core/Resource/Script/CScriptLayer.h"
+#include "Core/Resource/Script/CScriptObject.h"
 #include "Core/Resource/Script/CScriptTemplate.h"
 #include "Core/Render/CRenderer.h"
 #include <Common/Log.h>
+#include <Common/FileIO/CFileInStream.h>
 
 #include <algorithm>
+#include <ranges>
 
 CGameArea::CGameArea(CResourceEntry *pEntry)
     : CResource(pEntry)
@@ -53,12 +58,51 @@ std::unique_ptr<CDependencyTree> CGameArea::BuildDependencyTree()
     return pTree;
 }
 
+SResourceMemoryUsage CGameArea::MemoryUsage() const
+{
+    SResourceMemoryUsage Usage{.NumResources = 1};
+
+    for (const auto& buffer : mSectionDataBuffers)
+        Usage.CPUBytes += buffer.capacity();
+
+    for (const auto& block : mCookedBlockCache | std::views::values)
+        Usage.CPUBytes += block.CompressedData.capacity();
+
+    // Area geometry and collision aren't separate resources, so they're counted here rather than by type
+    auto AddPart = [&Usage](const SResourceMemoryUsage& rkPart)
+    {
+        Usage.CPUBytes += rkPart.CPUBytes;
+        Usage.GPUBytes += rkPart.GPUBytes;
+    };
+
+    for (const auto& pModel : mWorldModels)
+        AddPart(pModel->MemoryUsage());
+
+    for (const auto& pModel : mStaticWorldModels)
+        AddPart(pModel->MemoryUsage());
+
+    if (mpCollision)
+        AddPart(mpCollision->MemoryUsage());
+
+    for (const auto& lights : mLightLayers)
+        Usage.CPUBytes += lights.capacity() * sizeof(CLight);
+
+    for (const auto& pLayer : mScriptLayers)
+    {
+        for (size_t iInst = 0; iInst < pLayer->NumInstances(); iInst++)
+            Usage.CPUBytes += sizeof(CScriptObject) + pLayer->InstanceByIndex(iInst)->PropertyDataSize();
+    }
+
+    return Usage;
+}
+
 void CGameArea::AddWorldModel(std::unique_ptr<CModel>&& pModel)
 {
     mVertexCount += pModel->GetVertexCount();
     mTriangleCount += pModel->GetTriangleCount();
     mAABox.ExpandBounds(pModel->AABox());
 
+    pModel->SetSourceArea(this);
     mWorldModels.push_back(std::move(pModel));
 }
 
@@ -80,7 +124,8 @@ void CGameArea::MergeTerrain()
             bool NewMat = true;
             for (auto it = mStaticWorldModels.begin(); it != mStaticWorldModels.end(); ++it)
             {
-                if ((*it)->GetMaterial() == pMat)
+                // Surfaces that would overflow the model's 16-bit indices start a new batch for the same material
+                if ((*it)->GetMaterial() == pMat && (*it)->GetVertexCount() + pSurf->VertexCount <= CStaticModel::skMaxVertices)
                 {
                     // When we append a new submesh to an existing static model, we bump it to the back of the vector.
                     // This is because mesh ordering actually matters sometimes
@@ -97,6 +142,7 @@ void CGameArea::MergeTerrain()
             if (NewMat)
             {
                 auto pStatic = std::make_unique<CStaticModel>(pMat);
+                pStatic->SetSourceArea(this);
                 pStatic->AddSurface(pSurf);
                 mStaticWorldModels.push_back(std::move(pStatic));
             }
@@ -118,6 +164,77 @@ void CGameArea::ClearTerrain()
     mAABox = CAABox::Infinite();
 }
 
+bool CGameArea::RestoreWorldGeometry()
+{
+    CResourceEntry *pEntry = Entry();
+
+    if (pEntry == nullptr)
+    {
+        NLog::Error("Unable to restore compacted world geometry for an area with no resource entry");
+        return false;
+    }
+
+    CFileInStream File(pEntry->CookedAssetPath(), std::endian::big);
+    const auto pSource = CAreaLoader::LoadMREAGeometry(File, pEntry);
+
+    // The static models share surfaces with the world models, so restoring the world models restores both
+    const auto Matches = [&] {
+        if (!pSource || pSource->mWorldModels.size() != mWorldModels.size())
+            return false;
+
+        for (size_t iMdl = 0; iMdl < mWorldModels.size(); iMdl++)
+        {
+            if (pSource->mWorldModels[iMdl]->GetSurfaceCount() != mWorldModels[iMdl]->GetSurfaceCount())
+                return false;
+        }
+
+        return true;
+    };
+
+    if (!Matches())
+    {
+        NLog::Error("{}: Reloaded area geometry doesn't match the compacted geometry", *pEntry->CookedAssetPath());
+        return false;
+    }
+
+    for (size_t iMdl = 0; iMdl < mWorldModels.size(); iMdl++)
+    {
+        CModel *pModel = mWorldModels[iMdl].get();
+        CModel *pSourceModel = pSource->mWorldModels[iMdl].get();
+
+        for (size_t iSurf = 0; iSurf < pModel->GetSurfaceCount(); iSurf++)
+        {
+            if (pModel->GetSurface(iSurf)->Compacted)
+                pModel->GetSurface(iSurf)->RestoreVertices(*pSourceModel->GetSurface(iSurf));
+        }
+    }
+
+    return true;
+}
+
+void CGameArea::CompactWorldGeometry()
+{
+    if (CBasicModel::GeometryResidency() == EGeometryResidency::Full)
+        return;
+
+    // The world models and the merged terrain share surfaces. Only compact once one of the two has been
+    // fully uploaded and the other hasn't started, so switching between them restores the geometry once.
+    const auto IsBuffered = [](const auto& pkModel) { return pkModel->IsBuffered(); };
+    const size_t NumWorldBuffered = std::ranges::count_if(mWorldModels, IsBuffered);
+    const size_t NumStaticBuffered = std::ranges::count_if(mStaticWorldModels, IsBuffered);
+    const bool WorldSettled = (NumWorldBuffered == 0 || NumWorldBuffered == mWorldModels.size());
+    const bool StaticSettled = (NumStaticBuffered == 0 || NumStaticBuffered == mStaticWorldModels.size());
+
+    if (!WorldSettled || !StaticSettled || (NumWorldBuffered == 0 && NumStaticBuffered == 0))
+        return;
+
+    for (const auto& pModel : mWorldModels)
+    {
+        for (size_t iSurf = 0; iSurf < pModel->GetSurfaceCount(); iSurf++)
+            pModel->GetSurface(iSurf)->CompactToPositions();
+    }
+}
+
 void CGameArea::ClearScriptLayers()
 {
     mScriptLayers.clear();
@@ -145,12 +262,34 @@ CScriptObject* CGameArea::InstanceByID(CInstanceID ID)
 
 CInstanceID CGameArea::FindUnusedInstanceID() const
 {
-    auto ID = CInstanceID((mWorldIndex << 16) | 1);
+    const uint32 LocalID = mInstanceIDs.FindFree();
+
+    if (LocalID == CInstanceIDAllocator::skInvalidID)
+        return CInstanceID();
+
+    return Internal_MakeInstanceID(LocalID);
+}
 
-    while (mObjectMap.contains(ID))
-        ID = CInstanceID(ID.Value() + 1);
+/** Reserves instance IDs for a batch of new instances in one go, preferring a contiguous range.
+ *  IDs are claimed as instances are spawned with them; pass any that go unused to CancelInstanceIDs.
+ *  Returns an empty list if the area doesn't have enough free IDs. */
+std::vector<CInstanceID> CGameArea::ReserveInstanceIDs(uint32 Count)
+{
+    std::vector<CInstanceID> IDs;
+    const std::vector<uint32> LocalIDs = mInstanceIDs.Reserve(Count);
+    IDs.reserve(LocalIDs.size());
+
+    for (const uint32 LocalID : LocalIDs)
+        IDs.push_back(Internal_MakeInstanceID(LocalID));
+
+    return IDs;
+}
 
-    return ID;
+void CGameArea::CancelInstanceIDs(std::span<const CInstanceID> IDs)
+{
+    // IDs that were already claimed by an instance aren't reserved anymore, so this leaves them alone
+    for (const CInstanceID& ID : IDs)
+        mInstanceIDs.CancelReservation(ID.Id());
 }
 
 CScriptObject* CGameArea::SpawnInstance(CScriptTemplate *pTemplate,
@@ -175,7 +314,7 @@ CScriptObject* CGameArea::SpawnInstance(CScriptTemplate *pTemplate,
 
     if (InstanceID.IsValid())
     {
-        if (!mObjectMap.contains(InstanceID))
+        if (mObjectMap.contains(InstanceID) || !(mInstanceIDs.IsFree(InstanceID.Id()) || mInstanceIDs.IsReserved(InstanceID.Id())))
             InstanceID.Invalidate();
     }
 
@@ -193,6 +332,12 @@ CScriptObject* CGameArea::SpawnInstance(CScriptTemplate *pTemplate,
 
         // Look for a valid instance ID
         InstanceID = FindUnusedInstanceID();
+
+        if (InstanceID.IsInvalid())
+        {
+            NLog::Error("Unable to spawn a new script instance; no free instance IDs in area");
+            return nullptr;
+        }
     }
 
     // Spawn instance
@@ -205,7 +350,7 @@ CScriptObject* CGameArea::SpawnInstance(CScriptTemplate *pTemplate,
     if (pTemplate->Game() < EGame::EchoesDemo)
         pInstance->SetActive(true);
     pLayer->AddInstance(pInstance, SuggestedLayerIndex);
-    mObjectMap[InstanceID] = pInstance;
+    Internal_RegisterInstance(pInstance);
     return pInstance;
 }
 
@@ -213,7 +358,7 @@ void CGameArea::AddInstanceToArea(CScriptObject *pInstance)
 {
     // Used for undo after deleting an instance.
     // In the future the script loader should go through SpawnInstance to avoid the need for this function.
-    mObjectMap[pInstance->InstanceID()] = pInstance;
+    Internal_RegisterInstance(pInstance);
 }
 
 void CGameArea::DeleteInstance(CScriptObject *pInstance)
@@ -222,9 +367,7 @@ void CGameArea::DeleteInstance(CScriptObject *pInstance)
     pInstance->Layer()->RemoveInstance(pInstance);
     pInstance->Template()->RemoveObject(pInstance);
 
-    auto it = mObjectMap.find(pInstance->InstanceID());
-    if (it != mObjectMap.end())
-        mObjectMap.erase(it);
+    Internal_UnregisterInstance(pInstance);
 
     if (mpPoiToWorldMap && mpPoiToWorldMap->HasPoiMappings(pInstance->InstanceID()))
         mpPoiToWorldMap->RemovePoi(pInstance->InstanceID());
@@ -241,3 +384,28 @@ void CGameArea::ClearExtraDependencies()
         Entry()->UpdateDependencies();
     }
 }
+
+void CGameArea::Internal_RegisterInstance(CScriptObject *pInstance)
+{
+    const CInstanceID InstanceID = pInstance->InstanceID();
+    const auto [It, Inserted] = mObjectMap.insert_or_assign(InstanceID, pInstance);
+
+    if (Inserted)
+        mInstanceIDs.MarkUsed(InstanceID.Id());
+}
+
+void CGameArea::Internal_UnregisterInstance(CScriptObject *pInstance)
+{
+    const auto It = mObjectMap.find(pInstance->InstanceID());
+
+    if (It != mObjectMap.end() && It->second == pInstance)
+    {
+        mInstanceIDs.Release(It->first.Id());
+        mObjectMap.erase(It);
+    }
+}
+
+CInstanceID CGameArea::Internal_MakeInstanceID(uint32 LocalID) const
+{
+    return CInstanceID((mWorldIndex << 16) | LocalID);
+}
@@ -2,6 +2,7 @@
 #define CGAMEAREA_H
 
 #include "Core/Resource/CResource.h"
+#include "Core/Resource/Area/CInstanceIDAllocator.h"
 #include "Core/Resource/CLight.h"
 #include "Core/Resource/CMaterialSet.h"
 #include "Core/Resource/CPoiToWorld.h"
@@ -13,6 +14,7 @@
 #include <Common/Math/CTransform4f.h>
 
 #include <memory>
+#include <span>
 #include <unordered_map>
 #include <vector>
 
@@ -45,6 +47,16 @@ class CGameArea : public CResource
     };
     std::vector<SSectionNumber> mSectionNumbers;
 
+    // Compressed blocks from the last cook, keyed by a hash of their uncompressed contents.
+    // Lets CAreaCooker skip recompressing blocks that didn't change between saves.
+    struct SCookedBlock
+    {
+        uint32_t DecompressedSize = 0;
+        bool Compressed = false;
+        std::vector<uint8_t> CompressedData;
+    };
+    std::unordered_map<uint64_t, SCookedBlock> mCookedBlockCache;
+
     // Geometry
     CMaterialSet *mpMaterialSet = nullptr;
     std::vector<std::unique_ptr<CModel>> mWorldModels; // TerrainModels is the original version of each model; this is currently mainly used in the POI map editor
@@ -52,6 +64,7 @@ class CGameArea : public CResource
     // Script
     std::vector<std::unique_ptr<CScriptLayer>> mScriptLayers;
     std::unordered_map<CInstanceID, CScriptObject*> mObjectMap;
+    CInstanceIDAllocator mInstanceIDs; // Kept in sync with mObjectMap by Internal_RegisterInstance/Internal_UnregisterInstance
     // Collision
     std::unique_ptr<CCollisionMeshGroup> mpCollision;
     // Lights
@@ -66,18 +79,27 @@ class CGameArea : public CResource
     std::vector<CAssetID> mExtraAreaDeps;
     std::vector< std::vector<CAssetID> > mExtraLayerDeps;
 
+    void Internal_RegisterInstance(CScriptObject *pInstance);
+    void Internal_UnregisterInstance(CScriptObject *pInstance);
+    CInstanceID Internal_MakeInstanceID(uint32_t LocalID) const;
+
 public:
     explicit CGameArea(CResourceEntry *pEntry = nullptr);
     ~CGameArea() override;
     std::unique_ptr<CDependencyTree> BuildDependencyTree() override;
+    SResourceMemoryUsage MemoryUsage() const override;
 
     void AddWorldModel(std::unique_ptr<CModel>&& pModel);
     void MergeTerrain();
     void ClearTerrain();
+    bool RestoreWorldGeometry();
+    void CompactWorldGeometry();
     void ClearScriptLayers();
     size_t TotalInstanceCount() const;
     CScriptObject* InstanceByID(CInstanceID ID);
     CInstanceID FindUnusedInstanceID() const;
+    std::vector<CInstanceID> ReserveInstanceIDs(uint32_t Count);
+    void CancelInstanceIDs(std::span<const CInstanceID> IDs);
     CScriptObject* SpawnInstance(CScriptTemplate* pTemplate, CScriptLayer* pLayer,
                                  const CVector3f& rkPosition = CVector3f::Zero(),
                                  const CQuaternion& rkRotation = CQuaternion::Identity(),
@@ -0,0 +1,176 @@
+#include "Core/Resource/Area/CInstanceIDAllocator.h"
+
+#include <algorithm>
+#include <iterator>
+
+CInstanceIDAllocator::CInstanceIDAllocator()
+{
+    Reset();
+}
+
+// ************ INTERNAL ************
+bool CInstanceIDAllocator::Take(uint32_t ID)
+{
+    auto It = mFreeRanges.upper_bound(ID);
+
+    if (It == mFreeRanges.begin())
+        return false;
+
+    --It;
+    const uint32_t First = It->first;
+    const uint32_t Last = It->second;
+
+    if (ID > Last)
+        return false;
+
+    mFreeRanges.erase(It);
+
+    if (First < ID)
+        mFreeRanges.emplace(First, ID - 1);
+    if (ID < Last)
+        mFreeRanges.emplace(ID + 1, Last);
+
+    return true;
+}
+
+void CInstanceIDAllocator::TakeRange(uint32_t First, uint32_t Count)
+{
+    // The caller guarantees the range lies inside the interval starting at First
+    const auto It = mFreeRanges.find(First);
+    const uint32_t Last = It->second;
+    mFreeRanges.erase(It);
+
+    if (First + Count <= Last)
+        mFreeRanges.emplace(First + Count, Last);
+}
+
+void CInstanceIDAllocator::Give(uint32_t ID)
+{
+    if (ID < skFirstID || ID > skLastID || IsFree(ID))
+        return;
+
+    uint32_t First = ID;
+    uint32_t Last = ID;
+    const auto Next = mFreeRanges.upper_bound(ID);
+
+    // Merge with the neighbouring intervals if they touch this ID
+    if (Next != mFreeRanges.end() && Next->first == ID + 1)
+    {
+        Last = Next->second;
+        mFreeRanges.erase(Next);
+    }
+
+    auto Prev = mFreeRanges.upper_bound(ID);
+
+    if (Prev != mFreeRanges.begin())
+    {
+        --Prev;
+
+        if (Prev->second + 1 == ID)
+        {
+            First = Prev->first;
+            mFreeRanges.erase(Prev);
+        }
+    }
+
+    mFreeRanges.emplace(First, Last);
+}
+
+// ************ PUBLIC ************
+void CInstanceIDAllocator::Reset()
+{
+    mFreeRanges.clear();
+    mFreeRanges.emplace(skFirstID, skLastID);
+    mSharedUses.clear();
+    mReserved.clear();
+}
+
+void CInstanceIDAllocator::MarkUsed(uint32_t ID)
+{
+    // Claiming a reserved ID just turns the reservation into a use
+    if (mReserved.erase(ID) != 0)
+        return;
+
+    if (ID < skFirstID || ID > skLastID)
+        return;
+
+    if (!Take(ID))
+        mSharedUses[ID]++;
+}
+
+void CInstanceIDAllocator::Release(uint32_t ID)
+{
+    if (const auto It = mSharedUses.find(ID); It != mSharedUses.end())
+    {
+        if (--It->second == 0)
+            mSharedUses.erase(It);
+
+        return;
+    }
+
+    Give(ID);
+}
+
+/** Reserves Count IDs, as one contiguous run if there's room for it and otherwise the lowest free IDs.
+ *  Returns an empty list if there aren't enough free IDs left. */
+std::vector<uint32_t> CInstanceIDAllocator::Reserve(uint32_t Count)
+{
+    std::vector<uint32_t> IDs;
+
+    if (Count == 0)
+        return IDs;
+
+    IDs.reserve(Count);
+
+    const auto Run = std::ranges::find_if(mFreeRanges, [Count](const auto& rkRange) {
+        return rkRange.second - rkRange.first + 1 >= Count;
+    });
+
+    if (Run != mFreeRanges.end())
+    {
+        const uint32_t First = Run->first;
+        TakeRange(First, Count);
+
+        for (uint32_t Offset = 0; Offset < Count; Offset++)
+            IDs.push_back(First + Offset);
+    }
+    else
+    {
+        uint32_t NumFree = 0;
+
+        for (const auto& [First, Last] : mFreeRanges)
+            NumFree += Last - First + 1;
+
+        if (NumFree < Count)
+            return IDs;
+
+        while (IDs.size() < Count)
+        {
+            const auto [First, Last] = *mFreeRanges.begin();
+            const uint32_t NumTaken = std::min(Last - First + 1, Count - static_cast<uint32_t>(IDs.size()));
+            TakeRange(First, NumTaken);
+
+            for (uint32_t Offset = 0; Offset < NumTaken; Offset++)
+                IDs.push_back(First + Offset);
+        }
+    }
+
+    mReserved.insert(IDs.begin(), IDs.end());
+    return IDs;
+}
+
+void CInstanceIDAllocator::CancelReservation(uint32_t ID)
+{
+    if (mReserved.erase(ID) != 0)
+        Give(ID);
+}
+
+bool CInstanceIDAllocator::IsFree(uint32_t ID) const
+{
+    auto It = mFreeRanges.upper_bound(ID);
+
+    if (It == mFreeRanges.begin())
+        return false;
+
+    return ID <= std::prev(It)->second;
+}
@@ -0,0 +1,55 @@
+#ifndef CINSTANCEIDALLOCATOR_H
+#define CINSTANCEIDALLOCATOR_H
+
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * Tracks which of an area's 16-bit instance IDs are free, as a set of free intervals.
+ * Lookups and single allocations are logarithmic in the number of intervals, and a
+ * bulk reservation hands out one contiguous run when there's a gap large enough for it.
+ *
+ * Reserved IDs are held back from other allocations until an instance claims them
+ * through MarkUsed, or they're handed back with CancelReservation.
+ */
+class CInstanceIDAllocator
+{
+public:
+    static constexpr uint32_t skFirstID = 1;
+    static constexpr uint32_t skLastID = 0xFFFF;
+    static constexpr uint32_t skInvalidID = UINT32_MAX;
+
+private:
+    /** Free IDs as inclusive [First, Last] intervals, keyed by First */
+    std::map<uint32_t, uint32_t> mFreeRanges;
+
+    /** Extra uses of IDs that are shared by more than one instance. Only happens with malformed data. */
+    std::unordered_map<uint32_t, uint32_t> mSharedUses;
+
+    /** IDs handed out by Reserve that no instance has claimed yet */
+    std::unordered_set<uint32_t> mReserved;
+
+    bool Take(uint32_t ID);
+    void TakeRange(uint32_t First, uint32_t Count);
+    void Give(uint32_t ID);
+
+public:
+    CInstanceIDAllocator();
+
+    void Reset();
+    void MarkUsed(uint32_t ID);
+    void Release(uint32_t ID);
+    std::vector<uint32_t> Reserve(uint32_t Count);
+    void CancelReservation(uint32_t ID);
+
+    bool IsFree(uint32_t ID) const;
+    bool IsReserved(uint32_t ID) const  { return mReserved.contains(ID); }
+
+    /** Returns the lowest free ID without claiming it, or skInvalidID if the area is full */
+    uint32_t FindFree() const           { return mFreeRanges.empty() ? skInvalidID : mFreeRanges.begin()->first; }
+};
+
+#endif // CINSTANCEIDALLOCATOR_H
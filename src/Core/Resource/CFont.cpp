@@ -1,13 +1,11 @@
 #include "Core/Resource/CFont.h"
 
-#include <Common/Math/CTransform4f.h>
+#include <Common/Hash/CFNV1A.h>
 #include "Core/OpenGL/CShader.h"
 #include "Core/Render/CDrawUtil.h"
 #include "Core/Render/CRenderer.h"
 
-std::optional<CDynamicVertexBuffer> CFont::smGlyphVertices;
-CIndexBuffer CFont::smGlyphIndices;
-bool CFont::smBuffersInitialized = false;
+#include <algorithm>
 
 CFont::CFont(CResourceEntry *pEntry) : CResource(pEntry)
 {
@@ -33,30 +31,91 @@ CVector2f CFont::RenderString(const TString& rkString, CRenderer* /*pRenderer*/,
                               CVector2f /*Position*/, CColor FillColor, CColor StrokeColor, uint32 FontSize)
 {
     // WIP
-    if (!smBuffersInitialized)
-        InitBuffers();
+    SStringLayout *pLayout = LayoutString(rkString, FontSize);
+
+    if (pLayout->Indices.GetSize() == 0 || CDrawUtil::IsPickPass())
+        return pLayout->EndPosition;
 
     // Shader setup
     CShader *pTextShader = CDrawUtil::GetTextShader();
     pTextShader->SetCurrent();
 
-    const GLuint ModelMtxLoc = pTextShader->GetUniformLocation("ModelMtx");
-    const GLuint ColorLoc = pTextShader->GetUniformLocation("FontColor");
-    const GLuint LayerLoc = pTextShader->GetUniformLocation("RGBALayer");
+    const GLuint FillColorLoc = pTextShader->GetUniformLocation("FillColor");
+    const GLuint StrokeColorLoc = pTextShader->GetUniformLocation("StrokeColor");
+    glUniform4fv(FillColorLoc, 1, &FillColor.R);
+    glUniform4fv(StrokeColorLoc, 1, &StrokeColor.R);
     mpFontTexture->Bind(0);
-    smGlyphVertices->Bind();
+
+    // Draw every glyph in the string at once
     glDisable(GL_DEPTH_TEST);
+    pLayout->Vertices.Bind();
+    pLayout->Indices.DrawElements();
+    glEnable(GL_DEPTH_TEST);
+
+    return pLayout->EndPosition;
+}
+
+CFont::SStringLayout* CFont::LayoutString(const TString& rkString, uint32_t FontSize)
+{
+    CFNV1A Hash(CFNV1A::EHashLength::k64Bit);
+    Hash.HashData(rkString.CString(), rkString.Size());
+    Hash.HashData(FontSize);
+    const uint64 Key = Hash.GetHash64();
+    mLayoutClock++;
+
+    const auto Iter = mLayoutCache.find(Key);
+    if (Iter != mLayoutCache.end() && Iter->second->FontSize == FontSize && Iter->second->String == rkString)
+    {
+        Iter->second->LastUsed = mLayoutClock;
+        return Iter->second.get();
+    }
+
+    // Evict the least recently used layout once the cache is full
+    if (Iter == mLayoutCache.end() && mLayoutCache.size() >= skMaxCachedLayouts)
+    {
+        const auto Oldest = std::min_element(mLayoutCache.begin(), mLayoutCache.end(), [](const auto& rkA, const auto& rkB) {
+            return rkA.second->LastUsed < rkB.second->LastUsed;
+        });
+        mLayoutCache.erase(Oldest);
+    }
+
+    auto pLayout = std::make_unique<SStringLayout>();
+    pLayout->String = rkString;
+    pLayout->FontSize = FontSize;
+    pLayout->LastUsed = mLayoutClock;
+    BuildLayout(*pLayout);
+
+    auto& rEntry = mLayoutCache[Key];
+    rEntry = std::move(pLayout);
+    return rEntry.get();
+}
 
+void CFont::BuildLayout(SStringLayout& rLayout) const
+{
     // Initialize some more stuff before we start the character loop
     CVector2f PrintHead(-1.f, 1.f);
-    const CTransform4f PtScale = CTransform4f::ScaleMatrix(PtsToFloat(1));
-    SGlyph *pPrevGlyph = nullptr;
+    const float PtScale = PtsToFloat(1);
+    const SGlyph *pPrevGlyph = nullptr;
 
     float Scale = 1.f;
-    if (FontSize != s_font_default_size)
-        Scale = static_cast<float>(FontSize) / (mDefaultSize != 0 ? mDefaultSize : 18);
+    if (rLayout.FontSize != s_font_default_size)
+        Scale = static_cast<float>(rLayout.FontSize) / (mDefaultSize != 0 ? mDefaultSize : 18);
+
+    const bool HasStroke = (mTextureFormat == 1 || mTextureFormat == 3 || mTextureFormat == 8);
+    const size_t VertsPerGlyph = HasStroke ? 8 : 4;
+
+    // Quad corners for each glyph, matching the order of SGlyph::TexCoords
+    static constexpr std::array QuadCorners{
+        CVector2f(0.f,  0.f),
+        CVector2f(2.f,  0.f),
+        CVector2f(0.f, -2.f),
+        CVector2f(2.f, -2.f)
+    };
 
-    for (const auto Char : rkString)
+    rLayout.Vertices.Reserve(rLayout.String.Size() * VertsPerGlyph);
+    rLayout.Indices.Reserve(rLayout.String.Size() * (HasStroke ? 12 : 6));
+
+    for (const auto Char : rLayout.String)
     {
         // Check for newline
         if (Char == '\n')
@@ -68,30 +127,20 @@ CVector2f CFont::RenderString(const TString& rkString, CRenderer* /*pRenderer*/,
         }
 
         // Get glyph
-        auto iGlyph = mGlyphs.find(Char);
+        const auto iGlyph = mGlyphs.find(Char);
         if (iGlyph == mGlyphs.end())
             continue;
-        SGlyph *pGlyph = &iGlyph->second;
+        const SGlyph *pGlyph = &iGlyph->second;
 
         // Apply left padding and kerning
         PrintHead.X += PtsToFloat(pGlyph->LeftPadding) * Scale;
 
         if (pPrevGlyph)
         {
-            if (pPrevGlyph->KerningIndex != UINT32_MAX)
-            {
-                for (size_t iKern = pPrevGlyph->KerningIndex; iKern < mKerningTable.size(); iKern++)
-                {
-                    if (mKerningTable[iKern].CharacterA != pPrevGlyph->Character)
-                        break;
-
-                    if (mKerningTable[iKern].CharacterB == Char)
-                    {
-                        PrintHead.X += PtsToFloat(mKerningTable[iKern].Adjust) * Scale;
-                        break;
-                    }
-                }
-            }
+            const auto iKern = mKerningPairs.find(KerningKey(pPrevGlyph->Character, Char));
+
+            if (iKern != mKerningPairs.end())
+                PrintHead.X += PtsToFloat(iKern->second) * Scale;
         }
 
         // Add a newline if this character goes over the right edge of the screen
@@ -104,13 +153,14 @@ CVector2f CFont::RenderString(const TString& rkString, CRenderer* /*pRenderer*/,
                 continue;
         }
 
+        // Index buffers are 16-bit; stop adding glyphs once the string would overflow them
+        if (rLayout.Vertices.Size() + VertsPerGlyph > 0xFFFF)
+            break;
+
         const float XTrans = PrintHead.X;
         const float YTrans = PrintHead.Y + ((PtsToFloat(pGlyph->BaseOffset * 2) - PtsToFloat(mVerticalOffset * 2)) * Scale);
-
-        CTransform4f GlyphTransform = PtScale;
-        GlyphTransform.Scale(CVector3f(static_cast<float>(pGlyph->Width) / 2, static_cast<float>(pGlyph->Height), 1.f));
-        GlyphTransform.Scale(Scale);
-        GlyphTransform.Translate(CVector3f(XTrans, YTrans, 0.f));
+        const float XScale = PtScale * (static_cast<float>(pGlyph->Width) / 2) * Scale;
+        const float YScale = PtScale * static_cast<float>(pGlyph->Height) * Scale;
 
         // Get glyph layer
         uint8 GlyphLayer = pGlyph->RGBAChannel;
@@ -119,29 +169,33 @@ CVector2f CFont::RenderString(const TString& rkString, CRenderer* /*pRenderer*/,
         else if (mTextureFormat == 8)
             GlyphLayer = 3;
 
-        // Load shader uniforms, buffer texture
-        glUniformMatrix4fv(ModelMtxLoc, 1, GL_FALSE, (GLfloat*) &GlyphTransform);
-        smGlyphVertices->BufferAttrib(EVertexAttribute::Tex0, pGlyph->TexCoords.data());
-
-        // Draw fill
-        glUniform1i(LayerLoc, GlyphLayer);
-        glUniform4fv(ColorLoc, 1, &FillColor.R);
-        smGlyphIndices.DrawElements();
+        uint8 StrokeLayer = 0;
+        if (mTextureFormat == 1)
+            StrokeLayer = 1;
+        else if (mTextureFormat == 3)
+            StrokeLayer = GlyphLayer + 1;
+        else if (mTextureFormat == 8)
+            StrokeLayer = GlyphLayer - 2;
 
-        // Draw stroke
-        if (mTextureFormat == 1 || mTextureFormat == 3 || mTextureFormat == 8)
+        // Emit the fill quad, then the stroke quad on top of it
+        for (size_t iPass = 0; iPass < (HasStroke ? 2 : 1); iPass++)
         {
-            uint8 StrokeLayer = 0;
-            if (mTextureFormat == 1)
-                StrokeLayer = 1;
-            else if (mTextureFormat == 3)
-                StrokeLayer = GlyphLayer + 1;
-            else if (mTextureFormat == 8)
-                StrokeLayer = GlyphLayer - 2;
-
-            glUniform1i(LayerLoc, StrokeLayer);
-            glUniform4fv(ColorLoc, 1, &StrokeColor.R);
-            smGlyphIndices.DrawElements();
+            const bool IsStroke = (iPass == 1);
+            const auto FirstVertex = static_cast<uint16>(rLayout.Vertices.Size());
+
+            for (size_t iCorner = 0; iCorner < QuadCorners.size(); iCorner++)
+            {
+                CVertex Vertex;
+                Vertex.Position = CVector3f((QuadCorners[iCorner].X * XScale) + XTrans, (QuadCorners[iCorner].Y * YScale) + YTrans, 0.f);
+                Vertex.Tex[0] = pGlyph->TexCoords[iCorner];
+                Vertex.Tex[1] = CVector2f(static_cast<float>(IsStroke ? StrokeLayer : GlyphLayer), IsStroke ? 1.f : 0.f);
+                rLayout.Vertices.AddVertex(Vertex);
+            }
+
+            rLayout.Indices.AddIndices({
+                static_cast<uint16>(FirstVertex + 0), static_cast<uint16>(FirstVertex + 2), static_cast<uint16>(FirstVertex + 1),
+                static_cast<uint16>(FirstVertex + 1), static_cast<uint16>(FirstVertex + 2), static_cast<uint16>(FirstVertex + 3)
+            });
         }
 
         // Update print head
@@ -150,43 +204,5 @@ CVector2f CFont::RenderString(const TString& rkString, CRenderer* /*pRenderer*/,
         pPrevGlyph = pGlyph;
     }
 
-    glEnable(GL_DEPTH_TEST);
-    return PrintHead;
-}
-
-void CFont::InitBuffers()
-{
-    smGlyphVertices.emplace();
-    smGlyphVertices->SetActiveAttribs(EVertexAttribute::Position | EVertexAttribute::Tex0);
-    smGlyphVertices->SetVertexCount(4);
-
-    static constexpr std::array Vertices{
-        CVector3f( 0.f,  0.f, 0.f),
-        CVector3f( 2.f,  0.f, 0.f),
-        CVector3f( 0.f, -2.f, 0.f),
-        CVector3f( 2.f, -2.f, 0.f)
-    };
-    smGlyphVertices->BufferAttrib(EVertexAttribute::Position, Vertices.data());
-
-    static constexpr std::array TexCoords{
-        CVector2f(0.f, 0.f),
-        CVector2f(1.f, 0.f),
-        CVector2f(0.f, 1.f),
-        CVector2f(1.f, 1.f)
-    };
-    smGlyphVertices->BufferAttrib(EVertexAttribute::Tex0, TexCoords.data());
-
-    smGlyphIndices.AddIndices({0, 2, 1, 3});
-    smGlyphIndices.SetPrimitiveType(GL_TRIANGLE_STRIP);
-
-    smBuffersInitialized = true;
-}
-
-void CFont::ShutdownBuffers()
-{
-    if (smBuffersInitialized)
-    {
-        smGlyphVertices = std::nullopt;
-        smBuffersInitialized = false;
-    }
+    rLayout.EndPosition = PrintHead;
 }
@@ -1,15 +1,15 @@
 #ifndef CFONT_H
 #define CFONT_H
 
-#include "Core/OpenGL/CDynamicVertexBuffer.h"
 #include "Core/OpenGL/CIndexBuffer.h"
+#include "Core/OpenGL/CVertexBuffer.h"
 #include "Core/Resource/CResource.h"
 #include "Core/Resource/CTexture.h"
 #include "Core/Resource/TResPtr.h"
 #include "Core/Resource/Model/CVertex.h"
 
 #include <array>
-#include <optional>
+#include <memory>
 #include <unordered_map>
 #include <vector>
 
@@ -22,9 +22,6 @@ class CFont : public CResource
     static constexpr uint32_t s_font_default_size = UINT32_MAX;
 
     friend class CFontLoader;
-    static std::optional<CDynamicVertexBuffer> smGlyphVertices; // This is the vertex buffer used to draw glyphs. It has two attributes - Pos and Tex0. Tex0 should be updated for each glyph.
-    static CIndexBuffer smGlyphIndices; // This is the index buffer used to draw glyphs. It uses a triangle strip.
-    static bool smBuffersInitialized;   // This bool indicates whether the vertex/index buffer have been initialized. Checked at the start of RenderString().
 
     uint32_t mUnknown = 0;              // Value at offset 0x8. Not sure what this is. Including for experimentation purposes.
     uint32_t mLineHeight = 0;           // Height of each line, in points
@@ -45,19 +42,37 @@ class CFont : public CResource
         uint32_t Height;                    // The height of the glyph, in points
         uint32_t PrintAdvance;              // How far the print head advances horizontally after printing this glyph, in points
         uint32_t BaseOffset;                // Vertical offset for this glyph, in points; the font-wide offset is added to this
-        uint32_t KerningIndex;              // Index into the kerning table of the first kerning pair for this glyph. -1 if no pairs.
         uint8_t RGBAChannel;                // Fonts can store multiple glyphs in the same space on different RGBA channels. This value corresponds to R, G, B, or A.
     };
     std::unordered_map<uint16_t, SGlyph> mGlyphs;
 
-    struct SKerningPair
+    // Kerning adjustments keyed by KerningKey(CharacterA, CharacterB). The value is the horizontal
+    // offset to apply to CharacterB when it follows CharacterA, in points.
+    std::unordered_map<uint32_t, int32_t> mKerningPairs;
+
+    // Laid out string geometry. Every glyph's fill and stroke quads are baked into one
+    // vertex/index buffer pair so the whole string can be drawn with a single call.
+    struct SStringLayout
     {
-        uint16_t CharacterA;  // Left character
-        uint16_t CharacterB;  // Right character
-        int32_t Adjust;       // The horizontal offset to apply to CharacterB if this pair is encountered, in points
+        TString String;
+        uint32_t FontSize = 0;
+        CVector2f EndPosition;      // Print head position after the last glyph
+        CVertexBuffer Vertices{EVertexAttribute::Position | EVertexAttribute::Tex0 | EVertexAttribute::Tex1};
+        CIndexBuffer Indices{GL_TRIANGLES};
+        uint32_t LastUsed = 0;
     };
-    std::vector<SKerningPair> mKerningTable; // The kerning table should be laid out in alphabetical order for the indices to work properly
+    std::unordered_map<uint64_t, std::unique_ptr<SStringLayout>> mLayoutCache;
+    uint32_t mLayoutClock = 0;
+
+    static constexpr size_t skMaxCachedLayouts = 64;
+
+    static constexpr uint32_t KerningKey(uint16_t CharacterA, uint16_t CharacterB)
+    {
+        return (static_cast<uint32_t>(CharacterA) << 16) | CharacterB;
+    }
 
+    SStringLayout* LayoutString(const TString& rkString, uint32_t FontSize);
+    void BuildLayout(SStringLayout& rLayout) const;
 
 public:
     explicit CFont(CResourceEntry *pEntry = nullptr);
@@ -71,9 +86,6 @@ public:
     // Accessors
     const TString& FontName() const { return mFontName; }
     CTexture* Texture() const       { return mpFontTexture; }
-private:
-    static void InitBuffers();
-    static void ShutdownBuffers();
 };
 
 #endif // CFONT_H
@@ -70,7 +70,10 @@ void CMaterial::GenerateShader(bool AllowRegen /*= true*/)
             SMaterialShader& rShader = Find->second;
 
             if (rShader.pShader == mpShader)
+            {
+                UpdateShaderStatus();
                 return;
+            }
 
             ClearShader();
             mpShader = rShader.pShader;
@@ -78,21 +81,14 @@ void CMaterial::GenerateShader(bool AllowRegen /*= true*/)
         }
         else
         {
+            // The program may still be compiling when this returns. Failed programs stay in the
+            // map too, so other materials with the same setup don't retry the compile.
             ClearShader();
-            mpShader = CShaderGenerator::GenerateShader(*this);
-
-            if (!mpShader->IsValidProgram())
-            {
-                mShaderStatus = EShaderStatus::ShaderFailed;
-                delete mpShader;
-                mpShader = nullptr;
-            }
-            else
-            {
-                mShaderStatus = EShaderStatus::ShaderExists;
-                smShaderMap[mParametersHash] = SMaterialShader { 1, mpShader };
-            }
+            mpShader = CShaderGenerator::GenerateShaderAsync(*this);
+            smShaderMap[mParametersHash] = SMaterialShader { 1, mpShader };
         }
+
+        UpdateShaderStatus();
     }
 }
 
@@ -111,6 +107,7 @@ void CMaterial::ClearShader()
 
     if (rShader.NumReferences == 0)
     {
+        CShaderGenerator::CancelPendingShader(mpShader);
         delete mpShader;
         smShaderMap.erase(Find);
     }
@@ -119,19 +116,48 @@ void CMaterial::ClearShader()
     mShaderStatus = EShaderStatus::NoShader;
 }
 
+void CMaterial::UpdateShaderStatus()
+{
+    if (mpShader == nullptr)
+        mShaderStatus = EShaderStatus::NoShader;
+    else if (mpShader->IsCompilePending())
+        mShaderStatus = EShaderStatus::ShaderPending;
+    else if (mpShader->IsValidProgram())
+        mShaderStatus = EShaderStatus::ShaderExists;
+    else
+        mShaderStatus = EShaderStatus::ShaderFailed;
+}
+
 bool CMaterial::SetCurrent(FRenderOptions Options)
 {
+    // ID pass only needs coverage and depth
+    if (CDrawUtil::IsPickPass())
+    {
+        CDrawUtil::UsePickShader();
+        return true;
+    }
+
     // Skip material setup if the currently bound material is identical
     if (sCurrentMaterial != HashParameters())
     {
         // Shader setup
         if (mShaderStatus == EShaderStatus::NoShader)
             GenerateShader();
-        mpShader->SetCurrent();
+        else if (mShaderStatus == EShaderStatus::ShaderPending)
+            UpdateShaderStatus();
 
         if (mShaderStatus == EShaderStatus::ShaderFailed)
             return false;
 
+        // Don't stall the frame waiting on the compiler; draw with a stand-in until the program is ready
+        if (mShaderStatus == EShaderStatus::ShaderPending)
+        {
+            SetFallbackCurrent(Options);
+            return true;
+        }
+
+        mpShader->SetCurrent();
+
         // Set RGB blend equation - force to ZERO/ONE if alpha is disabled
         GLenum srcRGB, dstRGB, srcAlpha, dstAlpha;
 
@@ -211,6 +237,25 @@ bool CMaterial::SetCurrent(FRenderOptions Options)
     return true;
 }
 
+void CMaterial::SetFallbackCurrent(FRenderOptions Options)
+{
+    CDrawUtil::UseColorShaderLighting(CColor::Gray());
+
+    if (Options.HasFlag(ERenderOption::NoAlpha))
+        glBlendFuncSeparate(GL_ONE, GL_ZERO, mBlendSrcFac, mBlendDstFac);
+    else
+        glBlendFuncSeparate(mBlendSrcFac, mBlendDstFac, mBlendSrcFac, mBlendDstFac);
+
+    if (mOptions.HasFlag(EMaterialOption::DepthWrite) || Options.HasFlag(ERenderOption::NoAlpha))
+        glDepthMask(GL_TRUE);
+    else
+        glDepthMask(GL_FALSE);
+
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+    CGraphics::UpdateVertexBlock();
+    CGraphics::UpdatePixelBlock();
+}
+
 uint64 CMaterial::HashParameters()
 {
     if (mRecalcHash)
@@ -262,3 +307,8 @@ void CMaterial::SetNumPasses(size_t NumPasses)
 
     mRecalcHash = true;
 }
+
+void CMaterial::ProcessPendingShaders()
+{
+    CShaderGenerator::ProcessPendingShaders();
+}
@@ -64,7 +64,7 @@ class CMaterial
 public:
     enum class EShaderStatus
     {
-        NoShader, ShaderExists, ShaderFailed
+        NoShader, ShaderPending, ShaderExists, ShaderFailed
     };
 
 private:
@@ -119,8 +119,10 @@ public:
     std::unique_ptr<CMaterial> Clone() const;
     void GenerateShader(bool AllowRegen = true);
     void ClearShader();
+    void UpdateShaderStatus();
     bool SetCurrent(FRenderOptions Options);
     uint64_t HashParameters();
+    uint64_t ParametersHash() const { return mParametersHash; }
     void Update();
     void SetNumPasses(size_t NumPasses);
 
@@ -153,6 +155,10 @@ public:
 
     // Static
     static void KillCachedMaterial() { sCurrentMaterial = 0; }
+    static void ProcessPendingShaders();
+
+private:
+    void SetFallbackCurrent(FRenderOptions Options);
 };
 
 #endif // MATERIAL_H
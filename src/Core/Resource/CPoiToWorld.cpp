@@ -1,5 +1,7 @@
 #include "CPoiToWorld.h"
 
+#include <algorithm>
+
 CPoiToWorld::CPoiToWorld(CResourceEntry *pEntry)
     : CResource(pEntry)
 {
@@ -10,46 +12,50 @@ CPoiToWorld::~CPoiToWorld() = default;
 void CPoiToWorld::AddPoi(CInstanceID PoiID)
 {
     // Check if this POI already exists
-    const auto it = mPoiLookupMap.find(PoiID);
+    const auto [it, Inserted] = mPoiLookupMap.try_emplace(PoiID, static_cast<uint32_t>(mMaps.size()));
 
-    if (it != mPoiLookupMap.end())
+    if (!Inserted)
         return;
 
-    auto pMap = std::make_unique<SPoiMap>();
-    pMap->PoiID = PoiID;
-
-    auto* ptr = mMaps.emplace_back(std::move(pMap)).get();
-    mPoiLookupMap.insert_or_assign(PoiID, ptr);
+    SPoiMap& rMap = mMaps.emplace_back();
+    rMap.PoiID = PoiID;
 }
 
 void CPoiToWorld::AddPoiMeshMap(CInstanceID PoiID, uint32 ModelID)
 {
     // Make sure the POI exists; the add function won't do anything if it does
     AddPoi(PoiID);
-    SPoiMap *pMap = mPoiLookupMap[PoiID];
+    SPoiMap& rMap = mMaps[mPoiLookupMap[PoiID]];
 
     // Check whether this model ID is already mapped to this POI
-    for (const auto id : pMap->ModelIDs)
-    {
-        if (id == ModelID)
-            return;
-    }
+    const auto ModelIt = std::ranges::lower_bound(rMap.ModelIDs, ModelID);
 
-    // We didn't return, so this is a new mapping
-    pMap->ModelIDs.push_back(ModelID);
+    if (ModelIt != rMap.ModelIDs.end() && *ModelIt == ModelID)
+        return;
+
+    // This is a new mapping
+    rMap.ModelIDs.insert(ModelIt, ModelID);
+    mModelLookupMap[ModelID].push_back(PoiID);
 }
 
 void CPoiToWorld::RemovePoi(CInstanceID PoiID)
 {
-    for (auto it = mMaps.begin(); it != mMaps.end(); ++it)
-    {
-        if ((*it)->PoiID == PoiID)
-        {
-            mMaps.erase(it);
-            mPoiLookupMap.erase(PoiID);
-            return;
-        }
-    }
+    const auto MapIt = mPoiLookupMap.find(PoiID);
+
+    if (MapIt == mPoiLookupMap.end())
+        return;
+
+    const uint32_t MapIndex = MapIt->second;
+    mPoiLookupMap.erase(MapIt);
+
+    for (const uint32_t ModelID : mMaps[MapIndex].ModelIDs)
+        RemoveModelLookup(ModelID, PoiID);
+
+    // Maps are kept in their original order, so shift down the indices of the ones that follow
+    mMaps.erase(mMaps.begin() + MapIndex);
+
+    for (uint32_t Index = MapIndex; Index < mMaps.size(); Index++)
+        mPoiLookupMap[mMaps[Index].PoiID] = Index;
 }
 
 void CPoiToWorld::RemovePoiMeshMap(CInstanceID PoiID, uint32 ModelID)
@@ -59,14 +65,31 @@ void CPoiToWorld::RemovePoiMeshMap(CInstanceID PoiID, uint32 ModelID)
     if (MapIt == mPoiLookupMap.end())
         return;
 
-    SPoiMap *pMap = MapIt->second;
+    SPoiMap& rMap = mMaps[MapIt->second];
+    const auto ModelIt = std::ranges::lower_bound(rMap.ModelIDs, ModelID);
 
-    for (auto ListIt = pMap->ModelIDs.begin(); ListIt != pMap->ModelIDs.end(); ++ListIt)
+    if (ModelIt != rMap.ModelIDs.end() && *ModelIt == ModelID)
     {
-        if (*ListIt == ModelID)
-        {
-            pMap->ModelIDs.erase(ListIt);
-            break;
-        }
+        rMap.ModelIDs.erase(ModelIt);
+        RemoveModelLookup(ModelID, PoiID);
     }
 }
+
+bool CPoiToWorld::HasPoiMeshMap(CInstanceID PoiID, uint32_t ModelID) const
+{
+    const SPoiMap* pkMap = MapByID(PoiID);
+    return pkMap != nullptr && std::ranges::binary_search(pkMap->ModelIDs, ModelID);
+}
+
+void CPoiToWorld::RemoveModelLookup(uint32_t ModelID, CInstanceID PoiID)
+{
+    const auto It = mModelLookupMap.find(ModelID);
+
+    if (It == mModelLookupMap.end())
+        return;
+
+    std::erase(It->second, PoiID);
+
+    if (It->second.empty())
+        mModelLookupMap.erase(It);
+}
@@ -4,9 +4,8 @@
 #include "Core/Resource/CResource.h"
 #include "Core/Resource/Script/CInstanceID.h"
 #include <cstdint>
-#include <list>
-#include <map>
-#include <memory>
+#include <span>
+#include <unordered_map>
 #include <vector>
 
 class CPoiToWorld : public CResource
@@ -17,12 +16,15 @@ public:
     struct SPoiMap
     {
         CInstanceID PoiID;
-        std::list<uint32_t> ModelIDs;
+        std::vector<uint32_t> ModelIDs; // Kept sorted
     };
 
 private:
-    std::vector<std::unique_ptr<SPoiMap>> mMaps;
-    std::map<CInstanceID, SPoiMap*> mPoiLookupMap;
+    std::vector<SPoiMap> mMaps;
+    std::unordered_map<CInstanceID, uint32_t> mPoiLookupMap;          // POI ID -> index in mMaps
+    std::unordered_map<uint32_t, std::vector<CInstanceID>> mModelLookupMap; // Model ID -> POIs mapped to it
+
+    void RemoveModelLookup(uint32_t ModelID, CInstanceID PoiID);
 
 public:
     explicit CPoiToWorld(CResourceEntry *pEntry = nullptr);
@@ -32,6 +34,7 @@ public:
     void AddPoiMeshMap(CInstanceID PoiID, uint32_t ModelID);
     void RemovePoi(CInstanceID PoiID);
     void RemovePoiMeshMap(CInstanceID PoiID, uint32_t ModelID);
+    bool HasPoiMeshMap(CInstanceID PoiID, uint32_t ModelID) const;
 
     size_t NumMappedPOIs() const
     {
@@ -40,7 +43,7 @@ public:
 
     const SPoiMap* MapByIndex(size_t Index) const
     {
-        return mMaps[Index].get();
+        return &mMaps[Index];
     }
 
     const SPoiMap* MapByID(CInstanceID InstanceID) const
@@ -49,13 +52,35 @@ public:
         if (it == mPoiLookupMap.end())
             return nullptr;
 
-        return it->second;
+        return &mMaps[it->second];
+    }
+
+    /** Returns the index of the given POI's map, or UINT32_MAX if it has none */
+    uint32_t MapIndexByID(CInstanceID InstanceID) const
+    {
+        auto it = mPoiLookupMap.find(InstanceID);
+        return it == mPoiLookupMap.end() ? UINT32_MAX : it->second;
     }
 
     bool HasPoiMappings(CInstanceID InstanceID) const
     {
         return mPoiLookupMap.contains(InstanceID);
     }
+
+    /** Returns every POI that controls the visibility of the given model */
+    std::span<const CInstanceID> PoisForModel(uint32_t ModelID) const
+    {
+        auto it = mModelLookupMap.find(ModelID);
+        if (it == mModelLookupMap.end())
+            return {};
+
+        return it->second;
+    }
+
+    bool IsModelMapped(uint32_t ModelID) const
+    {
+        return mModelLookupMap.contains(ModelID);
+    }
 };
 
 #endif // CPOITOWORLD_H
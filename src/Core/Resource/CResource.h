@@ -12,6 +12,24 @@
 
 class IArchive;
 
+/** Approximate memory held by loaded resources */
+struct SResourceMemoryUsage
+{
+    size_t NumResources = 0;
+    size_t CPUBytes = 0;
+    size_t GPUBytes = 0;
+
+    size_t TotalBytes() const { return CPUBytes + GPUBytes; }
+
+    SResourceMemoryUsage& operator+=(const SResourceMemoryUsage& rkOther)
+    {
+        NumResources += rkOther.NumResources;
+        CPUBytes += rkOther.CPUBytes;
+        GPUBytes += rkOther.GPUBytes;
+        return *this;
+    }
+};
+
 // This macro creates functions that allow us to easily identify this resource type.
 // Must be included on every CResource subclass.
 #define DECLARE_RESOURCE_TYPE(ResourceTypeEnum) \
@@ -46,6 +64,9 @@ public:
     virtual void Serialize(IArchive& /*rArc*/) {}
     virtual void InitializeNewResource()       {}
 
+    // Memory owned by this resource, not counting dependencies. Types that don't override this only report their count.
+    virtual SResourceMemoryUsage MemoryUsage() const { return {.NumResources = 1}; }
+
     CResourceEntry* Entry() const    { return mpEntry; }
     CResTypeInfo* TypeInfo() const   { return mpEntry->TypeInfo(); }
     EResourceType Type() const       { return mpEntry->TypeInfo()->Type(); }
@@ -23,6 +23,18 @@ CTexture::~CTexture()
     DeleteBuffers();
 }
 
+SResourceMemoryUsage CTexture::MemoryUsage() const
+{
+    SResourceMemoryUsage Usage{.NumResources = 1};
+    Usage.CPUBytes = (mBufferExists ? mImgDataSize : 0);
+
+    // Multisampled render targets are created with 4 samples
+    if (mGLBufferExists)
+        Usage.GPUBytes = static_cast<size_t>(CalcTotalSize()) * (mEnableMultisampling ? 4 : 1);
+
+    return Usage;
+}
+
 bool CTexture::BufferGL()
 {
     const GLenum BindTarget = (mEnableMultisampling ? GL_TEXTURE_2D_MULTISAMPLE : GL_TEXTURE_2D);
@@ -36,6 +36,7 @@ public:
     explicit CTexture(uint32_t Width, uint32_t Height);
     ~CTexture() override;
 
+    SResourceMemoryUsage MemoryUsage() const override;
     bool BufferGL();
     void Bind(uint32_t GLTextureUnit);
     void Resize(uint32_t Width, uint32_t Height);
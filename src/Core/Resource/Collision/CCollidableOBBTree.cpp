@@ -1,14 +1,78 @@
 #include "CCollidableOBBTree.h"
+#include "Core/Resource/CResource.h"
+#include <Common/Math/MathUtil.h>
 
 void CCollidableOBBTree::BuildRenderData()
 {
     if (!mRenderData.IsBuilt())
     {
         mRenderData.BuildRenderData(mIndexData);
-        mRenderData.BuildBoundingHierarchyRenderData(mpOBBTree.get());
+        mRenderData.BuildBoundingHierarchyRenderData(mOBBNodes);
     }
 }
 
-void CCollidableOBBTree::BuildOBBTree()
+void CCollidableOBBTree::AddMemoryUsage(SResourceMemoryUsage& rUsage) const
 {
+    CCollisionMesh::AddMemoryUsage(rUsage);
+    rUsage.CPUBytes += mOBBNodes.capacity() * sizeof(SOBBTreeNode) + mLeafTriangles.capacity() * sizeof(uint16_t);
+}
+
+std::pair<bool, float> CCollidableOBBTree::IntersectsRay(const CRay& rkRay, bool AllowBackfaces, const std::vector<bool>& rkHiddenMaterials) const
+{
+    if (mOBBNodes.empty())
+        return CCollisionMesh::IntersectsRay(rkRay, AllowBackfaces, rkHiddenMaterials);
+
+    bool Hit = false;
+    float HitDist = 0.0f;
+    const size_t NumTris = NumTriangles();
+
+    std::vector<uint32_t> NodeStack;
+    NodeStack.reserve(64);
+    NodeStack.push_back(0);
+
+    while (!NodeStack.empty())
+    {
+        const SOBBTreeNode& rkNode = mOBBNodes[NodeStack.back()];
+        NodeStack.pop_back();
+
+        // Test the ray against the box in its local space
+        const CRay LocalRay = rkRay.Transformed(rkNode.InverseTransform);
+        const auto [BoxHit, BoxDist] = Math::RayBoxIntersection(LocalRay, CAABox(-rkNode.Radii, rkNode.Radii));
+
+        if (!BoxHit)
+            continue;
+
+        // Skip boxes that start further away than the closest triangle found so far
+        if (Hit && BoxDist > 0.0f)
+        {
+            const CVector3f BoxEntry = rkNode.Transform * LocalRay.PointOnRay(BoxDist);
+
+            if (Math::Distance(rkRay.Origin(), BoxEntry) > HitDist)
+                continue;
+        }
+
+        if (rkNode.NodeType == EOBBTreeNodeType::Branch)
+        {
+            // Push the right child first so the left subtree is visited first, in memory order
+            NodeStack.push_back(rkNode.RightChild);
+            NodeStack.push_back(static_cast<uint32_t>(&rkNode - mOBBNodes.data()) + 1);
+            continue;
+        }
+
+        for (const uint16_t TriIdx : LeafTriangles(rkNode))
+        {
+            if (TriIdx >= NumTris || IsTriangleHidden(TriIdx, rkHiddenMaterials))
+                continue;
+
+            const auto [TriHit, TriDist] = IntersectsTriangle(rkRay, TriIdx, AllowBackfaces);
+
+            if (TriHit && (!Hit || TriDist < HitDist))
+            {
+                Hit = true;
+                HitDist = TriDist;
+            }
+        }
+    }
+
+    return {Hit, HitDist};
 }
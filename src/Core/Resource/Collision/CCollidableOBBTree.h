@@ -4,23 +4,34 @@
 #include "Core/Resource/Collision/CCollisionMesh.h"
 #include "Core/Resource/Collision/SOBBTreeNode.h"
 
-#include <memory>
+#include <span>
+#include <vector>
 
 /** A collision mesh with an OBB tree for spatial queries. Represents one mesh from a DCLN file */
 class CCollidableOBBTree : public CCollisionMesh
 {
     friend class CCollisionLoader;
-    std::unique_ptr<SOBBTreeNode> mpOBBTree;
+
+    /** Tree nodes in depth-first order; the root is node 0 */
+    std::vector<SOBBTreeNode> mOBBNodes;
+
+    /** Triangle indices referenced by leaf nodes, stored contiguously per leaf */
+    std::vector<uint16_t> mLeafTriangles;
 
 public:
     void BuildRenderData() override;
-
-    void BuildOBBTree();
+    void AddMemoryUsage(SResourceMemoryUsage& rUsage) const override;
+    std::pair<bool, float> IntersectsRay(const CRay& rkRay, bool AllowBackfaces, const std::vector<bool>& rkHiddenMaterials = {}) const override;
 
     /** Accessors */
-    SOBBTreeNode* GetOBBTree() const
+    std::span<const SOBBTreeNode> GetOBBTree() const
+    {
+        return mOBBNodes;
+    }
+
+    std::span<const uint16_t> LeafTriangles(const SOBBTreeNode& rkLeaf) const
     {
-        return mpOBBTree.get();
+        return std::span(mLeafTriangles).subspan(rkLeaf.FirstTriangle, rkLeaf.NumTriangles);
     }
 };
 
@@ -1,4 +1,6 @@
 #include "CCollisionMesh.h"
+#include "Core/Resource/CResource.h"
+#include <Common/Math/MathUtil.h>
 
 void CCollisionMesh::BuildRenderData()
 {
@@ -7,3 +9,70 @@ void CCollisionMesh::BuildRenderData()
         mRenderData.BuildRenderData(mIndexData);
     }
 }
+
+void CCollisionMesh::AddMemoryUsage(SResourceMemoryUsage& rUsage) const
+{
+    rUsage.CPUBytes += mIndexData.Materials.capacity() * sizeof(CCollisionMaterial) +
+                       mIndexData.VertexMaterialIndices.capacity() +
+                       mIndexData.EdgeMaterialIndices.capacity() +
+                       mIndexData.TriangleMaterialIndices.capacity() +
+                       (mIndexData.EdgeIndices.capacity() + mIndexData.TriangleIndices.capacity() +
+                        mIndexData.UnknownData.capacity()) * sizeof(uint16_t) +
+                       mIndexData.Vertices.capacity() * sizeof(CVector3f);
+
+    mRenderData.AddMemoryUsage(rUsage);
+}
+
+std::pair<bool, float> CCollisionMesh::IntersectsRay(const CRay& rkRay, bool AllowBackfaces, const std::vector<bool>& rkHiddenMaterials) const
+{
+    // No spatial structure available; test every triangle
+    bool Hit = false;
+    float HitDist = 0.0f;
+
+    for (size_t TriIdx = 0; TriIdx < NumTriangles(); TriIdx++)
+    {
+        if (IsTriangleHidden(TriIdx, rkHiddenMaterials))
+            continue;
+
+        const auto [intersects, distance] = IntersectsTriangle(rkRay, TriIdx, AllowBackfaces);
+
+        if (intersects && (!Hit || distance < HitDist))
+        {
+            Hit = true;
+            HitDist = distance;
+        }
+    }
+
+    return {Hit, HitDist};
+}
+
+void CCollisionMesh::TriangleVertexIndices(size_t TriIdx, uint16_t& rOutA, uint16_t& rOutB, uint16_t& rOutC) const
+{
+    const size_t LineA = mIndexData.TriangleIndices[(TriIdx * 3) + 0];
+    const size_t LineB = mIndexData.TriangleIndices[(TriIdx * 3) + 1];
+    const uint16_t LineAVertA = mIndexData.EdgeIndices[(LineA * 2) + 0];
+    const uint16_t LineAVertB = mIndexData.EdgeIndices[(LineA * 2) + 1];
+    const uint16_t LineBVertA = mIndexData.EdgeIndices[(LineB * 2) + 0];
+    const uint16_t LineBVertB = mIndexData.EdgeIndices[(LineB * 2) + 1];
+    rOutA = LineAVertA;
+    rOutB = LineAVertB;
+    rOutC = (LineBVertA != LineAVertA && LineBVertA != LineAVertB ? LineBVertA : LineBVertB);
+
+    // Reverse vertex order if material indicates tri is flipped
+    const uint8_t MaterialIdx = mIndexData.TriangleMaterialIndices[TriIdx];
+
+    if (mIndexData.Materials[MaterialIdx].HasFlag(eCF_FlippedTri))
+        std::swap(rOutA, rOutC);
+}
+
+std::pair<bool, float> CCollisionMesh::IntersectsTriangle(const CRay& rkRay, size_t TriIdx, bool AllowBackfaces) const
+{
+    uint16_t VertA, VertB, VertC;
+    TriangleVertexIndices(TriIdx, VertA, VertB, VertC);
+
+    return Math::RayTriangleIntersection(rkRay,
+                                         mIndexData.Vertices[VertA],
+                                         mIndexData.Vertices[VertB],
+                                         mIndexData.Vertices[VertC],
+                                         AllowBackfaces);
+}
@@ -4,6 +4,13 @@
 #include "Core/Resource/Collision/CCollisionRenderData.h"
 #include "Core/Resource/Collision/SCollisionIndexData.h"
 #include <Common/Math/CAABox.h>
+#include <Common/Math/CRay.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+struct SResourceMemoryUsage;
 
 /** Base class of collision geometry */
 class CCollisionMesh
@@ -15,9 +22,38 @@ protected:
     SCollisionIndexData     mIndexData;
     CCollisionRenderData    mRenderData;
 
+    /** Intersect a ray with a single triangle, in mesh space */
+    std::pair<bool, float> IntersectsTriangle(const CRay& rkRay, size_t TriIdx, bool AllowBackfaces) const;
+
+    /** Whether a triangle's material is flagged in a per-material hidden list */
+    bool IsTriangleHidden(size_t TriIdx, const std::vector<bool>& rkHiddenMaterials) const
+    {
+        if (rkHiddenMaterials.empty())
+            return false;
+
+        const uint8_t MaterialIdx = mIndexData.TriangleMaterialIndices[TriIdx];
+        return MaterialIdx < rkHiddenMaterials.size() && rkHiddenMaterials[MaterialIdx];
+    }
+
 public:
     virtual ~CCollisionMesh() = default;
     virtual void BuildRenderData();
+    virtual void AddMemoryUsage(SResourceMemoryUsage& rUsage) const;
+
+    /**
+     * Intersect a ray with the mesh, in mesh space. Returns the distance to the closest hit.
+     * Triangles whose material index is set in rkHiddenMaterials are skipped; an empty list hides nothing.
+     */
+    virtual std::pair<bool, float> IntersectsRay(const CRay& rkRay, bool AllowBackfaces, const std::vector<bool>& rkHiddenMaterials = {}) const;
+
+    /** Resolve the vertex indices of a triangle from its edges, in winding order */
+    void TriangleVertexIndices(size_t TriIdx, uint16_t& rOutA, uint16_t& rOutB, uint16_t& rOutC) const;
+
+    size_t NumTriangles() const
+    {
+        // Apparently some collision meshes have more triangle indices than actual triangles
+        return std::min(mIndexData.TriangleIndices.size() / 3, mIndexData.TriangleMaterialIndices.size());
+    }
 
     /** Accessors */
     const CAABox& Bounds() const
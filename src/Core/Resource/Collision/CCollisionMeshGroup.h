@@ -20,6 +20,16 @@ public:
     std::span<const std::unique_ptr<CCollisionMesh>> Meshes() const { return mMeshes; }
     void AddMesh(std::unique_ptr<CCollisionMesh>&& pMesh) { mMeshes.push_back(std::move(pMesh)); }
 
+    SResourceMemoryUsage MemoryUsage() const override
+    {
+        SResourceMemoryUsage Usage{.NumResources = 1};
+
+        for (const auto& mesh : mMeshes)
+            mesh->AddMemoryUsage(Usage);
+
+        return Usage;
+    }
+
     void BuildRenderData()
     {
         for (auto& mesh : mMeshes)
@@ -1,5 +1,6 @@
 #include "CCollisionRenderData.h"
 #include <Core/Render/CDrawUtil.h>
+#include <Core/Resource/CResource.h>
 
 #include <algorithm>
 #include <array>
@@ -111,7 +112,7 @@ void CCollisionRenderData::BuildRenderData(const SCollisionIndexData& kIndexData
     mBuilt = true;
 }
 
-void CCollisionRenderData::BuildBoundingHierarchyRenderData(const SOBBTreeNode* pOBBTree)
+void CCollisionRenderData::BuildBoundingHierarchyRenderData(std::span<const SOBBTreeNode> OBBTree)
 {
     if (mBoundingHierarchyBuilt)
     {
@@ -121,14 +122,20 @@ void CCollisionRenderData::BuildBoundingHierarchyRenderData(const SOBBTreeNode*
         mBoundingHierarchyBuilt = false;
     }
 
+    if (OBBTree.empty())
+        return;
+
     mBoundingIndexBuffer.SetPrimitiveType(GL_LINES);
+    mBoundingVertexBuffer.Reserve(8 * OBBTree.size());
+    mBoundingIndexBuffer.Reserve(24 * OBBTree.size());
 
     // Iterate through the OBB tree, building a list of nodes as we go.
     // We iterate through this using a breadth-first traversal in order to group together
     // OBBs in the same depth level in the index buffer. This allows us to render a
     // subset of the bounding hierarchy based on a max depth level.
-    std::vector<const SOBBTreeNode*> TreeNodes;
-    TreeNodes.push_back(pOBBTree);
+    std::vector<uint32_t> TreeNodes;
+    TreeNodes.reserve(OBBTree.size());
+    TreeNodes.push_back(0);
     size_t NodeIdx = 0;
 
     while (NodeIdx < TreeNodes.size())
@@ -137,19 +144,16 @@ void CCollisionRenderData::BuildBoundingHierarchyRenderData(const SOBBTreeNode*
         mBoundingDepthOffsets.push_back(mBoundingIndexBuffer.GetSize());
         const size_t DepthLevel = TreeNodes.size();
 
-        mBoundingVertexBuffer.Reserve(8 * (DepthLevel - NodeIdx));
-        mBoundingIndexBuffer.Reserve(24 * (DepthLevel - NodeIdx));
-
         for (; NodeIdx < DepthLevel; NodeIdx++)
         {
-            const SOBBTreeNode* pkNode = TreeNodes[NodeIdx];
+            const uint32_t NodeIndex = TreeNodes[NodeIdx];
+            const SOBBTreeNode* pkNode = &OBBTree[NodeIndex];
 
-            // Append children
+            // Append children; the left child directly follows its parent
             if (pkNode->NodeType == EOBBTreeNodeType::Branch)
             {
-                const auto* pkBranch = static_cast<const SOBBTreeBranch*>(pkNode);
-                TreeNodes.push_back(pkBranch->pLeft.get());
-                TreeNodes.push_back(pkBranch->pRight.get());
+                TreeNodes.push_back(NodeIndex + 1);
+                TreeNodes.push_back(pkNode->RightChild);
             }
 
             // Create a new transform with the radii combined in as a scale matrie
@@ -257,3 +261,21 @@ int CCollisionRenderData::MaxBoundingHierarchyDepth() const
 {
     return mBoundingHierarchyBuilt ? mBoundingDepthOffsets.size()-1 : 0;
 }
+
+void CCollisionRenderData::AddMemoryUsage(SResourceMemoryUsage& rUsage) const
+{
+    for (const CVertexBuffer* pVBO : {&mVertexBuffer, &mBoundingVertexBuffer})
+    {
+        rUsage.CPUBytes += pVBO->ClientMemoryUsage();
+        rUsage.GPUBytes += pVBO->GPUMemoryUsage();
+    }
+
+    for (const CIndexBuffer* pIBO : {&mIndexBuffer, &mWireframeIndexBuffer, &mBoundingIndexBuffer})
+    {
+        rUsage.CPUBytes += pIBO->ClientMemoryUsage();
+        rUsage.GPUBytes += pIBO->GPUMemoryUsage();
+    }
+
+    rUsage.CPUBytes += (mMaterialIndexOffsets.capacity() + mMaterialWireIndexOffsets.capacity() +
+                        mBoundingDepthOffsets.capacity()) * sizeof(uint32_t);
+}
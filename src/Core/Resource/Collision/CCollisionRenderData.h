@@ -6,9 +6,11 @@
 #include "Core/Resource/Collision/SCollisionIndexData.h"
 #include "Core/Resource/Collision/SOBBTreeNode.h"
 
+#include <span>
 #include <vector>
 
 class CCollidableOBBTree;
+struct SResourceMemoryUsage;
 
 /** Data for rendering a collision model */
 class CCollisionRenderData
@@ -42,12 +44,13 @@ public:
 
     /** Build from collision data */
     void BuildRenderData(const SCollisionIndexData& kIndexData);
-    void BuildBoundingHierarchyRenderData(const SOBBTreeNode* pOBBTree);
+    void BuildBoundingHierarchyRenderData(std::span<const SOBBTreeNode> OBBTree);
 
     /** Render */
     void Render(bool Wireframe, int MaterialIndex = -1);
     void RenderBoundingHierarchy(int MaxDepthLevel = -1);
     int MaxBoundingHierarchyDepth() const;
+    void AddMemoryUsage(SResourceMemoryUsage& rUsage) const;
 
     /** Accessors */
     bool IsBuilt() const { return mBuilt; }
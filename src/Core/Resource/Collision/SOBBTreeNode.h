@@ -4,8 +4,6 @@
 #include <Common/Math/CTransform4f.h>
 #include <Common/Math/CVector3f.h>
 #include <cstdint>
-#include <memory>
-#include <vector>
 
 enum class EOBBTreeNodeType : uint8_t
 {
@@ -13,33 +11,21 @@ enum class EOBBTreeNodeType : uint8_t
     Leaf = 1
 };
 
+/** One node of a flattened OBB tree. Nodes are stored depth-first, so the left
+ *  child of a branch always immediately follows it in the node array. */
 struct SOBBTreeNode
 {
-    virtual ~SOBBTreeNode() = default;
     CTransform4f        Transform;
+    CTransform4f        InverseTransform;
     CVector3f           Radii;
-    EOBBTreeNodeType    NodeType;
-};
-
-struct SOBBTreeBranch : public SOBBTreeNode
-{
-    std::unique_ptr<SOBBTreeNode> pLeft;
-    std::unique_ptr<SOBBTreeNode> pRight;
+    EOBBTreeNodeType    NodeType = EOBBTreeNodeType::Leaf;
 
-    SOBBTreeBranch() : SOBBTreeNode()
-    {
-        NodeType = EOBBTreeNodeType::Branch;
-    }
-};
-
-struct SOBBTreeLeaf : public SOBBTreeNode
-{
-    std::vector<uint16_t> TriangleIndices;
+    /** Branches: index of the right child. */
+    uint32_t            RightChild = 0;
 
-    SOBBTreeLeaf() : SOBBTreeNode()
-    {
-        NodeType = EOBBTreeNodeType::Leaf;
-    }
+    /** Leaves: range of this node's triangles in the tree's leaf triangle list. */
+    uint32_t            FirstTriangle = 0;
+    uint32_t            NumTriangles = 0;
 };
 
 #endif // SOBBTREENODE_H
@@ -1,9 +1,11 @@
 #include "Core/Resource/Cooker/CAreaCooker.h"
 
 #include "Core/CompressionUtil.h"
+#include "Core/ParallelUtil.h"
 #include "Core/GameProject/DependencyListBuilders.h"
 #include "Core/Resource/Area/CGameArea.h"
 #include "Core/Resource/Cooker/CScriptCooker.h"
+#include <Common/Hash/CFNV1A.h>
 
 constexpr bool gkForceDisableCompression = false;
 
@@ -179,6 +181,29 @@ void CAreaCooker::WriteAreaData(IOutputStream& rOut)
 }
 
 // ************ SCLY ************
+std::vector<std::vector<char>> CAreaCooker::CookScriptLayers(CScriptCooker& rGeneratedCooker)
+{
+    // Layers don't depend on each other, so each one is cooked into its own buffer on a worker thread.
+    // Generated objects are gathered afterwards in layer order so SCGN comes out the same as a serial cook.
+    const size_t NumLayers = mpArea->mScriptLayers.size();
+    std::vector<std::vector<char>> LayerData(NumLayers);
+    std::vector<CScriptCooker> LayerCookers;
+    LayerCookers.reserve(NumLayers);
+
+    for (size_t LayerIdx = 0; LayerIdx < NumLayers; LayerIdx++)
+        LayerCookers.emplace_back(mVersion);
+
+    ParallelUtil::ParallelFor(NumLayers, [&](size_t LayerIdx) {
+        CVectorOutStream LayerOut(&LayerData[LayerIdx], std::endian::big);
+        LayerCookers[LayerIdx].WriteLayer(LayerOut, mpArea->mScriptLayers[LayerIdx].get());
+    });
+
+    for (const auto& cooker : LayerCookers)
+        rGeneratedCooker.MergeGeneratedObjects(cooker);
+
+    return LayerData;
+}
+
 void CAreaCooker::WritePrimeSCLY(IOutputStream& rOut)
 {
     // This function covers both Prime 1 and the Echoes demo.
@@ -186,40 +211,28 @@ void CAreaCooker::WritePrimeSCLY(IOutputStream& rOut)
     rOut.WriteFourCC(CFourCC("SCLY"));
     mVersion <= EGame::Prime ? rOut.WriteU32(1) : rOut.WriteU8(1);
 
-    const auto NumLayers = static_cast<uint32_t>(mpArea->mScriptLayers.size());
-    rOut.WriteU32(NumLayers);
-
-    const uint32_t LayerSizesStart = rOut.Tell();
-    for (uint32_t LayerIdx = 0; LayerIdx < NumLayers; LayerIdx++)
-        rOut.WriteU32(0);
-
     // SCLY
     CScriptCooker ScriptCooker(mVersion, true);
-    std::vector<uint32_t> LayerSizes(NumLayers);
+    const std::vector<std::vector<char>> LayerData = CookScriptLayers(ScriptCooker);
+    rOut.WriteU32(static_cast<uint32_t>(LayerData.size()));
 
-    for (uint32_t LayerIdx = 0; LayerIdx < NumLayers; LayerIdx++)
+    // Each layer is padded to 32 bytes
+    for (const auto& layer : LayerData)
     {
-        const uint32_t LayerStart = rOut.Tell();
-        ScriptCooker.WriteLayer(rOut, mpArea->mScriptLayers[LayerIdx].get());
+        const auto LayerSize = static_cast<uint32_t>(layer.size());
+        rOut.WriteU32((LayerSize + 31) & ~31);
+    }
 
-        // Pad the layer to 32 bytes
-        const uint32_t LayerSize = rOut.Tell() - LayerStart;
-        const uint32_t PaddedSize = (LayerSize + 31) & ~31;
-        const uint32_t NumPadBytes = PaddedSize - LayerSize;
+    for (const auto& layer : LayerData)
+    {
+        const auto LayerSize = static_cast<uint32_t>(layer.size());
+        const uint32_t NumPadBytes = ((LayerSize + 31) & ~31) - LayerSize;
+        rOut.WriteBytes(layer.data(), layer.size());
 
         for (uint32_t Pad = 0; Pad < NumPadBytes; Pad++)
             rOut.WriteU8(0);
-
-        LayerSizes[LayerIdx] = PaddedSize;
     }
 
-    const auto LayersEnd = rOut.Tell();
-    rOut.Seek(LayerSizesStart, SEEK_SET);
-
-    for (uint32_t LayerIdx = 0; LayerIdx < NumLayers; LayerIdx++)
-        rOut.WriteU32(LayerSizes[LayerIdx]);
-
-    rOut.Seek(LayersEnd, SEEK_SET);
     FinishSection(false);
 
     // SCGN
@@ -236,13 +249,14 @@ void CAreaCooker::WriteEchoesSCLY(IOutputStream& rOut)
 {
     // SCLY
     CScriptCooker ScriptCooker(mVersion);
+    const std::vector<std::vector<char>> LayerData = CookScriptLayers(ScriptCooker);
 
-    for (uint32_t LayerIdx = 0; LayerIdx < mpArea->mScriptLayers.size(); LayerIdx++)
+    for (uint32_t LayerIdx = 0; LayerIdx < LayerData.size(); LayerIdx++)
     {
         rOut.WriteFourCC(CFourCC("SCLY"));
         rOut.WriteU8(1);
         rOut.WriteU32(LayerIdx);
-        ScriptCooker.WriteLayer(rOut, mpArea->mScriptLayers[LayerIdx].get());
+        rOut.WriteBytes(LayerData[LayerIdx].data(), LayerData[LayerIdx].size());
         FinishSection(true);
     }
 
@@ -346,42 +360,106 @@ void CAreaCooker::FinishBlock()
 {
     if (mCurBlock.NumSections == 0) return;
 
-    std::vector<uint8_t> CompressedBuf(mCompressedData.Size() * 2);
+    SPendingBlock& rBlock = mPendingBlocks.emplace_back();
+    const auto* pkData = static_cast<const uint8_t*>(mCompressedData.Data());
+    rBlock.Info = mCurBlock;
+    rBlock.Data.assign(pkData, pkData + mCompressedData.Size());
+
+    mCompressedData.Clear();
+    mCurBlock = SCompressedBlock();
+}
+
+void CAreaCooker::CompressBlocks()
+{
     const bool EnableCompression = (mVersion >= EGame::Echoes) && mpArea->mUsesCompression && !gkForceDisableCompression;
     const bool UseZlib = (mVersion == EGame::DKCReturns);
+    auto& rBlockCache = mpArea->mCookedBlockCache;
 
-    uint32_t CompressedSize = 0;
-    bool WriteCompressedData = false;
+    // Reuse the compressed output of any block that is unchanged since the last cook.
+    // This is usually every block except the ones holding script data.
+    std::vector<size_t> DirtyBlocks;
 
     if (EnableCompression)
     {
-        const bool Success = CompressionUtil::CompressSegmentedData(static_cast<uint8_t*>(mCompressedData.Data()), mCompressedData.Size(), CompressedBuf.data(), CompressedSize, UseZlib, true);
-        const uint32_t PadBytes = (32 - (CompressedSize % 32)) & 0x1F;
-        WriteCompressedData = Success && (CompressedSize + PadBytes < static_cast<uint32_t>(mCompressedData.Size()));
+        for (size_t BlockIdx = 0; BlockIdx < mPendingBlocks.size(); BlockIdx++)
+        {
+            SPendingBlock& rBlock = mPendingBlocks[BlockIdx];
+            CFNV1A Hash(CFNV1A::EHashLength::k64Bit);
+            Hash.HashData(rBlock.Data.data(), rBlock.Data.size());
+            rBlock.Hash = Hash.GetHash64();
+
+            const auto Iter = rBlockCache.find(rBlock.Hash);
+
+            if (Iter != rBlockCache.cend() && Iter->second.DecompressedSize == rBlock.Data.size())
+            {
+                rBlock.Compressed = Iter->second.Compressed;
+                rBlock.CompressedData = Iter->second.CompressedData;
+            }
+            else
+            {
+                DirtyBlocks.push_back(BlockIdx);
+            }
+        }
     }
 
-    if (WriteCompressedData)
+    ParallelUtil::ParallelFor(DirtyBlocks.size(), [&](size_t TaskIdx) {
+        CompressBlock(mPendingBlocks[DirtyBlocks[TaskIdx]], UseZlib);
+    });
+
+    // Write out blocks in order, and keep only this cook's blocks in the cache
+    std::unordered_map<uint64_t, CGameArea::SCookedBlock> NewBlockCache;
+
+    for (auto& block : mPendingBlocks)
     {
-        uint32_t PadBytes = 32 - (CompressedSize % 32);
-        PadBytes &= 0x1F;
+        if (block.Compressed)
+        {
+            const auto CompressedSize = static_cast<uint32_t>(block.CompressedData.size());
+            uint32_t PadBytes = 32 - (CompressedSize % 32);
+            PadBytes &= 0x1F;
 
-        for (uint32_t iPad = 0; iPad < PadBytes; iPad++)
-            mAreaData.WriteU8(0);
+            for (uint32_t iPad = 0; iPad < PadBytes; iPad++)
+                mAreaData.WriteU8(0);
 
-        mAreaData.WriteBytes(CompressedBuf.data(), CompressedSize);
-        mCurBlock.CompressedSize = CompressedSize;
+            mAreaData.WriteBytes(block.CompressedData.data(), CompressedSize);
+            block.Info.CompressedSize = CompressedSize;
+        }
+        else
+        {
+            mAreaData.WriteBytes(block.Data.data(), block.Data.size());
+            mAreaData.WriteToBoundary(32, 0);
+            block.Info.CompressedSize = 0;
+        }
+
+        mCompressedBlocks.push_back(block.Info);
+
+        if (EnableCompression)
+        {
+            CGameArea::SCookedBlock& rCached = NewBlockCache[block.Hash];
+            rCached.DecompressedSize = static_cast<uint32_t>(block.Data.size());
+            rCached.Compressed = block.Compressed;
+            rCached.CompressedData = std::move(block.CompressedData);
+        }
     }
 
-    else
+    rBlockCache = std::move(NewBlockCache);
+    mPendingBlocks.clear();
+}
+
+void CAreaCooker::CompressBlock(SPendingBlock& rBlock, bool UseZlib)
+{
+    const auto DataSize = static_cast<uint32_t>(rBlock.Data.size());
+    std::vector<uint8_t> CompressedBuf(DataSize * 2);
+    uint32_t CompressedSize = 0;
+
+    const bool Success = CompressionUtil::CompressSegmentedData(rBlock.Data.data(), DataSize, CompressedBuf.data(), CompressedSize, UseZlib, true);
+    const uint32_t PadBytes = (32 - (CompressedSize % 32)) & 0x1F;
+    rBlock.Compressed = Success && (CompressedSize + PadBytes < DataSize);
+
+    if (rBlock.Compressed)
     {
-        mAreaData.WriteBytes(mCompressedData.Data(), mCompressedData.Size());
-        mAreaData.WriteToBoundary(32, 0);
-        mCurBlock.CompressedSize = 0;
+        CompressedBuf.resize(CompressedSize);
+        rBlock.CompressedData = std::move(CompressedBuf);
     }
-
-    mCompressedData.Clear();
-    mCompressedBlocks.push_back(mCurBlock);
-    mCurBlock = SCompressedBlock();
 }
 
 // ************ STATIC ************
@@ -431,6 +509,7 @@ bool CAreaCooker::CookMREA(CGameArea *pArea, IOutputStream& rOut)
     }
 
     Cooker.FinishBlock();
+    Cooker.CompressBlocks();
 
     // Write to actual file
     if (Cooker.mVersion <= EGame::Echoes)
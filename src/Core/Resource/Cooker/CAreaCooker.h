@@ -6,9 +6,11 @@
 #include <Common/FileIO/CVectorOutStream.h>
 #include <Core/Resource/TResPtr.h>
 
+#include <cstdint>
 #include <vector>
 
 class CGameArea;
+class CScriptCooker;
 class IOutputStream;
 
 class CAreaCooker
@@ -40,11 +42,23 @@ class CAreaCooker
         uint32_t NumSections = 0;
     };
 
+    // A finished block waiting to be compressed. Blocks are only compressed once
+    // every section has been laid out, so they can be processed concurrently.
+    struct SPendingBlock
+    {
+        SCompressedBlock Info;
+        std::vector<uint8_t> Data;
+        uint64_t Hash = 0;
+        bool Compressed = false;
+        std::vector<uint8_t> CompressedData;
+    };
+
     SCompressedBlock mCurBlock;
     CVectorOutStream mSectionData;
     CVectorOutStream mCompressedData;
     CVectorOutStream mAreaData;
 
+    std::vector<SPendingBlock> mPendingBlocks;
     std::vector<SCompressedBlock> mCompressedBlocks;
 
     CAreaCooker();
@@ -58,6 +72,7 @@ class CAreaCooker
     void WriteAreaData(IOutputStream& rOut);
 
     // SCLY
+    std::vector<std::vector<char>> CookScriptLayers(CScriptCooker& rGeneratedCooker);
     void WritePrimeSCLY(IOutputStream& rOut);
     void WriteEchoesSCLY(IOutputStream& rOut);
 
@@ -69,6 +84,8 @@ class CAreaCooker
     void AddSectionToBlock();
     void FinishSection(bool ForceFinishBlock);
     void FinishBlock();
+    void CompressBlocks();
+    static void CompressBlock(SPendingBlock& rBlock, bool UseZlib);
 
 public:
     static bool CookMREA(CGameArea *pArea, IOutputStream& rOut);
@@ -234,6 +234,10 @@ void CModelCooker::WriteModelPrime(IOutputStream& rOut)
 
 bool CModelCooker::CookCMDL(CModel *pModel, IOutputStream& rOut)
 {
+    // Cooking needs every vertex attribute, not just the positions kept for picking
+    if (!pModel->EnsureFullGeometry())
+        return false;
+
     CModelCooker Cooker;
     Cooker.mpModel = pModel;
     Cooker.mVersion = pModel->Game();
@@ -356,3 +356,8 @@ void CScriptCooker::WriteGeneratedLayer(IOutputStream& rOut)
     for (auto* object : mGeneratedObjects)
         WriteInstance(rOut, object);
 }
+
+void CScriptCooker::MergeGeneratedObjects(const CScriptCooker& rkOther)
+{
+    mGeneratedObjects.insert(mGeneratedObjects.end(), rkOther.mGeneratedObjects.begin(), rkOther.mGeneratedObjects.end());
+}
@@ -23,6 +23,9 @@ public:
     void WriteInstance(IOutputStream& rOut, CScriptObject *pInstance);
     void WriteLayer(IOutputStream& rOut, CScriptLayer *pLayer);
     void WriteGeneratedLayer(IOutputStream& rOut);
+
+    /** Queue another cooker's generated objects, for layers that were cooked separately */
+    void MergeGeneratedObjects(const CScriptCooker& rkOther);
 };
 
 #endif // CSCRIPTCOOKER_H
@@ -153,16 +153,16 @@ void CAnimationLoader::ReadUncompressedANIM()
 
         if (BoneIdx != 0xFF)
         {
-            mpAnim->mBoneInfo[iBone].TranslationChannelIdx = (TransIndices.empty() ? 0xFF : TransIndices[iChan]);
-            mpAnim->mBoneInfo[iBone].RotationChannelIdx = (RotationIndices.empty() ? 0xFF : RotationIndices[iChan]);
-            mpAnim->mBoneInfo[iBone].ScaleChannelIdx = (ScaleIndices.empty() ? 0xFF : ScaleIndices[iChan]);
+            mpAnim->BoneInfo(iBone).TranslationChannelIdx = (TransIndices.empty() ? 0xFF : TransIndices[iChan]);
+            mpAnim->BoneInfo(iBone).RotationChannelIdx = (RotationIndices.empty() ? 0xFF : RotationIndices[iChan]);
+            mpAnim->BoneInfo(iBone).ScaleChannelIdx = (ScaleIndices.empty() ? 0xFF : ScaleIndices[iChan]);
             iChan++;
         }
         else
         {
-            mpAnim->mBoneInfo[iBone].TranslationChannelIdx = 0xFF;
-            mpAnim->mBoneInfo[iBone].RotationChannelIdx = 0xFF;
-            mpAnim->mBoneInfo[iBone].ScaleChannelIdx = 0xFF;
+            mpAnim->BoneInfo(iBone).TranslationChannelIdx = 0xFF;
+            mpAnim->BoneInfo(iBone).RotationChannelIdx = 0xFF;
+            mpAnim->BoneInfo(iBone).ScaleChannelIdx = 0xFF;
         }
     }
 
@@ -170,9 +170,9 @@ void CAnimationLoader::ReadUncompressedANIM()
     if (mGame >= EGame::EchoesDemo)
     {
         mpInput->Seek(0x4, SEEK_CUR); // Skipping scale key count
-        mpAnim->mScaleChannels.resize(NumScaleChannels);
+        mScaleChannels.resize(NumScaleChannels);
 
-        for (auto& scaleChannel : mpAnim->mScaleChannels)
+        for (auto& scaleChannel : mScaleChannels)
         {
             scaleChannel.reserve(mpAnim->mNumKeys);
             for (size_t iKey = 0; iKey < mpAnim->mNumKeys; iKey++)
@@ -181,9 +181,9 @@ void CAnimationLoader::ReadUncompressedANIM()
     }
 
     mpInput->Seek(0x4, SEEK_CUR); // Skipping rotation key count
-    mpAnim->mRotationChannels.resize(NumRotationChannels);
+    mRotationChannels.resize(NumRotationChannels);
 
-    for (auto& rotationChannel : mpAnim->mRotationChannels)
+    for (auto& rotationChannel : mRotationChannels)
     {
         rotationChannel.reserve(mpAnim->mNumKeys);
         for (size_t iKey = 0; iKey < mpAnim->mNumKeys; iKey++)
@@ -191,9 +191,9 @@ void CAnimationLoader::ReadUncompressedANIM()
     }
 
     mpInput->Seek(0x4, SEEK_CUR); // Skipping translation key count
-    mpAnim->mTranslationChannels.resize(NumTranslationChannels);
+    mTranslationChannels.resize(NumTranslationChannels);
 
-    for (auto& transChannel : mpAnim->mTranslationChannels)
+    for (auto& transChannel : mTranslationChannels)
     {
         transChannel.reserve(mpAnim->mNumKeys);
         for (size_t iKey = 0; iKey < mpAnim->mNumKeys; iKey++)
@@ -247,9 +247,9 @@ void CAnimationLoader::ReadCompressedANIM()
 
     // Read bone channel descriptors
     mCompressedChannels.resize(NumBoneChannels);
-    mpAnim->mScaleChannels.resize(NumBoneChannels);
-    mpAnim->mRotationChannels.resize(NumBoneChannels);
-    mpAnim->mTranslationChannels.resize(NumBoneChannels);
+    mScaleChannels.resize(NumBoneChannels);
+    mRotationChannels.resize(NumBoneChannels);
+    mTranslationChannels.resize(NumBoneChannels);
 
     for (size_t iChan = 0; iChan < NumBoneChannels; iChan++)
     {
@@ -267,11 +267,11 @@ void CAnimationLoader::ReadCompressedANIM()
                 rChan.RotationBits[iComp] = mpInput->ReadU8();
             }
 
-            mpAnim->mBoneInfo[rChan.BoneID].RotationChannelIdx = static_cast<uint8>(iChan);
+            mpAnim->BoneInfo(rChan.BoneID).RotationChannelIdx = static_cast<uint8>(iChan);
         }
         else
         {
-            mpAnim->mBoneInfo[rChan.BoneID].RotationChannelIdx = 0xFF;
+            mpAnim->BoneInfo(rChan.BoneID).RotationChannelIdx = 0xFF;
         }
 
         // Read translation parameters
@@ -285,11 +285,11 @@ void CAnimationLoader::ReadCompressedANIM()
                 rChan.TranslationBits[iComp] = mpInput->ReadU8();
             }
 
-            mpAnim->mBoneInfo[rChan.BoneID].TranslationChannelIdx = static_cast<uint8_t>(iChan);
+            mpAnim->BoneInfo(rChan.BoneID).TranslationChannelIdx = static_cast<uint8_t>(iChan);
         }
         else
         {
-            mpAnim->mBoneInfo[rChan.BoneID].TranslationChannelIdx = 0xFF;
+            mpAnim->BoneInfo(rChan.BoneID).TranslationChannelIdx = 0xFF;
         }
 
         // Read scale parameters
@@ -310,7 +310,7 @@ void CAnimationLoader::ReadCompressedANIM()
                 ScaleIdx = static_cast<uint8_t>(iChan);
             }
         }
-        mpAnim->mBoneInfo[rChan.BoneID].ScaleChannelIdx = ScaleIdx;
+        mpAnim->BoneInfo(rChan.BoneID).ScaleChannelIdx = ScaleIdx;
     }
 
     // Read animation data
@@ -327,23 +327,23 @@ void CAnimationLoader::ReadCompressedAnimationData()
         // Set initial rotation/translation/scale
         if (channel.NumRotationKeys > 0)
         {
-            mpAnim->mRotationChannels[idx].reserve(channel.NumRotationKeys + 1);
+            mRotationChannels[idx].reserve(channel.NumRotationKeys + 1);
             CQuaternion Rotation = DequantizeRotation(false, channel.Rotation[0], channel.Rotation[1], channel.Rotation[2]);
-            mpAnim->mRotationChannels[idx].push_back(Rotation);
+            mRotationChannels[idx].push_back(Rotation);
         }
 
         if (channel.NumTranslationKeys > 0)
         {
-            mpAnim->mTranslationChannels[idx].reserve(channel.NumTranslationKeys + 1);
+            mTranslationChannels[idx].reserve(channel.NumTranslationKeys + 1);
             CVector3f Translate = CVector3f(channel.Translation[0], channel.Translation[1], channel.Translation[2]) * mTranslationMultiplier;
-            mpAnim->mTranslationChannels[idx].push_back(Translate);
+            mTranslationChannels[idx].push_back(Translate);
         }
 
         if (channel.NumScaleKeys > 0)
         {
-            mpAnim->mScaleChannels[idx].reserve(channel.NumScaleKeys + 1);
+            mScaleChannels[idx].reserve(channel.NumScaleKeys + 1);
             CVector3f Scale = CVector3f(channel.Scale[0], channel.Scale[1], channel.Scale[2]) * mScaleMultiplier;
-            mpAnim->mScaleChannels[idx].push_back(Scale);
+            mScaleChannels[idx].push_back(Scale);
         }
     }
 
@@ -369,7 +369,7 @@ void CAnimationLoader::ReadCompressedAnimationData()
                 }
 
                 const CQuaternion Rotation = DequantizeRotation(WSign, channel.Rotation[0], channel.Rotation[1], channel.Rotation[2]);
-                mpAnim->mRotationChannels[idx].push_back(Rotation);
+                mRotationChannels[idx].push_back(Rotation);
             }
 
             // Read translation
@@ -383,7 +383,7 @@ void CAnimationLoader::ReadCompressedAnimationData()
                 }
 
                 const CVector3f Translate = CVector3f(channel.Translation[0], channel.Translation[1], channel.Translation[2]) * mTranslationMultiplier;
-                mpAnim->mTranslationChannels[idx].push_back(Translate);
+                mTranslationChannels[idx].push_back(Translate);
             }
 
             // Read scale
@@ -397,7 +397,7 @@ void CAnimationLoader::ReadCompressedAnimationData()
                 }
 
                 const CVector3f Scale = CVector3f(channel.Scale[0], channel.Scale[1], channel.Scale[2]) * mScaleMultiplier;
-                mpAnim->mScaleChannels[idx].push_back(Scale);
+                mScaleChannels[idx].push_back(Scale);
             }
         }
     }
@@ -431,23 +431,23 @@ void CAnimationLoader::ReadCompressedAnimationData()
 
                     if (HasRotationKeys)
                     {
-                        const CQuaternion& Left = mpAnim->mRotationChannels[idx][FirstIndex];
-                        const CQuaternion& Right = mpAnim->mRotationChannels[idx][LastIndex];
-                        mpAnim->mRotationChannels[idx][KeyIndex] = Left.Slerp(Right, Interp);
+                        const CQuaternion& Left = mRotationChannels[idx][FirstIndex];
+                        const CQuaternion& Right = mRotationChannels[idx][LastIndex];
+                        mRotationChannels[idx][KeyIndex] = Left.Slerp(Right, Interp);
                     }
 
                     if (HasTranslationKeys)
                     {
-                        const CVector3f& Left = mpAnim->mTranslationChannels[idx][FirstIndex];
-                        const CVector3f& Right = mpAnim->mTranslationChannels[idx][LastIndex];
-                        mpAnim->mTranslationChannels[idx][KeyIndex] = Math::Lerp<CVector3f>(Left, Right, Interp);
+                        const CVector3f& Left = mTranslationChannels[idx][FirstIndex];
+                        const CVector3f& Right = mTranslationChannels[idx][LastIndex];
+                        mTranslationChannels[idx][KeyIndex] = Math::Lerp<CVector3f>(Left, Right, Interp);
                     }
 
                     if (HasScaleKeys)
                     {
-                        const CVector3f& Left = mpAnim->mScaleChannels[idx][FirstIndex];
-                        const CVector3f& Right = mpAnim->mScaleChannels[idx][LastIndex];
-                        mpAnim->mScaleChannels[idx][KeyIndex] = Math::Lerp<CVector3f>(Left, Right, Interp);
+                        const CVector3f& Left = mScaleChannels[idx][FirstIndex];
+                        const CVector3f& Right = mScaleChannels[idx][LastIndex];
+                        mScaleChannels[idx][KeyIndex] = Math::Lerp<CVector3f>(Left, Right, Interp);
                     }
                 }
             }
@@ -499,5 +499,7 @@ std::unique_ptr<CAnimation> CAnimationLoader::LoadANIM(IInputStream& rANIM, CRes
     else
         Loader.ReadCompressedANIM();
 
+    ptr->SetChannels(Loader.mScaleChannels, Loader.mRotationChannels, Loader.mTranslationChannels);
+
     return ptr;
 }
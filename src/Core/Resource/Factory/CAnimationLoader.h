@@ -4,12 +4,14 @@
 #include "Core/Resource/TResPtr.h"
 
 #include <Common/EGame.h>
+#include <Common/Math/CQuaternion.h>
+#include <Common/Math/CVector3f.h>
 #include <array>
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 class CAnimation;
-class CQuaternion;
 class CResourceEntry;
 class IInputStream;
 
@@ -19,6 +21,11 @@ class CAnimationLoader
     IInputStream *mpInput = nullptr;
     EGame mGame{};
 
+    // Uncompressed keys, packed into the animation's key buffer once loading finishes
+    std::vector<std::vector<CVector3f>> mScaleChannels;
+    std::vector<std::vector<CQuaternion>> mRotationChannels;
+    std::vector<std::vector<CVector3f>> mTranslationChannels;
+
     // Compression data
     std::vector<bool> mKeyFlags;
     float mTranslationMultiplier = 0.0f;
@@ -637,7 +637,7 @@ void CAreaLoader::SetUpObjects(CScriptLayer *pGenLayer)
             const auto InstanceID = pInst->InstanceID();
             [[maybe_unused]] CScriptObject *pExisting = mpArea->InstanceByID(InstanceID);
             ASSERT(pExisting == nullptr);
-            mpArea->mObjectMap[InstanceID] = pInst;
+            mpArea->Internal_RegisterInstance(pInst);
         }
     }
 
@@ -665,7 +665,7 @@ void CAreaLoader::SetUpObjects(CScriptLayer *pGenLayer)
             {
                 const uint32 LayerIdx = InstanceID.Layer();
                 pInst->SetLayer(mpArea->ScriptLayer(LayerIdx));
-                mpArea->mObjectMap[InstanceID] = pInst;
+                mpArea->Internal_RegisterInstance(pInst);
             }
         }
     }
@@ -799,6 +799,60 @@ std::unique_ptr<CGameArea> CAreaLoader::LoadMREA(IInputStream& MREA, CResourceEn
     return ptr;
 }
 
+std::unique_ptr<CGameArea> CAreaLoader::LoadMREAGeometry(IInputStream& MREA, CResourceEntry *pEntry)
+{
+    CAreaLoader Loader;
+
+    // Validation
+    if (!MREA.IsValid()) return nullptr;
+
+    const uint32 DeadBeef = MREA.ReadU32();
+    if (DeadBeef != 0xdeadbeef)
+    {
+        NLog::Error("{}: Invalid MREA magic: 0x{:08X}", *MREA.GetSourceString(), DeadBeef);
+        return nullptr;
+    }
+
+    auto ptr = std::make_unique<CGameArea>(pEntry);
+
+    // Header and world geometry only; used to restore geometry that was compacted after upload
+    Loader.mpArea = ptr.get();
+    const uint32 Version = MREA.ReadU32();
+    Loader.mVersion = GetFormatVersion(Version);
+    Loader.mpMREA = &MREA;
+
+    switch (Loader.mVersion)
+    {
+        case EGame::PrimeDemo:
+        case EGame::Prime:
+            Loader.ReadHeaderPrime();
+            Loader.ReadGeometryPrime();
+            break;
+        case EGame::EchoesDemo:
+        case EGame::Echoes:
+            Loader.ReadHeaderEchoes();
+            Loader.ReadGeometryPrime();
+            break;
+        case EGame::CorruptionProto:
+            Loader.ReadHeaderCorruption();
+            Loader.ReadGeometryPrime();
+            break;
+        case EGame::Corruption:
+        case EGame::DKCReturns:
+            Loader.ReadHeaderCorruption();
+            Loader.ReadGeometryCorruption();
+            break;
+        default:
+            NLog::Error("{}: Unsupported MREA version: 0x{:X}", *MREA.GetSourceString(), Version);
+            Loader.mpArea.Delete();
+            return nullptr;
+    }
+
+    // Cleanup
+    delete Loader.mpSectionMgr;
+    return ptr;
+}
+
 EGame CAreaLoader::GetFormatVersion(uint32_t Version)
 {
     switch (Version)
@@ -92,6 +92,7 @@ class CAreaLoader
 
 public:
     static std::unique_ptr<CGameArea> LoadMREA(IInputStream& rMREA, CResourceEntry *pEntry);
+    static std::unique_ptr<CGameArea> LoadMREAGeometry(IInputStream& rMREA, CResourceEntry *pEntry);
     static EGame GetFormatVersion(uint32_t Version);
 };
 
@@ -5,36 +5,33 @@
 #include "Core/Resource/Collision/CCollisionMeshGroup.h"
 #include "Core/Resource/Collision/CCollidableOBBTree.h"
 
-static std::unique_ptr<SOBBTreeNode> ParseOBBNode(IInputStream& DCLN)
+static void ParseOBBNode(IInputStream& DCLN, std::vector<SOBBTreeNode>& rNodes, std::vector<uint16_t>& rLeafTriangles)
 {
-    std::unique_ptr<SOBBTreeNode> pOut;
-
-    const CTransform4f Transform(DCLN);
-    const CVector3f Radius(DCLN);
+    // Nodes are appended depth-first; keep an index since recursion may reallocate the array
+    const size_t NodeIdx = rNodes.size();
+    SOBBTreeNode& rNode = rNodes.emplace_back();
+    rNode.Transform = CTransform4f(DCLN);
+    rNode.InverseTransform = rNode.Transform.Inverse();
+    rNode.Radii = CVector3f(DCLN);
     const bool IsLeaf = DCLN.ReadBool();
 
     if (IsLeaf)
     {
-        auto pLeaf = std::make_unique<SOBBTreeLeaf>();
         const auto NumTris = DCLN.ReadU32();
-        pLeaf->TriangleIndices.resize(NumTris);
-
-        for (auto& index : pLeaf->TriangleIndices)
-            index = DCLN.ReadU16();
+        rNode.NodeType = EOBBTreeNodeType::Leaf;
+        rNode.FirstTriangle = static_cast<uint32_t>(rLeafTriangles.size());
+        rNode.NumTriangles = NumTris;
 
-        pOut = std::move(pLeaf);
+        for (uint32_t TriIdx = 0; TriIdx < NumTris; TriIdx++)
+            rLeafTriangles.push_back(DCLN.ReadU16());
     }
     else
     {
-        auto pBranch = std::make_unique<SOBBTreeBranch>();
-        pBranch->pLeft = ParseOBBNode(DCLN);
-        pBranch->pRight = ParseOBBNode(DCLN);
-        pOut = std::move(pBranch);
+        rNode.NodeType = EOBBTreeNodeType::Branch;
+        ParseOBBNode(DCLN, rNodes, rLeafTriangles);
+        rNodes[NodeIdx].RightChild = static_cast<uint32_t>(rNodes.size());
+        ParseOBBNode(DCLN, rNodes, rLeafTriangles);
     }
-
-    pOut->Transform = Transform;
-    pOut->Radii = Radius;
-    return pOut;
 }
 
 CCollisionLoader::CCollisionLoader() = default;
@@ -252,7 +249,7 @@ std::unique_ptr<CCollisionMeshGroup> CCollisionLoader::LoadDCLN(IInputStream& rD
 
         // Parse OBB tree
         auto* pOBBTree = static_cast<CCollidableOBBTree*>(Loader.mpMesh);
-        pOBBTree->mpOBBTree = ParseOBBNode(rDCLN);
+        ParseOBBNode(rDCLN, pOBBTree->mOBBNodes, pOBBTree->mLeafTriangles);
     }
 
     return ptr;
@@ -44,7 +44,7 @@ void CFontLoader::LoadFont(IInputStream& rFONT)
             Glyph.Width = rFONT.ReadU32();
             Glyph.Height = rFONT.ReadU32();
             Glyph.BaseOffset = rFONT.ReadU32();
-            Glyph.KerningIndex = rFONT.ReadU32();
+            rFONT.Seek(0x4, SEEK_CUR); // Kerning table index; pairs are looked up by character instead
         }
         else if (mVersion >= EGame::Echoes)
         {
@@ -55,20 +55,22 @@ void CFontLoader::LoadFont(IInputStream& rFONT)
             Glyph.Width = rFONT.ReadU8();
             Glyph.Height = rFONT.ReadU8();
             Glyph.BaseOffset = rFONT.ReadU8();
-            Glyph.KerningIndex = rFONT.ReadU16();
+            rFONT.Seek(0x2, SEEK_CUR); // Kerning table index; pairs are looked up by character instead
         }
         mpFont->mGlyphs.insert_or_assign(Glyph.Character, Glyph);
     }
 
     const auto NumKerningPairs = rFONT.ReadU32();
-    mpFont->mKerningTable.reserve(NumKerningPairs);
+    mpFont->mKerningPairs.reserve(NumKerningPairs);
 
     for (uint32_t iKern = 0; iKern < NumKerningPairs; iKern++)
     {
-        auto& Pair = mpFont->mKerningTable.emplace_back();
-        Pair.CharacterA = rFONT.ReadU16();
-        Pair.CharacterB = rFONT.ReadU16();
-        Pair.Adjust = rFONT.ReadS32();
+        const auto CharacterA = rFONT.ReadU16();
+        const auto CharacterB = rFONT.ReadU16();
+        const auto Adjust = rFONT.ReadS32();
+
+        // Keep the first entry if a pair is listed more than once, matching the table scan this replaces
+        mpFont->mKerningPairs.try_emplace(CFont::KerningKey(CharacterA, CharacterB), Adjust);
     }
 }
 
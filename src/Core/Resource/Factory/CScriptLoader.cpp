@@ -1,5 +1,6 @@
 #include "Core/Resource/Factory/CScriptLoader.h"
 
+#include "Core/ParallelUtil.h"
 #include "Core/GameProject/CResourceStore.h"
 #include "Core/Resource/Area/CGameArea.h"
 #include "Core/Resource/Script/CGameTemplate.h"
@@ -12,6 +13,7 @@
 #include "Core/Resource/Script/Property/CFlagsProperty.h"
 
 #include <Common/Log.h>
+#include <Common/FileIO/CMemoryInStream.h>
 
 // Whether to ensure the values of enum/flag properties are valid
 #define VALIDATE_PROPERTY_VALUES 1
@@ -71,7 +73,7 @@ void CScriptLoader::ReadProperty(IProperty *pProp, uint32 Size, IInputStream& rS
             const auto Value = pChoice->ValueRef(pData);
             NLog::Error("{} [0x{:X}]: Choice property \"{}\" ({}) has unrecognized value: 0x{:08X}",
                         *rSCLY.GetSourceString(),
-                        rSCLY.Tell() - 4,
+                        mStreamBaseOffset + rSCLY.Tell() - 4,
                         *pChoice->Name(),
                         *pChoice->IDString(true),
                         Value);
@@ -91,7 +93,7 @@ void CScriptLoader::ReadProperty(IProperty *pProp, uint32 Size, IInputStream& rS
             const auto Value = pEnum->ValueRef(pData);
             NLog::Error("{} [0x{:X}]: Enum property \"{}\" ({}) has unrecognized value: 0x{:08X}",
                         *rSCLY.GetSourceString(),
-                        rSCLY.Tell() - 4,
+                        mStreamBaseOffset + rSCLY.Tell() - 4,
                         *pEnum->Name(),
                         *pEnum->IDString(true),
                         Value);
@@ -112,7 +114,7 @@ void CScriptLoader::ReadProperty(IProperty *pProp, uint32 Size, IInputStream& rS
         {
             NLog::Warn("{} [0x{:X}]: Flags property \"{}\" ({}) has unrecognized flags set: 0x{:08X}",
                        *rSCLY.GetSourceString(),
-                       rSCLY.Tell() - 4,
+                       mStreamBaseOffset + rSCLY.Tell() - 4,
                        *pFlags->Name(),
                        *pFlags->IDString(true),
                        InvalidBits);
@@ -163,7 +165,7 @@ void CScriptLoader::ReadProperty(IProperty *pProp, uint32 Size, IInputStream& rS
                 {
                     NLog::Warn("{} [0x{:X}]: Asset property \"{}\" ({}) has a reference to an illegal asset type: {}",
                                *rSCLY.GetSourceString(),
-                               rSCLY.Tell() - static_cast<uint32>(ID.Length()),
+                               mStreamBaseOffset + rSCLY.Tell() - static_cast<uint32>(ID.Length()),
                                *pAsset->Name(),
                                *pAsset->IDString(true),
                                *pEntry->CookedExtension().ToString());
@@ -267,6 +269,51 @@ void CScriptLoader::ReadProperty(IProperty *pProp, uint32 Size, IInputStream& rS
     }
 }
 
+void CScriptLoader::DecodeInstances(IInputStream& rSCLY, uint32_t DataStart, uint32_t DataEnd, const std::vector<SPendingInstance>& rkInstances)
+{
+    // Instances are length-prefixed and don't depend on each other, so once the index pass has
+    // found them their links and properties can be decoded concurrently from an in-memory copy.
+    std::vector<uint8_t> LayerData(DataEnd - DataStart);
+    rSCLY.Seek(DataStart, SEEK_SET);
+    rSCLY.ReadBytes(LayerData.data(), LayerData.size());
+
+    const TString Source = rSCLY.GetSourceString();
+    const auto DecodeInstance = [&](size_t InstanceIdx) {
+        CScriptLoader Worker = *this;
+        Worker.mpObj = rkInstances[InstanceIdx].pObject;
+        Worker.mpCurrentData = nullptr;
+        Worker.mStreamBaseOffset = DataStart;
+
+        CMemoryInStream Stream(LayerData.data(), static_cast<uint32_t>(LayerData.size()), std::endian::big);
+        Stream.SetSourceString(Source);
+        Stream.Seek(rkInstances[InstanceIdx].BodyOffset - DataStart, SEEK_SET);
+
+        if (mVersion <= EGame::Prime)
+            Worker.LoadObjectBodyMP1(Stream);
+        else
+            Worker.LoadObjectBodyMP2(Stream);
+    };
+
+    if (rkInstances.size() < skMinParallelInstances)
+    {
+        for (size_t InstanceIdx = 0; InstanceIdx < rkInstances.size(); InstanceIdx++)
+            DecodeInstance(InstanceIdx);
+    }
+    else
+    {
+        ParallelUtil::ParallelFor(rkInstances.size(), DecodeInstance);
+    }
+
+    rSCLY.Seek(DataEnd, SEEK_SET);
+
+    // Evaluating properties may load resources, so it stays on this thread, in file order
+    for (const auto& instance : rkInstances)
+    {
+        instance.pObject->EvaluateProperties();
+        mpLayer->AddInstance(instance.pObject);
+    }
+}
+
 void CScriptLoader::LoadStructMP1(IInputStream& rSCLY, CStructProperty* pStruct)
 {
     [[maybe_unused]] const uint32 StructStart = rSCLY.Tell();
@@ -292,27 +339,30 @@ void CScriptLoader::LoadStructMP1(IInputStream& rSCLY, CStructProperty* pStruct)
     }
 }
 
-CScriptObject* CScriptLoader::LoadObjectMP1(IInputStream& rSCLY)
+CScriptObject* CScriptLoader::CreateObjectMP1(IInputStream& rSCLY, uint32_t& rOutEnd)
 {
     const auto StartOffset = rSCLY.Tell();
     const auto Type = rSCLY.ReadU8();
     const auto Size = rSCLY.ReadU32();
-    const auto End = rSCLY.Tell() + Size;
+    rOutEnd = rSCLY.Tell() + Size;
 
     CScriptTemplate *pTemplate = mpGameTemplate->TemplateByID(static_cast<uint32_t>(Type));
     if (!pTemplate)
     {
         // No valid template for this object; can't load
         NLog::Error("{} [0x{:X}]: Unknown object ID encountered: 0x{:02X}", *rSCLY.GetSourceString(), StartOffset, Type);
-        rSCLY.Seek(End, SEEK_SET);
+        rSCLY.Seek(rOutEnd, SEEK_SET);
         return nullptr;
     }
 
     auto InstanceID = CInstanceID(rSCLY.ReadU32());
     if (InstanceID.Value() == 0xFFFFFFFFU)
-        InstanceID = mpArea->FindUnusedInstanceID();
-    mpObj = new CScriptObject(InstanceID, mpArea, mpLayer, pTemplate);
+        InstanceID = mNewInstanceID.IsValid() ? mNewInstanceID : mpArea->FindUnusedInstanceID();
+    return new CScriptObject(InstanceID, mpArea, mpLayer, pTemplate);
+}
 
+void CScriptLoader::LoadObjectBodyMP1(IInputStream& rSCLY)
+{
     // Load connections
     const auto NumLinks = rSCLY.ReadU32();
     mpObj->mOutLinks.reserve(NumLinks);
@@ -328,8 +378,19 @@ CScriptObject* CScriptLoader::LoadObjectMP1(IInputStream& rSCLY)
     }
 
     // Load object...
-    CStructProperty* pProperties = pTemplate->Properties();
+    CStructProperty* pProperties = mpObj->Template()->Properties();
     LoadStructMP1(rSCLY, pProperties);
+}
+
+CScriptObject* CScriptLoader::LoadObjectMP1(IInputStream& rSCLY)
+{
+    uint32_t End = 0;
+    mpObj = CreateObjectMP1(rSCLY, End);
+
+    if (!mpObj)
+        return nullptr;
+
+    LoadObjectBodyMP1(rSCLY);
 
     // Cleanup and return
     rSCLY.Seek(End, SEEK_SET);
@@ -350,13 +411,23 @@ std::unique_ptr<CScriptLayer> CScriptLoader::LoadLayerMP1(IInputStream& rSCLY)
     mpLayer = layer.get();
     mpLayer->Reserve(NumObjects);
 
+    // Index pass: create each instance in file order and note where its body starts
+    const auto DataStart = rSCLY.Tell();
+    std::vector<SPendingInstance> Instances;
+    Instances.reserve(NumObjects);
+
     for (uint32_t ObjectIndex = 0; ObjectIndex < NumObjects; ObjectIndex++)
     {
-        CScriptObject *pObject = LoadObjectMP1(rSCLY);
+        uint32_t End = 0;
+        CScriptObject *pObject = CreateObjectMP1(rSCLY, End);
         if (pObject)
-            mpLayer->AddInstance(pObject);
+            Instances.push_back({pObject, static_cast<uint32_t>(rSCLY.Tell())});
+
+        rSCLY.Seek(End, SEEK_SET);
     }
 
+    DecodeInstances(rSCLY, DataStart, rSCLY.Tell(), Instances);
+
     // Layer sizes are always a multiple of 32 - skip end padding before returning
     const uint32_t Remaining = 32 - ((rSCLY.Tell() - LayerStart) & 0x1F);
     rSCLY.Seek(Remaining, SEEK_CUR);
@@ -396,34 +467,37 @@ void CScriptLoader::LoadStructMP2(IInputStream& rSCLY, CStructProperty* pStruct)
         if (pProperty)
             ReadProperty(pProperty, PropertySize, rSCLY);
         else
-            NLog::Error("{} [0x{:X}]: Can't find template for property 0x{:08X} - skipping", *rSCLY.GetSourceString(), PropertyStart, PropertyID);
+            NLog::Error("{} [0x{:X}]: Can't find template for property 0x{:08X} - skipping", *rSCLY.GetSourceString(), mStreamBaseOffset + PropertyStart, PropertyID);
 
         if (NextProperty > 0)
             rSCLY.Seek(NextProperty, SEEK_SET);
     }
 }
 
-CScriptObject* CScriptLoader::LoadObjectMP2(IInputStream& rSCLY)
+CScriptObject* CScriptLoader::CreateObjectMP2(IInputStream& rSCLY, uint32_t& rOutEnd)
 {
     const auto ObjStart = rSCLY.Tell();
     const auto ObjectID = rSCLY.ReadU32();
     const auto ObjectSize = rSCLY.ReadU16();
-    const auto ObjEnd = rSCLY.Tell() + ObjectSize;
+    rOutEnd = rSCLY.Tell() + ObjectSize;
 
     CScriptTemplate* pTemplate = mpGameTemplate->TemplateByID(ObjectID);
 
     if (!pTemplate)
     {
         NLog::Error("{} [0x{:X}]: Unknown object ID encountered: {}", *rSCLY.GetSourceString(), ObjStart, *CFourCC(ObjectID).ToString());
-        rSCLY.Seek(ObjEnd, SEEK_SET);
+        rSCLY.Seek(rOutEnd, SEEK_SET);
         return nullptr;
     }
 
     auto InstanceID = CInstanceID(rSCLY.ReadU32());
     if (InstanceID.Value() == 0xFFFFFFFFU)
-        InstanceID = mpArea->FindUnusedInstanceID();
-    mpObj = new CScriptObject(InstanceID, mpArea, mpLayer, pTemplate);
+        InstanceID = mNewInstanceID.IsValid() ? mNewInstanceID : mpArea->FindUnusedInstanceID();
+    return new CScriptObject(InstanceID, mpArea, mpLayer, pTemplate);
+}
 
+void CScriptLoader::LoadObjectBodyMP2(IInputStream& rSCLY)
+{
     // Load connections
     const uint32_t NumConnections = rSCLY.ReadU16();
     mpObj->mOutLinks.reserve(NumConnections);
@@ -440,10 +514,21 @@ CScriptObject* CScriptLoader::LoadObjectMP2(IInputStream& rSCLY)
 
     // Load object
     rSCLY.Seek(0x6, SEEK_CUR); // Skip base struct ID + size
-    LoadStructMP2(rSCLY, pTemplate->Properties());
+    LoadStructMP2(rSCLY, mpObj->Template()->Properties());
+}
+
+CScriptObject* CScriptLoader::LoadObjectMP2(IInputStream& rSCLY)
+{
+    uint32_t End = 0;
+    mpObj = CreateObjectMP2(rSCLY, End);
+
+    if (!mpObj)
+        return nullptr;
+
+    LoadObjectBodyMP2(rSCLY);
 
     // Cleanup and return
-    rSCLY.Seek(ObjEnd, SEEK_SET);
+    rSCLY.Seek(End, SEEK_SET);
     mpObj->EvaluateProperties();
     return mpObj;
 }
@@ -458,13 +543,22 @@ std::unique_ptr<CScriptLayer> CScriptLoader::LoadLayerMP2(IInputStream& rSCLY)
     mpLayer = layer.get();
     mpLayer->Reserve(NumObjects);
 
+    // Index pass: create each instance in file order and note where its body starts
+    const auto DataStart = rSCLY.Tell();
+    std::vector<SPendingInstance> Instances;
+    Instances.reserve(NumObjects);
+
     for (uint32_t ObjectIdx = 0; ObjectIdx < NumObjects; ObjectIdx++)
     {
-        CScriptObject* pObject = LoadObjectMP2(rSCLY);
+        uint32_t End = 0;
+        CScriptObject* pObject = CreateObjectMP2(rSCLY, End);
         if (pObject)
-            mpLayer->AddInstance(pObject);
+            Instances.push_back({pObject, static_cast<uint32_t>(rSCLY.Tell())});
+
+        rSCLY.Seek(End, SEEK_SET);
     }
 
+    DecodeInstances(rSCLY, DataStart, rSCLY.Tell(), Instances);
     return layer;
 }
 
@@ -491,7 +585,7 @@ std::unique_ptr<CScriptLayer> CScriptLoader::LoadLayer(IInputStream& rSCLY, CGam
         return Loader.LoadLayerMP2(rSCLY);
 }
 
-CScriptObject* CScriptLoader::LoadInstance(IInputStream& rSCLY, CGameArea *pArea, CScriptLayer *pLayer, EGame Version, bool ForceReturnsFormat)
+CScriptObject* CScriptLoader::LoadInstance(IInputStream& rSCLY, CGameArea *pArea, CScriptLayer *pLayer, EGame Version, bool ForceReturnsFormat, CInstanceID NewInstanceID)
 {
     if (!rSCLY.IsValid())
         return nullptr;
@@ -501,6 +595,7 @@ CScriptObject* CScriptLoader::LoadInstance(IInputStream& rSCLY, CGameArea *pArea
     Loader.mpGameTemplate = NGameList::GetGameTemplate(Version);
     Loader.mpArea = pArea;
     Loader.mpLayer = pLayer;
+    Loader.mNewInstanceID = NewInstanceID;
 
     if (!Loader.mpGameTemplate)
     {
@@ -2,10 +2,12 @@
 #define CSCRIPTLOADER_H
 
 #include <Common/EGame.h>
+#include "Core/Resource/Script/CInstanceID.h"
 #include "Core/Resource/Script/Property/TPropertyRef.h"
 
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 class CGameArea;
 class CGameTemplate;
@@ -23,23 +25,44 @@ class CScriptLoader
     CGameArea* mpArea = nullptr;
     CGameTemplate *mpGameTemplate = nullptr;
 
+    // ID to give an instance that doesn't have one of its own (e.g. pasted instances); otherwise one is found in the area
+    CInstanceID mNewInstanceID;
+
     // Current data pointer
     void* mpCurrentData = nullptr;
 
+    // Position of the stream being read within the source file; nonzero when decoding from an in-memory copy of a layer
+    uint32_t mStreamBaseOffset = 0;
+
+    // An instance created during a layer's index pass whose links and properties haven't been read yet
+    struct SPendingInstance
+    {
+        CScriptObject* pObject = nullptr;
+        uint32_t BodyOffset = 0;
+    };
+
+    // Layers with fewer instances than this are decoded on the calling thread
+    static constexpr size_t skMinParallelInstances = 32;
+
     CScriptLoader();
     void ReadProperty(IProperty* pProp, uint32_t Size, IInputStream& rSCLY);
+    void DecodeInstances(IInputStream& rSCLY, uint32_t DataStart, uint32_t DataEnd, const std::vector<SPendingInstance>& rkInstances);
 
     void LoadStructMP1(IInputStream& rSCLY, CStructProperty* pStruct);
+    CScriptObject* CreateObjectMP1(IInputStream& rSCLY, uint32_t& rOutEnd);
+    void LoadObjectBodyMP1(IInputStream& rSCLY);
     CScriptObject* LoadObjectMP1(IInputStream& rSCLY);
     std::unique_ptr<CScriptLayer> LoadLayerMP1(IInputStream& rSCLY);
 
     void LoadStructMP2(IInputStream& rSCLY, CStructProperty* pStruct);
+    CScriptObject* CreateObjectMP2(IInputStream& rSCLY, uint32_t& rOutEnd);
+    void LoadObjectBodyMP2(IInputStream& rSCLY);
     CScriptObject* LoadObjectMP2(IInputStream& rSCLY);
     std::unique_ptr<CScriptLayer> LoadLayerMP2(IInputStream& rSCLY);
 
 public:
     static std::unique_ptr<CScriptLayer> LoadLayer(IInputStream& rSCLY, CGameArea *pArea, EGame Version);
-    static CScriptObject* LoadInstance(IInputStream& rSCLY, CGameArea *pArea, CScriptLayer *pLayer, EGame Version, bool ForceReturnsFormat);
+    static CScriptObject* LoadInstance(IInputStream& rSCLY, CGameArea *pArea, CScriptLayer *pLayer, EGame Version, bool ForceReturnsFormat, CInstanceID NewInstanceID = {});
     static void LoadStructData(IInputStream& rInput, CStructRef InStruct);
 };
 
@@ -18,11 +18,44 @@ void CSkeletonLoader::SetLocalBoneCoords(CBone *pBone)
         pBone->mLocalPosition = pBone->mPosition;
 }
 
-void CSkeletonLoader::CalculateBoneInverseBindMatrices()
+void CSkeletonLoader::BuildFlatHierarchy()
 {
-    for (auto& bone : mpSkeleton->mBones)
+    // Walk the hierarchy breadth-first from the root so every parent lands before its children
+    CSkeleton::SFlatHierarchy& rFlat = mpSkeleton->mFlat;
+    rFlat = CSkeleton::SFlatHierarchy();
+
+    if (mpSkeleton->mpRootBone == nullptr)
+        return;
+
+    std::vector<CBone*> Order;
+    std::vector<int32_t> Parents;
+    Order.reserve(mpSkeleton->mBones.size());
+    Parents.reserve(mpSkeleton->mBones.size());
+    Order.push_back(mpSkeleton->mpRootBone);
+    Parents.push_back(-1);
+
+    for (size_t iBone = 0; iBone < Order.size(); iBone++)
+    {
+        for (CBone* pChild : Order[iBone]->mChildren)
+        {
+            Order.push_back(pChild);
+            Parents.push_back(static_cast<int32_t>(iBone));
+        }
+    }
+
+    const size_t NumBones = Order.size();
+    rFlat.BoneIDs.reserve(NumBones);
+    rFlat.LocalPositions.reserve(NumBones);
+    rFlat.InvBindTranslations.reserve(NumBones);
+    rFlat.IsRoot.reserve(NumBones);
+    rFlat.ParentIndices = std::move(Parents);
+
+    for (const CBone* pBone : Order)
     {
-        bone->mInvBind = CTransform4f::TranslationMatrix(-bone->Position());
+        rFlat.BoneIDs.push_back(pBone->mID);
+        rFlat.LocalPositions.push_back(pBone->mLocalPosition);
+        rFlat.InvBindTranslations.push_back(-pBone->mPosition);
+        rFlat.IsRoot.push_back(pBone->IsRoot() ? 1 : 0);
     }
 }
 
@@ -111,7 +144,7 @@ std::unique_ptr<CSkeleton> CSkeletonLoader::LoadCINF(IInputStream& rCINF, CResou
     }
 
     Loader.SetLocalBoneCoords(ptr->mpRootBone);
-    Loader.CalculateBoneInverseBindMatrices();
+    Loader.BuildFlatHierarchy();
 
     // Skip bone ID array
     const auto NumBoneIDs = rCINF.ReadU32();
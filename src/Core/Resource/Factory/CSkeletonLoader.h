@@ -18,7 +18,7 @@ class CSkeletonLoader
 
     CSkeletonLoader() = default;
     void SetLocalBoneCoords(CBone *pBone);
-    void CalculateBoneInverseBindMatrices();
+    void BuildFlatHierarchy();
 
 public:
     static std::unique_ptr<CSkeleton> LoadCINF(IInputStream& rCINF, CResourceEntry *pEntry);
@@ -1,6 +1,14 @@
 #include "Core/Resource/Model/CBasicModel.h"
 
+#include "Core/Resource/Area/CGameArea.h"
+#include "Core/Resource/Factory/CModelLoader.h"
+#include "Core/Resource/Model/CModel.h"
 #include "Core/Resource/Model/SSurface.h"
+#include "Core/GameProject/CResourceEntry.h"
+#include <Common/FileIO/CFileInStream.h>
+#include <Common/Log.h>
+
+#include <algorithm>
 
 CBasicModel::CBasicModel(CResourceEntry *pEntry)
     : CResource(pEntry)
@@ -16,6 +24,22 @@ CBasicModel::~CBasicModel()
         delete surface;
 }
 
+SResourceMemoryUsage CBasicModel::MemoryUsage() const
+{
+    SResourceMemoryUsage Usage{.NumResources = 1};
+    Usage.CPUBytes = mVBO.ClientMemoryUsage();
+    Usage.GPUBytes = mVBO.GPUMemoryUsage();
+
+    // Shared surfaces are counted by the model that owns them
+    if (mHasOwnSurfaces)
+    {
+        for (const SSurface *pSurf : mSurfaces)
+            Usage.CPUBytes += pSurf->MemoryUsage();
+    }
+
+    return Usage;
+}
+
 const CAABox& CBasicModel::GetSurfaceAABox(size_t Surface) const
 {
     return GetSurface(Surface)->AABox;
@@ -30,3 +54,74 @@ const SSurface* CBasicModel::GetSurface(size_t Surface) const
 {
     return mSurfaces[Surface];
 }
+
+bool CBasicModel::HasFullGeometry() const
+{
+    return std::none_of(mSurfaces.begin(), mSurfaces.end(), [](const SSurface* pkSurf) {
+        return pkSurf->Compacted;
+    });
+}
+
+bool CBasicModel::EnsureFullGeometry()
+{
+    if (HasFullGeometry())
+        return true;
+
+    // World models share surfaces with the area's merged terrain, so the area restores all of them at once
+    if (mpSourceArea != nullptr)
+        return mpSourceArea->RestoreWorldGeometry();
+
+    CResourceEntry *pEntry = Entry();
+
+    if (pEntry == nullptr || Type() != EResourceType::Model)
+    {
+        NLog::Error("Unable to restore compacted geometry for a model with no source resource");
+        return false;
+    }
+
+    CFileInStream File(pEntry->CookedAssetPath(), std::endian::big);
+
+    if (!File.IsValid())
+    {
+        NLog::Error("{}: Unable to open model to restore compacted geometry", *pEntry->CookedAssetPath());
+        return false;
+    }
+
+    const auto pSource = CModelLoader::LoadCMDL(File, nullptr);
+
+    if (!pSource || pSource->GetSurfaceCount() != mSurfaces.size())
+    {
+        NLog::Error("{}: Reloaded model doesn't match the compacted one", *pEntry->CookedAssetPath());
+        return false;
+    }
+
+    for (size_t iSurf = 0; iSurf < mSurfaces.size(); iSurf++)
+    {
+        if (mSurfaces[iSurf]->Compacted)
+            mSurfaces[iSurf]->RestoreVertices(*pSource->GetSurface(iSurf));
+    }
+
+    return true;
+}
+
+void CBasicModel::ReleaseClientGeometry()
+{
+    if (smGeometryResidency == EGeometryResidency::Full)
+        return;
+
+    // The vertex buffer's attribute arrays are only needed for the upload
+    mVBO.ReleaseClientData();
+
+    // World geometry is shared between the area's models, so the area decides when it can be compacted
+    if (mpSourceArea != nullptr)
+    {
+        mpSourceArea->CompactWorldGeometry();
+        return;
+    }
+
+    if (!mHasOwnSurfaces)
+        return;
+
+    for (SSurface *pSurf : mSurfaces)
+        pSurf->CompactToPositions();
+}
@@ -5,11 +5,22 @@
 #include "Core/OpenGL/CVertexBuffer.h"
 #include <Common/Math/CAABox.h>
 
+class CGameArea;
 struct SSurface;
 
+/** How much CPU-side geometry models keep once they've been uploaded to the GPU */
+enum class EGeometryResidency
+{
+    Full,           // Keep every vertex attribute resident (required for editing and export)
+    PositionsOnly   // Keep only vertex positions for picking; full data is reloaded on demand
+};
+
 class CBasicModel : public CResource
 {
     DECLARE_RESOURCE_TYPE(Model)
+
+    static inline EGeometryResidency smGeometryResidency = EGeometryResidency::Full;
+
 protected:
     CAABox mAABox;
     uint32_t mVertexCount = 0;
@@ -21,6 +32,11 @@ protected:
     CVertexBuffer mVBO;
     std::vector<SSurface*> mSurfaces;
 
+    // Area that owns this model's surfaces, if any. World geometry is reloaded from the area.
+    CGameArea *mpSourceArea = nullptr;
+
+    void ReleaseClientGeometry();
+
 public:
     explicit CBasicModel(CResourceEntry *pEntry = nullptr);
     ~CBasicModel() override;
@@ -33,7 +49,14 @@ public:
     const CAABox& GetSurfaceAABox(size_t Surface) const;
     SSurface* GetSurface(size_t Surface);
     const SSurface* GetSurface(size_t Surface) const;
+    bool HasFullGeometry() const;
+    bool EnsureFullGeometry();
+    SResourceMemoryUsage MemoryUsage() const override;
+    void SetSourceArea(CGameArea *pArea)    { mpSourceArea = pArea; }
     virtual void ClearGLBuffer() = 0;
+
+    static EGeometryResidency GeometryResidency()                 { return smGeometryResidency; }
+    static void SetGeometryResidency(EGeometryResidency Residency) { smGeometryResidency = Residency; }
 };
 
 #endif // CBASICMODEL_H
@@ -49,10 +49,29 @@ std::unique_ptr<CDependencyTree> CModel::BuildDependencyTree()
     return pTree;
 }
 
+SResourceMemoryUsage CModel::MemoryUsage() const
+{
+    SResourceMemoryUsage Usage = CBasicModel::MemoryUsage();
+
+    for (const auto& surfaceIBOs : mSurfaceIndexBuffers)
+    {
+        for (const auto& ibo : surfaceIBOs)
+        {
+            Usage.CPUBytes += ibo.ClientMemoryUsage();
+            Usage.GPUBytes += ibo.GPUMemoryUsage();
+        }
+    }
+
+    return Usage;
+}
+
 void CModel::BufferGL()
 {
     if (!mBuffered)
     {
+        if (!EnsureFullGeometry())
+            return;
+
         mVBO.Clear();
         mSurfaceIndexBuffers.clear();
 
@@ -97,7 +116,9 @@ void CModel::BufferGL()
                 ibo.Buffer();
         }
 
+        mVBO.Buffer();
         mBuffered = true;
+        ReleaseClientGeometry();
     }
 }
 
@@ -134,6 +155,10 @@ void CModel::DrawSurface(FRenderOptions Options, size_t Surface, size_t MatSet)
     if (!mBuffered)
         BufferGL();
 
+    // Compacted geometry that couldn't be restored has nothing to draw
+    if (!mBuffered)
+        return;
+
     // Check that mat set index is valid
     if (MatSet >= mMaterialSets.size())
         MatSet = mMaterialSets.size() - 1;
@@ -31,6 +31,7 @@ public:
     ~CModel() override;
 
     std::unique_ptr<CDependencyTree> BuildDependencyTree() override;
+    SResourceMemoryUsage MemoryUsage() const override;
     void BufferGL();
     void GenerateMaterialShaders();
     void ClearGLBuffer() override;
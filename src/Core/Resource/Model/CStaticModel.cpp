@@ -6,6 +6,8 @@
 #include "Core/Render/CRenderer.h"
 #include "Core/Resource/CMaterial.h"
 #include "Core/Resource/Model/SSurface.h"
+#include <Common/Math/CFrustumPlanes.h>
+#include <Common/Math/CTransform4f.h>
 
 CStaticModel::CStaticModel()
     : CBasicModel(nullptr)
@@ -29,9 +31,25 @@ void CStaticModel::AddSurface(SSurface *pSurface)
     mTriangleCount += pSurface->TriangleCount;
 }
 
+SResourceMemoryUsage CStaticModel::MemoryUsage() const
+{
+    SResourceMemoryUsage Usage = CBasicModel::MemoryUsage();
+
+    for (const auto& ibo : mIBOs)
+    {
+        Usage.CPUBytes += ibo.ClientMemoryUsage();
+        Usage.GPUBytes += ibo.GPUMemoryUsage();
+    }
+
+    for (const auto& offsets : mSurfaceEndOffsets)
+        Usage.CPUBytes += offsets.capacity() * sizeof(uint32_t);
+
+    return Usage;
+}
+
 void CStaticModel::BufferGL()
 {
-    if (mBuffered)
+    if (mBuffered || !EnsureFullGeometry())
         return;
 
     mVBO.Clear();
@@ -87,6 +105,7 @@ void CStaticModel::BufferGL()
         ibo.Buffer();
 
     mBuffered = true;
+    ReleaseClientGeometry();
 }
 
 void CStaticModel::GenerateMaterialShaders()
@@ -141,11 +160,95 @@ void CStaticModel::Draw(FRenderOptions Options)
     mVBO.Unbind();
 }
 
+void CStaticModel::DrawCulled(FRenderOptions Options, const CFrustumPlanes& rkFrustum, const CTransform4f& rkTransform)
+{
+    if (!mBuffered)
+        BufferGL();
+
+    if (!mBuffered)
+        return;
+
+    // Cull surfaces individually, then draw the index ranges of the visible ones. Ranges of
+    // consecutive visible surfaces are contiguous in the IBO, so they collapse into one range.
+    std::vector<std::vector<uint32_t>> RangeOffsets(mIBOs.size());
+    std::vector<std::vector<GLsizei>> RangeSizes(mIBOs.size());
+    size_t NumVisible = 0;
+
+    for (size_t iSurf = 0; iSurf < mSurfaces.size(); iSurf++)
+    {
+        if (!rkFrustum.BoxInFrustum(mSurfaces[iSurf]->AABox.Transformed(rkTransform)))
+            continue;
+
+        NumVisible++;
+
+        for (size_t iIBO = 0; iIBO < mIBOs.size(); iIBO++)
+        {
+            const uint32_t Offset = (iSurf > 0 ? mSurfaceEndOffsets[iIBO][iSurf - 1] : 0);
+            const uint32_t Size = mSurfaceEndOffsets[iIBO][iSurf] - Offset;
+
+            if (Size == 0)
+                continue;
+
+            std::vector<uint32_t>& rOffsets = RangeOffsets[iIBO];
+            std::vector<GLsizei>& rSizes = RangeSizes[iIBO];
+
+            if (!rOffsets.empty() && rOffsets.back() + rSizes.back() == Offset)
+                rSizes.back() += static_cast<GLsizei>(Size);
+            else
+            {
+                rOffsets.push_back(Offset);
+                rSizes.push_back(static_cast<GLsizei>(Size));
+            }
+        }
+    }
+
+    if (NumVisible == 0)
+        return;
+
+    if (NumVisible == mSurfaces.size())
+    {
+        Draw(Options);
+        return;
+    }
+
+    mVBO.Bind();
+    glLineWidth(1.f);
+
+    const auto DoDraw = [&]
+    {
+        for (size_t iIBO = 0; iIBO < mIBOs.size(); iIBO++)
+        {
+            if (!RangeOffsets[iIBO].empty())
+                mIBOs[iIBO].MultiDrawElements(RangeOffsets[iIBO].data(), RangeSizes[iIBO].data(), RangeOffsets[iIBO].size());
+        }
+    };
+
+    // Bind material
+    if (Options.HasFlag(ERenderOption::NoMaterialSetup))
+    {
+        DoDraw();
+    }
+    else
+    {
+        for (CMaterial* passMat = mpMaterial; passMat != nullptr; passMat = passMat->GetNextDrawPass())
+        {
+            passMat->SetCurrent(Options);
+            DoDraw();
+        }
+    }
+
+    mVBO.Unbind();
+}
+
 void CStaticModel::DrawSurface(FRenderOptions Options, uint32_t Surface)
 {
     if (!mBuffered)
         BufferGL();
 
+    // Compacted geometry that couldn't be restored has nothing to draw
+    if (!mBuffered)
+        return;
+
     mVBO.Bind();
     glLineWidth(1.f);
 
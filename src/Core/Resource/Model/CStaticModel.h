@@ -6,8 +6,10 @@
 #include "Core/Render/FRenderOptions.h"
 #include <vector>
 
+class CFrustumPlanes;
 class CIndexBuffer;
 class CMaterial;
+class CTransform4f;
 
 /* A CStaticModel is meant for meshes that don't move. It only links to one material,
  * and is used to combine surfaces from different world models into shared VBOs and
@@ -20,15 +22,20 @@ class CStaticModel : public CBasicModel
     bool mTransparent = false;
 
 public:
+    // Static models use 16-bit indices, so one model can't hold more vertices than this
+    static constexpr uint32_t skMaxVertices = 0xFFFF;
+
     CStaticModel();
     explicit CStaticModel(CMaterial *pMat);
     ~CStaticModel() override;
     void AddSurface(SSurface *pSurface);
+    SResourceMemoryUsage MemoryUsage() const override;
 
     void BufferGL();
     void GenerateMaterialShaders();
     void ClearGLBuffer() override;
     void Draw(FRenderOptions Options);
+    void DrawCulled(FRenderOptions Options, const CFrustumPlanes& rkFrustum, const CTransform4f& rkTransform);
     void DrawSurface(FRenderOptions Options, uint32_t Surface);
     void DrawWireframe(FRenderOptions Options, CColor WireColor = CColor::White());
 
@@ -2,6 +2,48 @@
 #include "Core/Render/CDrawUtil.h"
 #include "Core/CRayCollisionTester.h"
 #include <Common/Math/MathUtil.h>
+#include <Common/Macros.h>
+
+size_t SSurface::MemoryUsage() const
+{
+    size_t Bytes = sizeof(SSurface) + Primitives.capacity() * sizeof(SPrimitive);
+
+    for (const SPrimitive& rkPrim : Primitives)
+        Bytes += rkPrim.Vertices.capacity() * sizeof(CVertex) + rkPrim.Positions.capacity() * sizeof(CVector3f);
+
+    return Bytes;
+}
+
+void SSurface::CompactToPositions()
+{
+    if (Compacted)
+        return;
+
+    for (auto& prim : Primitives)
+    {
+        prim.Positions.resize(prim.Vertices.size());
+
+        for (size_t iVert = 0; iVert < prim.Vertices.size(); iVert++)
+            prim.Positions[iVert] = prim.Vertices[iVert].Position;
+
+        std::vector<CVertex>().swap(prim.Vertices);
+    }
+
+    Compacted = true;
+}
+
+void SSurface::RestoreVertices(SSurface& rSource)
+{
+    ASSERT(rSource.Primitives.size() == Primitives.size());
+
+    for (size_t iPrim = 0; iPrim < Primitives.size(); iPrim++)
+    {
+        Primitives[iPrim].Vertices = std::move(rSource.Primitives[iPrim].Vertices);
+        std::vector<CVector3f>().swap(Primitives[iPrim].Positions);
+    }
+
+    Compacted = false;
+}
 
 std::pair<bool,float> SSurface::IntersectsRay(const CRay& rkRay, bool AllowBackfaces, float LineThreshold) const
 {
@@ -10,7 +52,7 @@ std::pair<bool,float> SSurface::IntersectsRay(const CRay& rkRay, bool AllowBackf
 
     for (const auto& prim : Primitives)
     {
-        const size_t NumVerts = prim.Vertices.size();
+        const size_t NumVerts = prim.NumVertices();
 
         // Triangles
         if (prim.Type == EPrimitiveType::Triangles || prim.Type == EPrimitiveType::TriangleFan || prim.Type == EPrimitiveType::TriangleStrip)
@@ -30,29 +72,29 @@ std::pair<bool,float> SSurface::IntersectsRay(const CRay& rkRay, bool AllowBackf
                 if (prim.Type == EPrimitiveType::Triangles)
                 {
                     const size_t VertIndex = iTri * 3;
-                    VtxA = prim.Vertices[VertIndex + 0].Position;
-                    VtxB = prim.Vertices[VertIndex + 1].Position;
-                    VtxC = prim.Vertices[VertIndex + 2].Position;
+                    VtxA = prim.VertexPosition(VertIndex + 0);
+                    VtxB = prim.VertexPosition(VertIndex + 1);
+                    VtxC = prim.VertexPosition(VertIndex + 2);
                 }
                 else if (prim.Type == EPrimitiveType::TriangleFan)
                 {
-                    VtxA = prim.Vertices[0].Position;
-                    VtxB = prim.Vertices[iTri + 1].Position;
-                    VtxC = prim.Vertices[iTri + 2].Position;
+                    VtxA = prim.VertexPosition(0);
+                    VtxB = prim.VertexPosition(iTri + 1);
+                    VtxC = prim.VertexPosition(iTri + 2);
                 }
                 else if (prim.Type == EPrimitiveType::TriangleStrip)
                 {
                     if ((iTri & 1) != 0)
                     {
-                        VtxA = prim.Vertices[iTri + 2].Position;
-                        VtxB = prim.Vertices[iTri + 1].Position;
-                        VtxC = prim.Vertices[iTri + 0].Position;
+                        VtxA = prim.VertexPosition(iTri + 2);
+                        VtxB = prim.VertexPosition(iTri + 1);
+                        VtxC = prim.VertexPosition(iTri + 0);
                     }
                     else
                     {
-                        VtxA = prim.Vertices[iTri + 0].Position;
-                        VtxB = prim.Vertices[iTri + 1].Position;
-                        VtxC = prim.Vertices[iTri + 2].Position;
+                        VtxA = prim.VertexPosition(iTri + 0);
+                        VtxB = prim.VertexPosition(iTri + 1);
+                        VtxC = prim.VertexPosition(iTri + 2);
                     }
                 }
 
@@ -86,8 +128,8 @@ std::pair<bool,float> SSurface::IntersectsRay(const CRay& rkRay, bool AllowBackf
 
                 // Get the two vertices that make up the current line
                 const size_t Index = (prim.Type == EPrimitiveType::Lines ? iLine * 2 : iLine);
-                VtxA = prim.Vertices[Index + 0].Position;
-                VtxB = prim.Vertices[Index + 1].Position;
+                VtxA = prim.VertexPosition(Index + 0);
+                VtxB = prim.VertexPosition(Index + 1);
 
                 // Intersection test
                 const auto [intersects, distance] = Math::RayLineIntersection(rkRay, VtxA, VtxB, LineThreshold);
@@ -23,11 +23,29 @@ struct SSurface
     {
         EPrimitiveType Type;
         std::vector<CVertex> Vertices;
+
+        // Vertex positions only; replaces Vertices once the surface has been compacted
+        std::vector<CVector3f> Positions;
+
+        size_t NumVertices() const
+        {
+            return Vertices.empty() ? Positions.size() : Vertices.size();
+        }
+
+        const CVector3f& VertexPosition(size_t Index) const
+        {
+            return Vertices.empty() ? Positions[Index] : Vertices[Index].Position;
+        }
     };
     std::vector<SPrimitive> Primitives;
+    bool Compacted = false;
 
     SSurface() = default;
 
+    size_t MemoryUsage() const;
+    void CompactToPositions();
+    void RestoreVertices(SSurface& rSource);
+
     std::pair<bool,float> IntersectsRay(const CRay& rkRay, bool AllowBackfaces = false, float LineThreshold = 0.02f) const;
 };
 
@@ -1,13 +1,77 @@
 #include "Core/Resource/Script/CGameTemplate.h"
 
 #include <Common/FileUtil.h>
+#include <Common/Log.h>
 #include <Common/Macros.h>
+#include <Common/FileIO/CFileInStream.h>
+#include <Common/FileIO/CFileOutStream.h>
+#include <Common/FileIO/CMemoryInStream.h>
+#include <Common/FileIO/CVectorOutStream.h>
+#include <Common/Hash/CFNV1A.h>
+#include <Common/Serialization/CBinaryReader.h>
+#include <Common/Serialization/CBinaryWriter.h>
 #include <Common/Serialization/CXMLReader.h>
 #include <Common/Serialization/CXMLWriter.h>
+#include "Core/ParallelUtil.h"
+#include "Core/GameProject/CResourceStore.h"
 #include "Core/Resource/Script/NPropertyMap.h"
 
+#include <fstream>
+#include <iterator>
 #include <list>
 #include <ranges>
+#include <vector>
+
+constexpr uint32 gkTemplateCacheMagic = 0x50575443; // "PWTC"
+
+// Bump this whenever the snapshot layout changes
+constexpr uint32 gkTemplateCacheVersion = 1;
+
+/** Template file contents gathered up front by Load, keyed by path relative to the game directory */
+struct CGameTemplate::STemplateSources
+{
+    /** XML files parsed ahead of time on worker threads */
+    std::map<TString, std::unique_ptr<CXMLReader>> XMLFiles;
+
+    /** Serialized templates from the binary snapshot */
+    std::map<TString, std::vector<char>> CachedFiles;
+
+    /** Calls Func with an archive to read the given template from, then releases that source.
+     *  Returns false if nothing was prepared for this path. */
+    template <typename FuncT>
+    bool Read(const TString& kRelPath, EGame Game, FuncT&& Func)
+    {
+        if (const auto Iter = CachedFiles.find(kRelPath); Iter != CachedFiles.end())
+        {
+            {
+                CMemoryInStream Stream(Iter->second.data(), Iter->second.size(), std::endian::little);
+                CBinaryReader Reader(&Stream, CSerialVersion(IArchive::skCurrentArchiveVersion, 0, Game));
+                Func(Reader);
+            }
+            CachedFiles.erase(Iter);
+            return true;
+        }
+
+        if (const auto Iter = XMLFiles.find(kRelPath); Iter != XMLFiles.end() && Iter->second->IsValid())
+        {
+            Func(*Iter->second);
+            XMLFiles.erase(Iter);
+            return true;
+        }
+
+        return false;
+    }
+};
+
+static uint64 HashFileContents(const TString& kPath)
+{
+    std::ifstream File(*kPath, std::ios::binary);
+    const std::vector<char> Data{std::istreambuf_iterator<char>(File), std::istreambuf_iterator<char>()};
+
+    CFNV1A Hash(CFNV1A::EHashLength::k64Bit);
+    Hash.HashData(Data.data(), Data.size());
+    return Hash.GetHash64();
+}
 
 CGameTemplate::CGameTemplate() = default;
 CGameTemplate::~CGameTemplate() = default;
@@ -34,11 +98,63 @@ void CGameTemplate::Load(const TString& kFilePath)
 
     // Load all sub-templates
     const TString gkGameRoot = GetGameDirectory();
+    std::vector<TString> RelPaths;
+
+    for (const auto& Path : std::views::values(mScriptTemplates))
+        RelPaths.push_back(Path.Path);
+
+    for (const auto& Path : std::views::values(mPropertyTemplates))
+        RelPaths.push_back(Path.Path);
+
+    for (const auto& Path : std::views::values(mMiscTemplates))
+        RelPaths.push_back(Path.Path);
+
+    // The snapshot is only valid for this exact set of files with this exact content
+    std::vector<uint64> FileHashes(RelPaths.size());
+    ParallelUtil::ParallelFor(RelPaths.size(), [&](size_t FileIdx) {
+        FileHashes[FileIdx] = HashFileContents(gkGameRoot + RelPaths[FileIdx]);
+    });
 
-    for (auto& [id, path] : mScriptTemplates)
+    CFNV1A SourceHasher(CFNV1A::EHashLength::k64Bit);
+
+    for (size_t FileIdx = 0; FileIdx < RelPaths.size(); FileIdx++)
+    {
+        SourceHasher.HashData(*RelPaths[FileIdx], RelPaths[FileIdx].Size());
+        SourceHasher.HashData(&FileHashes[FileIdx], sizeof(uint64));
+    }
+
+    const uint64 SourceHash = SourceHasher.GetHash64();
+
+    STemplateSources Sources;
+    const bool LoadedFromCache = Internal_LoadCache(Sources, SourceHash);
+
+    if (!LoadedFromCache)
     {
-        const TString AbsPath = gkGameRoot + path.Path;
-        path.pTemplate = std::make_shared<CScriptTemplate>(this, id, AbsPath);
+        // Parsing dominates load time and every file parses independently, so do that up front in parallel.
+        // Building the templates stays serial, since archetypes resolve each other on demand and
+        // every property registers itself with NPropertyMap.
+        std::vector<std::unique_ptr<CXMLReader>> Readers(RelPaths.size());
+        ParallelUtil::ParallelFor(RelPaths.size(), [&](size_t FileIdx) {
+            Readers[FileIdx] = std::make_unique<CXMLReader>(gkGameRoot + RelPaths[FileIdx]);
+        });
+
+        for (size_t FileIdx = 0; FileIdx < RelPaths.size(); FileIdx++)
+            Sources.XMLFiles.insert_or_assign(RelPaths[FileIdx], std::move(Readers[FileIdx]));
+    }
+
+    mpLoadSources = &Sources;
+
+    for (auto& Entry : mScriptTemplates)
+    {
+        SScriptTemplatePath& Path = Entry.second;
+        const TString AbsPath = gkGameRoot + Path.Path;
+
+        const bool Prepared = Sources.Read(Path.Path, mGame, [&](IArchive& Arc) {
+            Path.pTemplate = std::make_shared<CScriptTemplate>(this, Entry.first, AbsPath, Arc);
+        });
+
+        if (!Prepared)
+            Path.pTemplate = std::make_shared<CScriptTemplate>(this, Entry.first, AbsPath);
     }
 
     // For properties, remember that property archetypes can reference other archetypes which
@@ -54,8 +170,19 @@ void CGameTemplate::Load(const TString& kFilePath)
     for (auto& MiscPath : std::views::values(mMiscTemplates))
     {
         const TString AbsPath = gkGameRoot + MiscPath.Path;
-        MiscPath.pTemplate = std::make_shared<CScriptTemplate>(this, UINT32_MAX, AbsPath);
+
+        const bool Prepared = Sources.Read(MiscPath.Path, mGame, [&](IArchive& Arc) {
+            MiscPath.pTemplate = std::make_shared<CScriptTemplate>(this, UINT32_MAX, AbsPath, Arc);
+        });
+
+        if (!Prepared)
+            MiscPath.pTemplate = std::make_shared<CScriptTemplate>(this, UINT32_MAX, AbsPath);
     }
+
+    mpLoadSources = nullptr;
+
+    if (!LoadedFromCache)
+        Internal_SaveCache(SourceHash);
 }
 
 void CGameTemplate::Save()
@@ -73,17 +200,123 @@ void CGameTemplate::Internal_LoadPropertyTemplate(SPropertyTemplatePath& Path)
     if (Path.pTemplate != nullptr) // don't load twice
         return;
 
-    const TString kGameDir = GetGameDirectory();
-    const TString kTemplateFilePath = kGameDir + Path.Path;
-    CXMLReader Reader(kTemplateFilePath);
-    ASSERT(Reader.IsValid());
+    const auto LoadArchetype = [&Path](IArchive& Arc) {
+        Arc << SerialParameter("PropertyArchetype", Path.pTemplate);
+    };
 
-    Reader << SerialParameter("PropertyArchetype", Path.pTemplate);
+    // Use the snapshot or pre-parsed file if Load prepared one
+    if (mpLoadSources == nullptr || !mpLoadSources->Read(Path.Path, mGame, LoadArchetype))
+    {
+        const TString kGameDir = GetGameDirectory();
+        const TString kTemplateFilePath = kGameDir + Path.Path;
+        CXMLReader Reader(kTemplateFilePath);
+        ASSERT(Reader.IsValid());
+
+        LoadArchetype(Reader);
+    }
     ASSERT(Path.pTemplate != nullptr);
 
     Path.pTemplate->Initialize(nullptr, nullptr, 0);
 }
 
+TString CGameTemplate::Internal_CachePath() const
+{
+    return GetGameDirectory() + "TemplateCache.bin";
+}
+
+bool CGameTemplate::Internal_LoadCache(STemplateSources& rSources, uint64 SourceHash) const
+{
+    const TString Path = Internal_CachePath();
+
+    if (!FileUtil::Exists(Path))
+        return false;
+
+    CFileInStream File(Path, std::endian::little);
+
+    if (!File.IsValid())
+        return false;
+
+    if (File.ReadU32() != gkTemplateCacheMagic ||
+        File.ReadU32() != gkTemplateCacheVersion ||
+        File.ReadU32() != static_cast<uint32>(IArchive::skCurrentArchiveVersion) ||
+        File.ReadU64() != SourceHash)
+    {
+        return false;
+    }
+
+    const uint32 NumEntries = File.ReadU32();
+
+    for (uint32 EntryIdx = 0; EntryIdx < NumEntries; EntryIdx++)
+    {
+        TString RelPath = File.ReadString();
+        std::vector<char> Data(File.ReadU32());
+        File.ReadBytes(Data.data(), Data.size());
+        rSources.CachedFiles.insert_or_assign(std::move(RelPath), std::move(Data));
+    }
+
+    NLog::Debug("Loading {} templates from snapshot: {}", NumEntries, *Path);
+    return true;
+}
+
+/** Writes every loaded template to a single binary file, so the next Load can skip parsing the XML */
+void CGameTemplate::Internal_SaveCache(uint64 SourceHash)
+{
+    if (!gTemplatesWritable)
+        return;
+
+    std::vector<std::pair<TString, std::vector<char>>> Entries;
+
+    const auto AddEntry = [&](const TString& kRelPath, auto&& Func) {
+        std::vector<char> Data;
+        {
+            CVectorOutStream Stream(&Data, std::endian::little);
+            CBinaryWriter Writer(&Stream, CSerialVersion(IArchive::skCurrentArchiveVersion, 0, mGame));
+            Func(Writer);
+        }
+        Entries.emplace_back(kRelPath, std::move(Data));
+    };
+
+    for (auto& Path : std::views::values(mScriptTemplates))
+    {
+        if (Path.pTemplate)
+            AddEntry(Path.Path, [&](IArchive& Arc) { Path.pTemplate->Serialize(Arc); });
+    }
+
+    for (auto& Path : std::views::values(mPropertyTemplates))
+    {
+        if (Path.pTemplate)
+            AddEntry(Path.Path, [&](IArchive& Arc) { Arc << SerialParameter("PropertyArchetype", Path.pTemplate); });
+    }
+
+    for (auto& Path : std::views::values(mMiscTemplates))
+    {
+        if (Path.pTemplate)
+            AddEntry(Path.Path, [&](IArchive& Arc) { Path.pTemplate->Serialize(Arc); });
+    }
+
+    const TString CachePath = Internal_CachePath();
+    CFileOutStream File(CachePath, std::endian::little);
+
+    if (!File.IsValid())
+    {
+        NLog::Warn("Couldn't write template snapshot to {}", *CachePath);
+        return;
+    }
+
+    File.WriteU32(gkTemplateCacheMagic);
+    File.WriteU32(gkTemplateCacheVersion);
+    File.WriteU32(static_cast<uint32>(IArchive::skCurrentArchiveVersion));
+    File.WriteU64(SourceHash);
+    File.WriteU32(static_cast<uint32>(Entries.size()));
+
+    for (const auto& [RelPath, Data] : Entries)
+    {
+        File.WriteString(RelPath);
+        File.WriteU32(static_cast<uint32>(Data.size()));
+        File.WriteBytes(Data.data(), Data.size());
+    }
+}
+
 void CGameTemplate::SaveGameTemplates(bool ForceAll)
 {
     const TString kGameDir = GetGameDirectory();
@@ -82,9 +82,18 @@ class CGameTemplate
     std::map<SObjId, TString> mStates;
     std::map<SObjId, TString> mMessages;
 
+    /** Template file contents gathered up front by Load; only set while Load is running */
+    struct STemplateSources;
+    STemplateSources* mpLoadSources = nullptr;
+
     /** Internal function for loading a property template from a file. */
     void Internal_LoadPropertyTemplate(SPropertyTemplatePath& Path);
 
+    /** Internal functions for the binary template snapshot */
+    TString Internal_CachePath() const;
+    bool Internal_LoadCache(STemplateSources& rSources, uint64_t SourceHash) const;
+    void Internal_SaveCache(uint64_t SourceHash);
+
 public:
     CGameTemplate();
     ~CGameTemplate();
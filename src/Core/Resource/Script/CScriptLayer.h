@@ -15,6 +15,7 @@ class CScriptLayer
     bool mActive = true;
     bool mVisible = true;
     std::vector<CScriptObject*> mInstances;
+    mutable uint32_t mAreaIndex = UINT32_MAX; // Last known slot in the area's layer list
 
 public:
     explicit CScriptLayer(CGameArea *pArea)
@@ -100,10 +101,17 @@ public:
 
     uint32_t AreaIndex() const
     {
+        // The cached slot is checked before use, so it stays correct if layers are ever moved
+        if (mAreaIndex < mpArea->NumScriptLayers() && mpArea->ScriptLayer(mAreaIndex) == this)
+            return mAreaIndex;
+
         for (uint32_t iLyr = 0; iLyr < mpArea->NumScriptLayers(); iLyr++)
         {
             if (mpArea->ScriptLayer(iLyr) == this)
+            {
+                mAreaIndex = iLyr;
                 return iLyr;
+            }
         }
 
         return UINT32_MAX;
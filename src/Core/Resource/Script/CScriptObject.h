@@ -28,10 +28,12 @@ class CScriptObject
 {
     friend class CScriptLoader;
     friend class CAreaLoader;
+    friend class CScriptTemplate;
 
     CScriptTemplate *mpTemplate;
     CGameArea *mpArea;
     CScriptLayer *mpLayer;
+    uint32_t mTemplateIndex = UINT32_MAX; // Slot in the template's object list
     uint32_t mVersion = 0;
 
     CInstanceID mInstanceID;
@@ -78,6 +80,7 @@ public:
 
     // Accessors
     CScriptTemplate* Template() const               { return mpTemplate; }
+    uint32_t TemplateIndex() const                  { return mTemplateIndex; }
     CGameTemplate* GameTemplate() const;
     CGameArea* Area() const                         { return mpArea; }
     CScriptLayer* Layer() const                     { return mpLayer; }
@@ -87,6 +90,7 @@ public:
 
     void* PropertyData()                            { return mPropertyData.data(); }
     const void* PropertyData() const                { return mPropertyData.data(); }
+    size_t PropertyDataSize() const                 { return mPropertyData.size(); }
 
     size_t NumLinks(ELinkType Type) const { return (Type == ELinkType::Incoming ? mInLinks.size() : mOutLinks.size()); }
     CLink* Link(ELinkType Type, size_t Index) const { return (Type == ELinkType::Incoming ? mInLinks[Index] : mOutLinks[Index]); }
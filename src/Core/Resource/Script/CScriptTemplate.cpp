@@ -30,10 +30,24 @@ CScriptTemplate::CScriptTemplate(CGameTemplate* pInGame, uint32 InObjectID, cons
     // Load
     CXMLReader Reader(kInFilePath);
     ASSERT(Reader.IsValid());
-    Serialize(Reader);
+    LoadFromArchive(Reader);
+}
+
+CScriptTemplate::CScriptTemplate(CGameTemplate* pInGame, uint32 InObjectID, const TString& kInFilePath, IArchive& rArc)
+    : mSourceFile(kInFilePath)
+    , mObjectID(InObjectID)
+    , mpGame(pInGame)
+{
+    LoadFromArchive(rArc);
+}
+
+CScriptTemplate::~CScriptTemplate() = default;
+
+void CScriptTemplate::LoadFromArchive(IArchive& rArc)
+{
+    Serialize(rArc);
 
     // Post load initialization
-    mSourceFile = kInFilePath;
     mpProperties->Initialize(nullptr, this, 0);
 
     if (!mNameIDString.IsEmpty())               mpNameProperty = TPropCast<CStringProperty>( mpProperties->ChildByIDString(mNameIDString) );
@@ -44,8 +58,6 @@ CScriptTemplate::CScriptTemplate(CGameTemplate* pInGame, uint32 InObjectID, cons
     if (!mLightParametersIDString.IsEmpty())    mpLightParametersProperty = TPropCast<CStructProperty>( mpProperties->ChildByIDString(mLightParametersIDString) );
 }
 
-CScriptTemplate::~CScriptTemplate() = default;
-
 void CScriptTemplate::Serialize(IArchive& Arc)
 {
     Arc << SerialParameter("Modules", mModules, SH_Optional)
@@ -293,33 +305,46 @@ uint32 CScriptTemplate::NumObjects() const
     return mObjectList.size();
 }
 
-const std::list<CScriptObject*>& CScriptTemplate::ObjectList() const
+const std::vector<CScriptObject*>& CScriptTemplate::ObjectList() const
 {
     return mObjectList;
 }
 
+CScriptObject* CScriptTemplate::ObjectByIndex(size_t Index) const
+{
+    return mObjectList[Index];
+}
+
 void CScriptTemplate::AddObject(CScriptObject *pObject)
 {
+    pObject->mTemplateIndex = static_cast<uint32_t>(mObjectList.size());
     mObjectList.push_back(pObject);
 }
 
 void CScriptTemplate::RemoveObject(const CScriptObject *pObject)
 {
-    const auto iter = std::find_if(mObjectList.cbegin(), mObjectList.cend(),
-                                   [pObject](const auto* ptr) { return ptr == pObject; });
+    const uint32_t Index = pObject->mTemplateIndex;
 
-    if (iter == mObjectList.cend())
+    if (Index >= mObjectList.size() || mObjectList[Index] != pObject)
         return;
 
-    mObjectList.erase(iter);
+    // Move the last object into the vacated slot, so removal stays O(1). This doesn't keep the list
+    // in order; the instances view sorts its rows itself.
+    CScriptObject *pLast = mObjectList.back();
+    pLast->mTemplateIndex = Index;
+    mObjectList[Index] = pLast;
+    mObjectList.pop_back();
 }
 
 void CScriptTemplate::SortObjects()
 {
     // todo: make this function take layer names into account
-    mObjectList.sort([](CScriptObject *pA, CScriptObject *pB) -> bool {
+    std::sort(mObjectList.begin(), mObjectList.end(), [](const CScriptObject *pA, const CScriptObject *pB) -> bool {
         return (pA->InstanceID() < pB->InstanceID());
     });
+
+    for (size_t iObj = 0; iObj < mObjectList.size(); iObj++)
+        mObjectList[iObj]->mTemplateIndex = static_cast<uint32_t>(iObj);
 }
 
 template <>
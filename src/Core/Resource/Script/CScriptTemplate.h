@@ -7,7 +7,6 @@
 #include <Common/Serialization/IArchive.h>
 #include "Core/Resource/Script/EVolumeShape.h"
 
-#include <list>
 #include <memory>
 #include <vector>
 
@@ -108,7 +107,7 @@ private:
     TIDString mLightParametersIDString;
 
     CGameTemplate* mpGame = nullptr;
-    std::list<CScriptObject*> mObjectList;
+    std::vector<CScriptObject*> mObjectList; // Each object stores its own slot, so removal needs no search
 
     CStringProperty* mpNameProperty = nullptr;
     CVectorProperty* mpPositionProperty = nullptr;
@@ -140,6 +139,8 @@ public:
     explicit CScriptTemplate(CGameTemplate *pGame);
     // New constructor
     CScriptTemplate(CGameTemplate* pGame, uint32_t ObjectID, const TString& kFilePath);
+    // Loads from an already-open archive instead of reading kFilePath
+    CScriptTemplate(CGameTemplate* pGame, uint32_t ObjectID, const TString& kFilePath, IArchive& rArc);
     ~CScriptTemplate();
     void Serialize(IArchive& rArc);
     void Save(bool Force = false);
@@ -178,12 +179,14 @@ public:
 
     // Object Tracking
     uint32_t NumObjects() const;
-    const std::list<CScriptObject*>& ObjectList() const;
+    const std::vector<CScriptObject*>& ObjectList() const;
+    CScriptObject* ObjectByIndex(size_t Index) const;
     void AddObject(CScriptObject *pObject);
     void RemoveObject(const CScriptObject *pObject);
     void SortObjects();
 
 private:
+    void LoadFromArchive(IArchive& rArc);
     int32_t CheckVolumeConditions(CScriptObject *pObj, bool LogErrors);
 };
 
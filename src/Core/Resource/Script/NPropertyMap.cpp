@@ -3,12 +3,20 @@
 #include "Core/GameProject/CResourceStore.h"
 #include "Core/Resource/Script/NGameList.h"
 #include "Core/Resource/Script/Property/IProperty.h"
+#include "Core/CFlatIndexTable.h"
+#include <Common/FileUtil.h>
 #include <Common/Log.h>
+#include <Common/NBasics.h>
+#include <Common/FileIO/CFileInStream.h>
+#include <Common/FileIO/CFileOutStream.h>
 #include <Common/Serialization/CXMLReader.h>
 #include <Common/Serialization/CXMLWriter.h>
 
+#include <algorithm>
+#include <deque>
 #include <map>
 #include <set>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -97,47 +105,109 @@ struct SNameKey
     }
 };
 
-/** Hasher for name keys for use in std::unordered_map */
-struct KeyHash
+/** Serialized form of a map value; only used when reading or writing the XML */
+struct SNameXMLValue
 {
-    size_t operator()(const SNameKey& kKey) const noexcept
+    TString Name;
+
+    void Serialize(IArchive& Arc)
     {
-        return std::hash<uint64>()(kKey.Key);
+        Arc << SerialParameter("Name", Name, SH_Attribute);
     }
 };
 
 /** Value structure for name map lookups */
 struct SNameValue
 {
-    /** Name of the property */
-    TString Name;
+    /** ID/type key this value is stored under */
+    SNameKey Key;
+
+    /** Name of the property; interned, so the pointer stays valid for the lifetime of the map */
+    const TString* pName;
 
     /** Whether this name is valid */
     bool IsValid;
 
     /** List of all properties using this ID */
-    /** @todo - make this an intrusively linked list */
-    std::set<IProperty*> PropertyList;
-
-    void Serialize(IArchive& Arc)
-    {
-        Arc << SerialParameter("Name", Name, SH_Attribute);
-    }
-
-    friend bool operator==(const SNameValue& kLHS, const SNameValue& kRHS)
-    {
-        return kLHS.Name == kRHS.Name;
-    }
+    std::vector<IProperty*> PropertyList;
 };
 
-/** Mapping of property IDs to names. In the key, the upper 32 bits
- *  are the type, and the lower 32 bits are the ID.
+/** Interned name strings. A deque so existing names never move when new ones are added. */
+std::deque<TString> gNamePool;
+CFlatIndexTable gNamePoolIndex;
+
+/** Mapping of property IDs to names, stored densely and indexed by key.
+ *  In the key, the upper 32 bits are the type, and the lower 32 bits are the ID.
  */
-std::map<SNameKey, SNameValue> gNameMap;
+std::vector<SNameValue> gNameValues;
+CFlatIndexTable gNameIndex;
 
 /** Legacy map that only includes the ID in the key */
 std::map<uint32_t, TString> gLegacyNameMap;
 
+uint64 HashName(std::string_view Name)
+{
+    return std::hash<std::string_view>()(Name);
+}
+
+/** Returns the pooled copy of a name, adding it to the pool if needed */
+const TString* InternName(std::string_view Name)
+{
+    const uint64 Hash = HashName(Name);
+    const uint32 Index = gNamePoolIndex.Find(Hash, [&](uint32 PoolIdx) {
+        return std::string_view(*gNamePool[PoolIdx], gNamePool[PoolIdx].Size()) == Name;
+    });
+
+    if (Index != CFlatIndexTable::skNotFound)
+        return &gNamePool[Index];
+
+    gNamePool.emplace_back(Name);
+    gNamePoolIndex.Insert(Hash, static_cast<uint32>(gNamePool.size() - 1));
+    return &gNamePool.back();
+}
+
+/** Internal: Returns the value for the given key, or nullptr. Pointers are invalidated by AddValue. */
+SNameValue* FindValue(const SNameKey& kKey)
+{
+    const uint32 Index = gNameIndex.Find(kKey.Key, [&](uint32 ValueIdx) {
+        return gNameValues[ValueIdx].Key == kKey;
+    });
+
+    return Index != CFlatIndexTable::skNotFound ? &gNameValues[Index] : nullptr;
+}
+
+/** Internal: Adds a value for a key that isn't in the map yet */
+SNameValue& AddValue(const SNameKey& kKey, std::string_view Name, bool IsValid)
+{
+    ASSERT(FindValue(kKey) == nullptr);
+    gNameIndex.Insert(kKey.Key, static_cast<uint32>(gNameValues.size()));
+    return gNameValues.emplace_back(SNameValue{kKey, InternName(Name), IsValid, {}});
+}
+
+/** Internal: Rebuilds the key index after values were removed or rekeyed. If two values
+ *  end up with the same key, the first one is kept.
+ */
+void RebuildIndex()
+{
+    gNameIndex.Clear();
+    gNameIndex.Reserve(gNameValues.size());
+    size_t NumKept = 0;
+
+    for (size_t ValueIdx = 0; ValueIdx < gNameValues.size(); ValueIdx++)
+    {
+        if (FindValue(gNameValues[ValueIdx].Key) != nullptr)
+            continue;
+
+        if (NumKept != ValueIdx)
+            gNameValues[NumKept] = std::move(gNameValues[ValueIdx]);
+
+        gNameIndex.Insert(gNameValues[NumKept].Key.Key, static_cast<uint32>(NumKept));
+        NumKept++;
+    }
+
+    gNameValues.resize(NumKept);
+}
+
 /** Internal: Creates a name key for the given property. */
 SNameKey CreateKey(const IProperty* pProperty)
 {
@@ -151,6 +221,150 @@ SNameKey CreateKey(uint32_t ID, std::string_view typeName)
 {
     return SNameKey(CCRC32::StaticHashString(typeName), ID);
 }
+
+/** Binary copy of the map, so startup doesn't have to parse the XML. Stamped with the XML's
+ *  size and modification time, and regenerated whenever they no longer match.
+ */
+constexpr char gpkBinaryMapPath[] = "templates/PropertyMap.bin";
+constexpr uint32 gkBinaryMapMagic = 0x5057504D; // "PWPM"
+
+// Bump this whenever the file layout changes
+constexpr uint32 gkBinaryMapVersion = 1;
+
+std::pair<uint64, uint64> XMLMapStamp()
+{
+    const TString XMLPath = gDataDir + gpkMapPath;
+    return {static_cast<uint64>(FileUtil::FileSize(XMLPath)), static_cast<uint64>(FileUtil::LastModifiedTime(XMLPath))};
+}
+
+bool LoadBinaryMap()
+{
+    const TString Path = gDataDir + gpkBinaryMapPath;
+
+    if (!FileUtil::Exists(Path))
+        return false;
+
+    CFileInStream File(Path, std::endian::little);
+
+    if (!File.IsValid())
+        return false;
+
+    if (File.ReadU32() != gkBinaryMapMagic || File.ReadU32() != gkBinaryMapVersion)
+        return false;
+
+    const auto [XMLSize, XMLTime] = XMLMapStamp();
+
+    if (File.ReadU64() != XMLSize || File.ReadU64() != XMLTime)
+        return false;
+
+    const uint32 NumTypes = File.ReadU32();
+
+    for (uint32 TypeIdx = 0; TypeIdx < NumTypes; TypeIdx++)
+    {
+        const uint32 TypeHash = File.ReadU32();
+        gHashToTypeName.insert_or_assign(TypeHash, File.ReadString());
+    }
+
+    const uint32 NumNames = File.ReadU32();
+    std::vector<const TString*> Names(NumNames);
+
+    for (uint32 NameIdx = 0; NameIdx < NumNames; NameIdx++)
+        Names[NameIdx] = InternName(*File.ReadString());
+
+    const uint32 NumValues = File.ReadU32();
+    gNameValues.reserve(NumValues);
+    gNameIndex.Reserve(NumValues);
+
+    for (uint32 ValueIdx = 0; ValueIdx < NumValues; ValueIdx++)
+    {
+        const uint32 TypeHash = File.ReadU32();
+        const uint32 ID = File.ReadU32();
+        const uint32 NameIdx = File.ReadU32();
+        const bool IsValid = File.ReadU8() != 0;
+
+        if (NameIdx >= NumNames)
+            return false;
+
+        const SNameKey Key(TypeHash, ID);
+        gNameIndex.Insert(Key.Key, static_cast<uint32>(gNameValues.size()));
+        gNameValues.push_back(SNameValue{Key, Names[NameIdx], IsValid, {}});
+    }
+
+    return true;
+}
+
+void SaveBinaryMap()
+{
+    if (!gTemplatesWritable)
+        return;
+
+    const TString Path = gDataDir + gpkBinaryMapPath;
+    CFileOutStream File(Path, std::endian::little);
+
+    if (!File.IsValid())
+    {
+        NLog::Warn("Couldn't write binary property map to {}", *Path);
+        return;
+    }
+
+    const auto [XMLSize, XMLTime] = XMLMapStamp();
+    File.WriteU32(gkBinaryMapMagic);
+    File.WriteU32(gkBinaryMapVersion);
+    File.WriteU64(XMLSize);
+    File.WriteU64(XMLTime);
+
+    File.WriteU32(static_cast<uint32>(gHashToTypeName.size()));
+
+    for (const auto& [TypeHash, TypeName] : gHashToTypeName)
+    {
+        File.WriteU32(TypeHash);
+        File.WriteString(TypeName);
+    }
+
+    // Only names that are in use get written; the pool can hold names that were since replaced
+    std::unordered_map<const TString*, uint32> NameIndices;
+    std::vector<const TString*> Names;
+
+    for (const SNameValue& kValue : gNameValues)
+    {
+        if (NameIndices.try_emplace(kValue.pName, static_cast<uint32>(Names.size())).second)
+            Names.push_back(kValue.pName);
+    }
+
+    File.WriteU32(static_cast<uint32>(Names.size()));
+
+    for (const TString* pkName : Names)
+        File.WriteString(*pkName);
+
+    File.WriteU32(static_cast<uint32>(gNameValues.size()));
+
+    for (const SNameValue& kValue : gNameValues)
+    {
+        File.WriteU32(kValue.Key.TypeHash);
+        File.WriteU32(kValue.Key.ID);
+        File.WriteU32(NameIndices[kValue.pName]);
+        File.WriteU8(kValue.IsValid ? 1 : 0);
+    }
+}
+
+/** Internal: Converts the XML representation into the flat map */
+void LoadXMLMap()
+{
+    std::map<SNameKey, SNameXMLValue> XMLMap;
+    CXMLReader Reader(gDataDir + gpkMapPath);
+    ASSERT(Reader.IsValid());
+    Reader << SerialParameter("PropertyMap", XMLMap, SH_HexDisplay);
+
+    gNameValues.reserve(XMLMap.size());
+    gNameIndex.Reserve(XMLMap.size());
+
+    for (const auto& [key, value] : XMLMap)
+    {
+        // Set up the valid flags
+        const bool IsValid = CalculatePropertyID(value.Name, gHashToTypeName[key.TypeHash]) == key.ID;
+        AddValue(key, value.Name, IsValid);
+    }
+}
 } // Anonymous namespace
 
 /** Loads property names into memory */
@@ -167,14 +381,12 @@ void LoadMap()
     }
     else
     {
-        CXMLReader Reader(gDataDir + gpkMapPath);
-        ASSERT(Reader.IsValid());
-        Reader << SerialParameter("PropertyMap", gNameMap, SH_HexDisplay);
-
-        // Iterate over the map and set up the valid flags
-        for (auto& [key, value] : gNameMap)
+        if (!LoadBinaryMap())
         {
-            value.IsValid = CalculatePropertyID(value.Name, gHashToTypeName[key.TypeHash]) == key.ID;
+            gNameValues.clear();
+            gNameIndex.Clear();
+            LoadXMLMap();
+            SaveBinaryMap();
         }
     }
 
@@ -220,14 +432,24 @@ void SaveMap(bool Force)
             // This mostly occurs when type names are changed - unneeded pairings with the old type can be left in the map
             NGameList::LoadAllGameTemplates();
 
-            std::erase_if(gNameMap, [](const auto& entry) {
-                return entry.second.PropertyList.empty();
+            std::erase_if(gNameValues, [](const SNameValue& kValue) {
+                return kValue.PropertyList.empty();
             });
+            RebuildIndex();
 
-            // Perform the actual save
-            CXMLWriter Writer(gDataDir + gpkMapPath, "PropertyMap");
-            ASSERT(Writer.IsValid());
-            Writer << SerialParameter("PropertyMap", gNameMap, SH_HexDisplay);
+            // Perform the actual save, sorted by key so the file stays stable between saves
+            std::map<SNameKey, SNameXMLValue> XMLMap;
+
+            for (const SNameValue& kValue : gNameValues)
+                XMLMap.emplace(kValue.Key, SNameXMLValue{*kValue.pName});
+
+            {
+                CXMLWriter Writer(gDataDir + gpkMapPath, "PropertyMap");
+                ASSERT(Writer.IsValid());
+                Writer << SerialParameter("PropertyMap", XMLMap, SH_HexDisplay);
+            }
+
+            SaveBinaryMap();
         }
         gMapIsDirty = false;
     }
@@ -245,9 +467,8 @@ const char* GetPropertyName(const IProperty* pInProperty)
     }
     else
     {
-        const SNameKey Key = CreateKey(pInProperty);
-        const auto MapFind = gNameMap.find(Key);
-        return MapFind == gNameMap.end() ? "Unknown" : *MapFind->second.Name;
+        const SNameValue* pkValue = FindValue(CreateKey(pInProperty));
+        return pkValue == nullptr ? "Unknown" : **pkValue->pName;
     }
 }
 
@@ -259,9 +480,8 @@ const char* GetPropertyName(uint32_t ID, std::string_view typeName)
     // Does not support legacy map
     ConditionalLoadMap();
 
-    const SNameKey Key = CreateKey(ID, typeName);
-    const auto MapFind = gNameMap.find(Key);
-    return MapFind == gNameMap.cend() ? "Unknown" : *MapFind->second.Name;
+    const SNameValue* pkValue = FindValue(CreateKey(ID, typeName));
+    return pkValue == nullptr ? "Unknown" : **pkValue->pName;
 }
 
 /** Calculate the property ID of a given name/type. */
@@ -276,15 +496,13 @@ uint32_t CalculatePropertyID(std::string_view name, std::string_view typeName)
 /** Returns whether the specified ID is in the map. */
 bool IsValidPropertyID(uint32_t ID, std::string_view typeName, bool* pOutIsValid /*= nullptr*/)
 {
-    const SNameKey Key = CreateKey(ID, typeName);
-    const auto MapFind = gNameMap.find(Key);
+    const SNameValue* pkValue = FindValue(CreateKey(ID, typeName));
 
-    if (MapFind != gNameMap.cend())
+    if (pkValue != nullptr)
     {
         if (pOutIsValid != nullptr)
         {
-            SNameValue& Value = MapFind->second;
-            *pOutIsValid = Value.IsValid;
+            *pOutIsValid = pkValue->IsValid;
         }
         return true;
     }
@@ -292,32 +510,42 @@ bool IsValidPropertyID(uint32_t ID, std::string_view typeName, bool* pOutIsValid
     return false;
 }
 
+/** Retrieves every ID registered with the given type name. */
+std::vector<std::pair<uint32_t, bool>> RetrieveIDsWithType(std::string_view typeName)
+{
+    const uint32_t TypeHash = CCRC32::StaticHashString(typeName);
+    std::vector<std::pair<uint32_t, bool>> Out;
+
+    for (const SNameValue& kValue : gNameValues)
+    {
+        if (kValue.Key.TypeHash == TypeHash)
+            Out.emplace_back(kValue.Key.ID, kValue.IsValid);
+    }
+
+    return Out;
+}
+
 /** Retrieves a list of all properties that match the requested property ID. */
 std::vector<IProperty*> RetrievePropertiesWithID(uint32_t ID, std::string_view typeName)
 {
-    const SNameKey Key = CreateKey(ID, typeName);
-    const auto MapFind = gNameMap.find(Key);
+    const SNameValue* pkValue = FindValue(CreateKey(ID, typeName));
 
-    if (MapFind == gNameMap.cend())
+    if (pkValue == nullptr)
         return {};
 
-    const SNameValue& Value = MapFind->second;
-    return std::vector(Value.PropertyList.begin(), Value.PropertyList.end());
+    return pkValue->PropertyList;
 }
 
 /** Retrieves a list of all XML templates that contain a given property ID. */
 std::set<TString> RetrieveXMLsWithProperty(uint32_t ID, std::string_view typeName)
 {
-    const SNameKey Key = CreateKey(ID, typeName);
-    const auto MapFind = gNameMap.find(Key);
+    const SNameValue* pkValue = FindValue(CreateKey(ID, typeName));
 
-    if (MapFind == gNameMap.cend())
+    if (pkValue == nullptr)
         return {};
 
-    const SNameValue& NameValue = MapFind->second;
-
     std::set<TString> OutSet;
-    for (const auto* pProperty : NameValue.PropertyList)
+    for (const auto* pProperty : pkValue->PropertyList)
     {
         OutSet.insert(pProperty->GetTemplateFileName());
     }
@@ -339,28 +567,25 @@ void SetPropertyName(uint32_t ID, std::string_view typeName, std::string_view ne
     }
     else
     {
-        const SNameKey Key = CreateKey(ID, typeName);
-        auto MapFind = gNameMap.find(Key);
+        SNameValue* pValue = FindValue(CreateKey(ID, typeName));
 
-        if (MapFind == gNameMap.cend())
+        if (pValue == nullptr)
             return;
 
-        SNameValue& Value = MapFind->second;
-
-        if (Value.Name == newName)
+        if (*pValue->pName == newName)
             return;
 
-        const TString OldName = std::move(Value.Name);
-        Value.Name = TString(newName);
+        const TString& OldName = *pValue->pName;
+        pValue->pName = InternName(newName);
         gMapIsDirty = true;
 
         // Update all properties with this ID with the new name
-        for (IProperty* pIterProperty : Value.PropertyList)
+        for (IProperty* pIterProperty : pValue->PropertyList)
         {
             // If the property overrides the name, then don't change it.
             if (pIterProperty->Name() == OldName)
             {
-                pIterProperty->SetName(Value.Name);
+                pIterProperty->SetName(*pValue->pName);
             }
         }
     }
@@ -393,29 +618,26 @@ void ChangeTypeName(IProperty* pProperty, std::string_view oldTypeName, std::str
 
             // Disassociate this property from the old mapping.
             bool WasRegistered = false;
-            auto Find = gNameMap.find(OldKey);
 
-            if (Find != gNameMap.cend())
+            if (const SNameValue* pkOldValue = FindValue(OldKey))
             {
-                SNameValue& Value = Find->second;
-                WasRegistered = Value.PropertyList.contains(pProperty);
+                WasRegistered = std::ranges::find(pkOldValue->PropertyList, pProperty) != pkOldValue->PropertyList.end();
             }
 
             // Create a key for the new property and add it to the list.
-            Find = gNameMap.find(NewKey);
+            SNameValue* pNewValue = FindValue(NewKey);
 
-            if (Find == gNameMap.cend())
+            if (pNewValue == nullptr)
             {
-                SNameValue Value;
-                Value.Name = pProperty->Name();
-                Value.IsValid = CalculatePropertyID(Value.Name, newTypeName) == pProperty->ID();
-                Find = gNameMap.insert_or_assign(NewKey, std::move(Value)).first;
+                const TString& kName = pProperty->Name();
+                const bool IsValid = CalculatePropertyID(kName, newTypeName) == pProperty->ID();
+                pNewValue = &AddValue(NewKey, kName, IsValid);
             }
-            ASSERT(Find != gNameMap.cend());
+            ASSERT(pNewValue != nullptr);
 
             if (WasRegistered)
             {
-                Find->second.PropertyList.insert(pProperty);
+                NBasics::VectorAddUnique(pNewValue->PropertyList, pProperty);
             }
 
             gMapIsDirty = true;
@@ -436,28 +658,25 @@ void ChangeTypeNameGlobally(std::string_view oldTypeName, std::string_view newTy
         return;
     }
 
-    // The process here is basically to find all properties with a matching typename
-    // hash and update the hashes to the new type. Not 100% sure if this is the best
-    // way to go about doing it. From what I understand, insert() does not invalidate
-    // iterators, and extract() only invalidates the iterator being extracted. So this
-    // implementation should work correctly.
-    for (auto MapIter = gNameMap.begin(); MapIter != gNameMap.end(); ++MapIter)
+    // Find all properties with a matching typename hash and update the hashes to the new type,
+    // then rebuild the index once. Entries that now collide with an existing key are dropped.
+    bool AnyChanged = false;
+
+    for (SNameValue& rValue : gNameValues)
     {
-        if (MapIter->first.TypeHash == OldTypeHash)
+        if (rValue.Key.TypeHash == OldTypeHash)
         {
-            auto PrevIter = MapIter;
-            --PrevIter;
-
-            auto MapNode = gNameMap.extract(MapIter);
-            MapIter = PrevIter;
-
-            SNameKey& Key = MapNode.key();
-            Key.TypeHash = NewTypeHash;
-            gNameMap.insert(std::move(MapNode));
-            gMapIsDirty = true;
+            rValue.Key.TypeHash = NewTypeHash;
+            AnyChanged = true;
         }
     }
 
+    if (AnyChanged)
+    {
+        RebuildIndex();
+        gMapIsDirty = true;
+    }
+
     RegisterTypeName(NewTypeHash, TString(newTypeName));
     gHashToTypeName.insert_or_assign(NewTypeHash, TString(newTypeName));
 }
@@ -473,80 +692,73 @@ void RegisterProperty(IProperty* pProperty)
 
     // Just need to register the property in the list.
     SNameKey Key = CreateKey(pProperty);
-    auto MapFind = gNameMap.find(Key);
+    SNameValue* pValue = FindValue(Key);
 
     if constexpr (gkUseLegacyMapForNameLookups)
     {
-        // If we are using the legacy map, gNameMap may be empty. We need to retrieve the name
-        // from the legacy map, and create an entry in gNameMap with it.
+        // If we are using the legacy map, the name map may be empty. We need to retrieve the name
+        // from the legacy map, and create an entry in the name map with it.
 
         //@todo this prob isn't the most efficient way to do this
-        if (MapFind == gNameMap.end())
+        if (pValue == nullptr)
         {
             const auto LegacyMapFind = gLegacyNameMap.find(pProperty->ID());
             ASSERT(LegacyMapFind != gLegacyNameMap.cend());
 
-            SNameValue Value;
-            Value.Name = LegacyMapFind->second;
-            Value.IsValid = (CalculatePropertyID(Value.Name, pProperty->HashableTypeName()) == pProperty->ID());
-            pProperty->SetName(Value.Name);
-
-            MapFind = gNameMap.insert_or_assign(Key, Value).first;
-            ASSERT(MapFind != gNameMap.cend());
+            const TString& kName = LegacyMapFind->second;
+            const bool IsValid = (CalculatePropertyID(kName, pProperty->HashableTypeName()) == pProperty->ID());
+            pProperty->SetName(kName);
 
+            pValue = &AddValue(Key, kName, IsValid);
             RegisterTypeName(Key.TypeHash, pProperty->HashableTypeName());
         }
     }
     else
     {
         // If we didn't find the property name, check for int<->choice conversions
-        if (MapFind == gNameMap.cend())
+        if (pValue == nullptr)
         {
             if (pProperty->Type() == EPropertyType::Int)
             {
                 const uint32 ChoiceHash = CCRC32::StaticHashString("choice");
                 const SNameKey ChoiceKey(ChoiceHash, pProperty->ID());
-                MapFind = gNameMap.find(ChoiceKey);
+                pValue = FindValue(ChoiceKey);
             }
             else if (pProperty->Type() == EPropertyType::Choice)
             {
                 const uint32 IntHash = CCRC32::StaticHashString("int");
                 const SNameKey IntKey(IntHash, pProperty->ID());
-                MapFind = gNameMap.find(IntKey);
+                pValue = FindValue(IntKey);
             }
         }
 
         // If we still didn't find it, register the property name in the map
-        if (MapFind == gNameMap.cend())
+        if (pValue == nullptr)
         {
-            SNameValue Value{"Unknown", false, {}};
-            MapFind = gNameMap.insert_or_assign(Key, std::move(Value)).first;
+            pValue = &AddValue(Key, "Unknown", false);
             RegisterTypeName(Key.TypeHash, pProperty->HashableTypeName());
         }
 
-        // We should have a valid iterator at this point no matter what.
-        ASSERT(MapFind != gNameMap.cend());
-        pProperty->SetName(MapFind->second.Name);
+        // We should have a valid value at this point no matter what.
+        ASSERT(pValue != nullptr);
     }
 
-    MapFind->second.PropertyList.insert(pProperty);
+    NBasics::VectorAddUnique(pValue->PropertyList, pProperty);
 
     // Update the property's Name field to match the mapped name.
-    pProperty->SetName(MapFind->second.Name);
+    pProperty->SetName(*pValue->pName);
 }
 
 /** Unregisters a property from the name map. Should be called on all properties that use the map on destruction. */
 void UnregisterProperty(IProperty* pProperty)
 {
-    const SNameKey Key = CreateKey(pProperty);
-    const auto Iter = gNameMap.find(Key);
+    SNameValue* pValue = FindValue(CreateKey(pProperty));
 
-    if (Iter == gNameMap.cend())
+    if (pValue == nullptr)
         return;
 
     // Found the value, now remove the element from the list.
-    SNameValue& Value = Iter->second;
-    Value.PropertyList.erase(pProperty);
+    std::erase(pValue->PropertyList, pProperty);
 }
 
 } // namespace NPropertyMap
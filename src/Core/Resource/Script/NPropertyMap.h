@@ -6,6 +6,7 @@
 #include <cstdint>
 #include <set>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 class IProperty;
@@ -37,6 +38,12 @@ uint32_t CalculatePropertyID(std::string_view name, std::string_view typeName);
  */
 bool IsValidPropertyID(uint32_t ID, std::string_view typeName, bool* pOutIsValid = nullptr);
 
+/**
+ *  Retrieves every ID registered with the given type name.
+ *  The second value of each pair is whether the current name for that ID is correct.
+ */
+std::vector<std::pair<uint32_t, bool>> RetrieveIDsWithType(std::string_view typeName);
+
 /** Retrieves a list of all properties that match the requested property ID. */
 std::vector<IProperty*> RetrievePropertiesWithID(uint32_t ID, std::string_view typeName);
 
@@ -9,7 +9,10 @@
 #include <Common/NBasics.h>
 #include <Common/Hash/CCRC32.h>
 
+#include <algorithm>
+#include <cstring>
 #include <memory>
+#include <string_view>
 #include <thread>
 
 /** Default constructor */
@@ -49,18 +52,15 @@ void CPropertyNameGenerator::Generate(const SPropertyNameGenerationParameters& r
     ASSERT(!mIsRunning);
     ASSERT(rkParams.TypeNames.size() > 0);
     mGeneratedNames.clear();
-    mValidTypePairMap.clear();
     mIsRunning = true;
 
-    // Convert the type pair map.
-    // Also, replace the normal type name list with whatever is in the ID pairs list we were given.
+    // Replace the normal type name list with whatever is in the ID pairs list we were given.
     if (!rkParams.ValidIdPairs.empty())
     {
         mTypeNames.clear();
 
         for (const SPropertyIdTypePair& kPair : rkParams.ValidIdPairs)
         {
-            mValidTypePairMap[ kPair.ID ] = kPair.pkType;
             NBasics::VectorAddUnique( mTypeNames, TString(kPair.pkType) );
         }
     }
@@ -77,6 +77,7 @@ void CPropertyNameGenerator::Generate(const SPropertyNameGenerationParameters& r
 
     // If we haven't loaded the word list yet, load it.
     Warmup();
+    BuildIDLookups(rkParams);
 
     // Calculate the number of steps involved in this task.
     const size_t kNumWords = mWords.size();
@@ -99,7 +100,7 @@ void CPropertyNameGenerator::Generate(const SPropertyNameGenerationParameters& r
         if (i == rkParams.ConcurrentTasks - 1)
         {
             // Ensure last task takes any remaining words
-            Params.EndWord = kNumWords - 1;
+            Params.EndWord = kNumWords;
         }
         else
         {
@@ -115,6 +116,91 @@ void CPropertyNameGenerator::Generate(const SPropertyNameGenerationParameters& r
     mIsRunning = false;
 }
 
+void CPropertyNameGenerator::BuildIDLookups(const SPropertyNameGenerationParameters& rkParams)
+{
+    mTypeLookups.clear();
+    mTypeLookups.resize(mTypeNames.size());
+
+    for (size_t TypeIdx = 0; TypeIdx < mTypeNames.size(); TypeIdx++)
+    {
+        const TString& kTypeName = mTypeNames[TypeIdx];
+        STypeIDLookup& rLookup = mTypeLookups[TypeIdx];
+
+        // With TestIntsAsChoices, int IDs are also tested against the choice hash and reported as int.
+        // Exact matches are added first so they win if an ID is valid as both.
+        const bool TestAsInt = rkParams.TestIntsAsChoices && kTypeName == "choice";
+
+        if (!rkParams.ValidIdPairs.empty())
+        {
+            for (const SPropertyIdTypePair& kPair : rkParams.ValidIdPairs)
+            {
+                if (kTypeName == kPair.pkType)
+                    rLookup.IDs.push_back(kPair);
+            }
+
+            if (TestAsInt)
+            {
+                for (const SPropertyIdTypePair& kPair : rkParams.ValidIdPairs)
+                {
+                    if (strcmp(kPair.pkType, "int") == 0)
+                        rLookup.IDs.push_back(kPair);
+                }
+            }
+        }
+        else
+        {
+            const auto AddMapIDs = [&](std::string_view TypeName, const char* pkReportType)
+            {
+                for (const auto& [ID, IsAlreadyNamed] : NPropertyMap::RetrieveIDsWithType(TypeName))
+                {
+                    if (!IsAlreadyNamed || !rkParams.ExcludeAccuratelyNamedProperties)
+                        rLookup.IDs.push_back(SPropertyIdTypePair{ID, pkReportType});
+                }
+            };
+
+            AddMapIDs(*kTypeName, *kTypeName);
+
+            if (TestAsInt)
+                AddMapIDs("int", "int");
+        }
+
+        std::stable_sort(rLookup.IDs.begin(), rLookup.IDs.end(), [](const auto& rkLeft, const auto& rkRight) {
+            return rkLeft.ID < rkRight.ID;
+        });
+        const auto NewEnd = std::unique(rLookup.IDs.begin(), rLookup.IDs.end(), [](const auto& rkLeft, const auto& rkRight) {
+            return rkLeft.ID == rkRight.ID;
+        });
+        rLookup.IDs.erase(NewEnd, rLookup.IDs.end());
+
+        rLookup.Filter.assign(0x10000 / 64, 0);
+
+        for (const SPropertyIdTypePair& kPair : rLookup.IDs)
+        {
+            const uint32_t Bucket = kPair.ID >> 16;
+            rLookup.Filter[Bucket / 64] |= (1ULL << (Bucket % 64));
+        }
+    }
+}
+
+/** Returns the type to report if ID is valid for the given entry of mTypeNames, or nullptr */
+const char* CPropertyNameGenerator::FindValidID(size_t TypeIndex, uint32_t ID) const
+{
+    const STypeIDLookup& rkLookup = mTypeLookups[TypeIndex];
+    const uint32_t Bucket = ID >> 16;
+
+    if ((rkLookup.Filter[Bucket / 64] & (1ULL << (Bucket % 64))) == 0)
+        return nullptr;
+
+    const auto Iter = std::lower_bound(rkLookup.IDs.begin(), rkLookup.IDs.end(), ID, [](const auto& rkPair, uint32_t ID) {
+        return rkPair.ID < ID;
+    });
+
+    if (Iter == rkLookup.IDs.end() || Iter->ID != ID)
+        return nullptr;
+
+    return Iter->pkType;
+}
+
 void CPropertyNameGenerator::GenerateTask(const SPropertyNameGenerationParameters& rkParams,
                                           SPropertyNameGenerationTaskParameters taskParams,
                                           IProgressNotifier* pProgress)
@@ -131,6 +217,19 @@ void CPropertyNameGenerator::GenerateTask(const SPropertyNameGenerationParameter
     CCRC32 PrefixHash;
     PrefixHash.Hash( *rkParams.Prefix );
 
+    // Word lengths are known up front, so hashing a word never has to scan for its terminator
+    std::vector<std::string_view> WordViews;
+    WordViews.reserve(kNumWords);
+
+    for (const TString& kWord : mWords)
+        WordViews.emplace_back(*kWord, kWord.Size());
+
+    std::vector<std::string_view> TypeViews;
+    TypeViews.reserve(mTypeNames.size());
+
+    for (const TString& kTypeName : mTypeNames)
+        TypeViews.emplace_back(*kTypeName, kTypeName.Size());
+
     // Use a stack to keep track of the current word we are on. We can use this
     // to cache the hash of a word and then re-use it later instead of recaculating
     // the same hashes over and over. Init the stack with the first word.
@@ -178,22 +277,21 @@ void CPropertyNameGenerator::GenerateTask(const SPropertyNameGenerationParameter
 
         for (; RecalcIndex < WordCache.size(); RecalcIndex++)
         {
-            int Index = WordCache[RecalcIndex].WordIndex;
+            const std::string_view kWord = WordViews[WordCache[RecalcIndex].WordIndex];
 
             // For camelcase, hash the first letter of the first word as lowercase
-            if (RecalcIndex == 0 && rkParams.Casing == ENameCasing::camelCase)
+            if (RecalcIndex == 0 && rkParams.Casing == ENameCasing::camelCase && !kWord.empty())
             {
-                const char* pkWord = *mWords[Index];
-                LastValidHash.Hash( TString::CharToLower( pkWord[0] ) );
-                LastValidHash.Hash( &pkWord[1] );
+                LastValidHash.Hash( TString::CharToLower( kWord[0] ) );
+                LastValidHash.Hash( kWord.substr(1) );
             }
             else
             {
                 // Add an underscore for snake case
                 if (RecalcIndex > 0 && rkParams.Casing == ENameCasing::Snake_Case)
-                    LastValidHash.Hash("_");
+                    LastValidHash.Hash('_');
 
-                LastValidHash.Hash( *mWords[Index] );
+                LastValidHash.Hash( kWord );
             }
 
             WordCache[RecalcIndex].Hash = LastValidHash;
@@ -203,15 +301,16 @@ void CPropertyNameGenerator::GenerateTask(const SPropertyNameGenerationParameter
         CCRC32 BaseHash = LastValidHash;
         BaseHash.Hash( *rkParams.Suffix );
 
-        for (const auto& typeName : mTypeNames)
+        for (size_t TypeIdx = 0; TypeIdx < TypeViews.size(); TypeIdx++)
         {
             CCRC32 FullHash = BaseHash;
-            const char* pkTypeName = *typeName;
-            FullHash.Hash(pkTypeName);
+            FullHash.Hash(TypeViews[TypeIdx]);
             const uint32 PropertyID = FullHash.Digest();
 
             // Check if this hash is a property ID
-            if (IsValidPropertyID(PropertyID, pkTypeName, rkParams))
+            const char* pkTypeName = FindValidID(TypeIdx, PropertyID);
+
+            if (pkTypeName != nullptr)
             {
                 std::unique_lock lock{mPropertyCheckMutex};
 
@@ -287,52 +386,6 @@ void CPropertyNameGenerator::GenerateTask(const SPropertyNameGenerationParameter
     }
 }
 
-/** Returns whether a given property ID is valid */
-bool CPropertyNameGenerator::IsValidPropertyID(uint32 ID, const char*& pkType, const SPropertyNameGenerationParameters& rkParams)
-{
-    if (!mValidTypePairMap.empty())
-    {
-        auto Find = mValidTypePairMap.find(ID);
-
-        if (Find != mValidTypePairMap.end())
-        {
-            if (strcmp( Find->second, pkType ) == 0)
-            {
-                return true;
-            }
-            else if (rkParams.TestIntsAsChoices && strcmp(pkType, "choice") == 0)
-            {
-                if (strcmp( Find->second, "int" ) == 0)
-                {
-                    pkType = "int";
-                    return true;
-                }
-            }
-
-            return false;
-        }
-        else
-            return false;
-    }
-    else
-    {
-        bool IsAlreadyNamed;
-        bool IsValid = NPropertyMap::IsValidPropertyID(ID, pkType, &IsAlreadyNamed);
-
-        if (!IsValid && rkParams.TestIntsAsChoices && strcmp(pkType, "choice") == 0)
-        {
-            IsValid = NPropertyMap::IsValidPropertyID(ID, "int", &IsAlreadyNamed);
-
-            if (IsValid)
-            {
-                pkType = "int";
-            }
-        }
-
-        return IsValid && (!IsAlreadyNamed || !rkParams.ExcludeAccuratelyNamedProperties);
-    }
-}
-
 template <>
 const CEnumNameMap TEnumReflection<ENameCasing>::skNameMap = {
     { 0, "PascalCase" },
@@ -9,7 +9,6 @@
 #include <list>
 #include <mutex>
 #include <set>
-#include <unordered_map>
 #include <vector>
 
 class IProgressNotifier;
@@ -96,8 +95,19 @@ class CPropertyNameGenerator
     /** List of valid property types to check against */
     std::vector<TString> mTypeNames;
 
-    /** Mapping of valid ID/type pairs; if empty, all property names in NPropertyMap are allowed */
-    std::unordered_map<uint32_t, const char*> mValidTypePairMap;
+    /** Valid IDs for one entry of mTypeNames. Built before the generation tasks start and
+     *  never modified while they run, so the tasks can test candidates without locking. */
+    struct STypeIDLookup
+    {
+        /** One bit per value of the upper 16 bits of an ID; rejects most candidates without a search */
+        std::vector<uint64_t> Filter;
+
+        /** Valid IDs sorted by ID, with the type name to report for each */
+        std::vector<SPropertyIdTypePair> IDs;
+    };
+
+    /** Per-type ID lookups, parallel to mTypeNames */
+    std::vector<STypeIDLookup> mTypeLookups;
 
     /** List of words */
     std::vector<TString> mWords;
@@ -117,6 +127,9 @@ class CPropertyNameGenerator
     /** Current number of tests performed */
     std::atomic<uint64_t> TotalTestsDone{0};
 
+    void BuildIDLookups(const SPropertyNameGenerationParameters& rkParams);
+    const char* FindValidID(size_t TypeIndex, uint32_t ID) const;
+
     void GenerateTask(const SPropertyNameGenerationParameters& rkParams,
                       SPropertyNameGenerationTaskParameters taskParams,
                       IProgressNotifier* pProgressNotifier);
@@ -131,9 +144,6 @@ public:
     /** Run the name generation system */
     void Generate(const SPropertyNameGenerationParameters& rkParams, IProgressNotifier* pProgressNotifier);
 
-    /** Returns whether a given property ID is valid */
-    bool IsValidPropertyID(uint32_t ID, const char*& pkType, const SPropertyNameGenerationParameters& rkParams);
-
     /** Accessors */
     bool IsRunning() const
     {
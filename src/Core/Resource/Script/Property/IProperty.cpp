@@ -14,6 +14,7 @@
 
 #include <algorithm>
 #include <cfloat>
+#include <numeric>
 
 /** IProperty */
 IProperty::IProperty(EGame Game)
@@ -34,6 +35,31 @@ void IProperty::_ClearChildren()
     }
 
     mChildren.clear();
+    mChildLookupIDs.clear();
+    mChildLookupIndices.clear();
+}
+
+void IProperty::BuildChildLookup()
+{
+    mChildLookupIDs.clear();
+    mChildLookupIndices.clear();
+
+    if (Type() != EPropertyType::Struct)
+        return;
+
+    std::vector<uint32> Order(mChildren.size());
+    std::iota(Order.begin(), Order.end(), 0U);
+
+    // Stable so that duplicate IDs resolve to the first matching child, same as a linear scan
+    std::stable_sort(Order.begin(), Order.end(), [this](uint32 A, uint32 B) {
+        return mChildren[A]->mID < mChildren[B]->mID;
+    });
+
+    mChildLookupIDs.reserve(Order.size());
+    mChildLookupIndices = std::move(Order);
+
+    for (const uint32 ChildIdx : mChildLookupIndices)
+        mChildLookupIDs.push_back(mChildren[ChildIdx]->mID);
 }
 
 IProperty::~IProperty()
@@ -221,6 +247,7 @@ void IProperty::Initialize(IProperty* pInParent, CScriptTemplate* pInTemplate, u
         }
     }
 
+    BuildChildLookup();
     mFlags |= EPropertyFlag::IsInitialized;
 }
 
@@ -244,6 +271,16 @@ const void* IProperty::RawValuePtr(const void* pData) const
 
 IProperty* IProperty::ChildByID(uint32 ID) const
 {
+    if (!mChildLookupIDs.empty() && mChildLookupIDs.size() == mChildren.size())
+    {
+        const auto iter = std::lower_bound(mChildLookupIDs.begin(), mChildLookupIDs.end(), ID);
+
+        if (iter == mChildLookupIDs.cend() || *iter != ID)
+            return nullptr;
+
+        return mChildren[mChildLookupIndices[iter - mChildLookupIDs.begin()]];
+    }
+
     const auto iter = std::find_if(mChildren.begin(), mChildren.end(),
                                    [ID](const auto* element) { return element->mID == ID; });
 
@@ -277,7 +314,7 @@ IProperty* IProperty::ChildByIDString(const TIDString& rkIdString)
     IProperty* pNextChild = ChildByID(NextChildID);
 
     // Check if we need to recurse
-    if (IDEndPos != -1)
+    if (IDEndPos != -1 && pNextChild != nullptr)
     {
         return pNextChild->ChildByIDString(rkIdString.ChopFront(IDEndPos + 1));
     }
@@ -498,6 +535,8 @@ bool IProperty::ConvertType(EPropertyType NewType, IProperty* pNewArchetype)
                 break;
             }
         }
+
+        mpParent->BuildChildLookup();
     }
 
     // Change all our child properties to be parented under the new property. (Is this adoption?)
@@ -508,6 +547,9 @@ bool IProperty::ConvertType(EPropertyType NewType, IProperty* pNewArchetype)
     }
     ASSERT(pNewProperty->mChildren.size() == mChildren.size());
     mChildren.clear();
+    mChildLookupIDs.clear();
+    mChildLookupIndices.clear();
+    pNewProperty->BuildChildLookup();
 
     // Create new versions of all sub-instances that inherit from the new property.
     // Note that when the sub-instances complete their conversion, they delete themselves.
@@ -678,6 +720,10 @@ IProperty* IProperty::CreateIntrinsic(EPropertyType Type,
     pOut->SetName(rkName);
     pOut->Initialize(pParent, nullptr, Offset);
     pParent->mChildren.push_back(pOut);
+
+    if (pParent->IsInitialized())
+        pParent->BuildChildLookup();
+
     return pOut;
 }
 
@@ -136,6 +136,11 @@ protected:
     /** Child properties; these appear underneath this property on the UI */
     std::vector<IProperty*> mChildren;
 
+    /** Child IDs sorted ascending, with the matching indices into mChildren. Built for structs
+     *  once they are initialized so ChildByID can binary search instead of scanning. */
+    std::vector<uint32_t> mChildLookupIDs;
+    std::vector<uint32_t> mChildLookupIndices;
+
     /** Game this property belongs to */
     EGame mGame;
 
@@ -164,6 +169,7 @@ protected:
     /** Private constructor - use static methods to instantiate */
     explicit IProperty(EGame Game);
     void _ClearChildren();
+    void BuildChildLookup();
 
 public:
     virtual ~IProperty();
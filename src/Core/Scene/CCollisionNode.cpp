@@ -1,11 +1,13 @@
 #include "Core/Scene/CCollisionNode.h"
 
+#include "Core/CRayCollisionTester.h"
 #include "Core/SRayIntersection.h"
 #include "Core/Render/CDrawUtil.h"
 #include "Core/Render/CGraphics.h"
 #include "Core/Render/CRenderer.h"
 #include "Core/Resource/Collision/CCollisionMeshGroup.h"
 #include "Core/Scene/CScene.h"
+#include <Common/Math/MathUtil.h>
 
 CCollisionNode::CCollisionNode(CScene *pScene, uint32_t NodeID, CSceneNode *pParent, CCollisionMeshGroup *pCollision)
     : CSceneNode(pScene, NodeID, pParent)
@@ -65,10 +67,7 @@ void CCollisionNode::Draw(FRenderOptions /*Options*/, int /*ComponentIndex*/, ER
         {
             const CCollisionMaterial& kMat = kIndexData.Materials[MatIdx];
 
-            if (rkViewInfo.CollisionSettings.HideMaterial & kMat) 
-                continue;
-
-            if (rkViewInfo.CollisionSettings.HideMask != 0 && (kMat.RawFlags() & rkViewInfo.CollisionSettings.HideMask) != 0)
+            if (rkViewInfo.CollisionSettings.IsMaterialHidden(kMat))
                 continue;
 
             CColor Tint = BaseTint;
@@ -115,17 +114,70 @@ void CCollisionNode::Draw(FRenderOptions /*Options*/, int /*ComponentIndex*/, ER
     }
 }
 
-void CCollisionNode::RayAABoxIntersectTest(CRayCollisionTester& /*rTester*/, const SViewInfo& /*rkViewInfo*/)
+void CCollisionNode::RayAABoxIntersectTest(CRayCollisionTester& rTester, const SViewInfo& rkViewInfo)
 {
-    // todo
+    if (!mpCollision || rkViewInfo.GameMode)
+        return;
+
+    const CRay& rkRay = rTester.Ray();
+
+    if (!AABox().IntersectsRay(rkRay).first)
+        return;
+
+    // Queue each mesh whose bounds are hit for a precise test against its OBB tree
+    const auto Meshes = mpCollision->Meshes();
+
+    for (uint32_t MeshIdx = 0; MeshIdx < Meshes.size(); MeshIdx++)
+    {
+        const auto [intersects, distance] = Meshes[MeshIdx]->Bounds().Transformed(Transform()).IntersectsRay(rkRay);
+
+        if (intersects)
+            rTester.AddNode(this, MeshIdx, distance);
+    }
 }
 
-SRayIntersection CCollisionNode::RayNodeIntersectTest(const CRay& /*rkRay*/, uint32_t /*AssetID*/, const SViewInfo& /*rkViewInfo*/)
+SRayIntersection CCollisionNode::RayNodeIntersectTest(const CRay& rkRay, uint32_t AssetID, const SViewInfo& rkViewInfo)
 {
-    // todo
-    SRayIntersection Result;
-    Result.Hit = false;
-    return Result;
+    SRayIntersection Out;
+    Out.pNode = this;
+    Out.ComponentIndex = AssetID;
+
+    if (!mpCollision || AssetID >= mpCollision->Meshes().size())
+        return Out;
+
+    // Backfaces are pickable whenever they're visible
+    const FRenderOptions Options = rkViewInfo.pRenderer->RenderOptions();
+    const bool AllowBackfaces = rkViewInfo.CollisionSettings.DrawBackfaces ||
+                                mpCollision->Game() == EGame::DKCReturns ||
+                                !Options.HasFlag(ERenderOption::EnableBackfaceCull);
+
+    // Hidden materials aren't drawn, so they shouldn't be pickable either
+    const CCollisionMesh* pMesh = mpCollision->Meshes()[AssetID].get();
+    const SCollisionIndexData& kIndexData = pMesh->GetIndexData();
+    std::vector<bool> HiddenMaterials;
+
+    for (size_t MatIdx = 0; MatIdx < kIndexData.Materials.size(); MatIdx++)
+    {
+        if (rkViewInfo.CollisionSettings.IsMaterialHidden(kIndexData.Materials[MatIdx]))
+        {
+            HiddenMaterials.resize(kIndexData.Materials.size(), false);
+            HiddenMaterials[MatIdx] = true;
+        }
+    }
+
+    const CRay TransformedRay = rkRay.Transformed(Transform().Inverse());
+    const auto [intersects, distance] = pMesh->IntersectsRay(TransformedRay, AllowBackfaces, HiddenMaterials);
+
+    if (intersects)
+    {
+        Out.Hit = true;
+
+        const CVector3f HitPoint = TransformedRay.PointOnRay(distance);
+        const CVector3f WorldHitPoint = Transform() * HitPoint;
+        Out.Distance = Math::Distance(rkRay.Origin(), WorldHitPoint);
+    }
+
+    return Out;
 }
 
 void CCollisionNode::SetCollision(CCollisionMeshGroup *pCollision)
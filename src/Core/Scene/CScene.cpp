@@ -8,6 +8,7 @@
 #include "Core/Resource/CWorld.h"
 #include "Core/Resource/Area/CGameArea.h"
 #include "Core/Resource/Script/CScriptLayer.h"
+#include "Core/Render/CCamera.h"
 #include "Core/Render/CRenderer.h"
 #include "Core/Render/SViewInfo.h"
 #include "Core/Scene/CCollisionNode.h"
@@ -302,6 +303,31 @@ SRayIntersection CScene::SceneRayCast(const CRay& rkRay, const SViewInfo& rkView
     return Tester.TestNodes(rkViewInfo);
 }
 
+// Exact alternative to SceneRayCast: rasterizes the visible scene as IDs around the cursor
+// and reads back what's actually under it. Requires the renderer's GL context to be current.
+SRayIntersection CScene::ScenePick(CRenderer *pRenderer, const SViewInfo& rkViewInfo, const CVector2f& DeviceCoords)
+{
+    AddSceneToRenderer(pRenderer, rkViewInfo);
+    const SPickResult Pick = pRenderer->RenderPickBuffer(rkViewInfo, DeviceCoords);
+
+    if (!Pick.Hit)
+        return SRayIntersection();
+
+    auto *pNode = dynamic_cast<CSceneNode*>(Pick.pRenderable);
+    if (!pNode)
+        return SRayIntersection();
+
+    // Attachments and extras select the script object they belong to, same as a ray cast
+    if (pNode->NodeType() == ENodeType::ScriptAttach || pNode->NodeType() == ENodeType::ScriptExtra)
+        pNode = pNode->Parent();
+
+    const CRay Ray = rkViewInfo.pCamera->CastRay(DeviceCoords);
+    const CVector3f HitPoint = rkViewInfo.pCamera->UnprojectPoint(CVector3f(Pick.DeviceCoords.X, Pick.DeviceCoords.Y, (Pick.Depth * 2.f) - 1.f));
+    const float Distance = Ray.Origin().Distance(HitPoint);
+
+    return SRayIntersection(true, Distance, HitPoint, pNode, static_cast<uint32_t>(Pick.ComponentIndex));
+}
+
 CSceneNode* CScene::NodeByID(uint32_t NodeID)
 {
     const auto it = mNodeMap.find(NodeID);
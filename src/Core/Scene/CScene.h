@@ -28,6 +28,7 @@ class CScriptNode;
 class CScriptObject;
 class CStaticNode;
 class CStaticModel;
+class CVector2f;
 class CWorld;
 
 struct SRayIntersection;
@@ -73,6 +74,7 @@ public:
     void ClearScene();
     void AddSceneToRenderer(CRenderer *pRenderer, const SViewInfo& rkViewInfo);
     SRayIntersection SceneRayCast(const CRay& rkRay, const SViewInfo& rkViewInfo);
+    SRayIntersection ScenePick(CRenderer *pRenderer, const SViewInfo& rkViewInfo, const CVector2f& DeviceCoords);
     CSceneNode* NodeByID(uint32_t NodeID);
     CScriptNode* NodeForInstanceID(CInstanceID ID);
     CScriptNode* NodeForInstance(const CScriptObject *pObj);
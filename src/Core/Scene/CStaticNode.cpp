@@ -93,7 +93,7 @@ void CStaticNode::Draw(FRenderOptions Options, int ComponentIndex, ERenderComman
     LoadModelMatrix();
 
     if (ComponentIndex < 0)
-        mpModel->Draw(Options);
+        mpModel->DrawCulled(Options, rkViewInfo.ViewFrustum, Transform());
     else
         mpModel->DrawSurface(Options, ComponentIndex);
 }
@@ -107,6 +107,17 @@ public:
         return -1;
     }
 
+    /** Approximate heap memory held by the copied nodes, including their serialized instances */
+    size_t MemoryUsage() const
+    {
+        size_t Total = mCopiedNodes.size() * sizeof(SCopiedNode);
+
+        for (const SCopiedNode& rkNode : mCopiedNodes)
+            Total += rkNode.Name.Size() + rkNode.InstanceData.capacity();
+
+        return Total;
+    }
+
     CAssetID AreaID() const                       { return mAreaID; }
     EGame Game() const                            { return mGame; }
     const QList<SCopiedNode>& CopiedNodes() const { return mCopiedNodes; }
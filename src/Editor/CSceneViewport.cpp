@@ -108,22 +108,46 @@ SRayIntersection CSceneViewport::SceneRayCast(const CRay& rkRay)
     }
 
     const SRayIntersection Intersect = mpScene->SceneRayCast(rkRay, mViewInfo);
-    if (Intersect.Hit)
+    UpdateHover(Intersect, rkRay);
+    return Intersect;
+}
+
+SRayIntersection CSceneViewport::ScenePick(const CVector2f& rkDeviceCoords)
+{
+    // ID picking is exact (alpha-tested billboards, actual triangle coverage) but needs the GL context
+    if (!mIDPickingEnabled)
+        return SceneRayCast(mCamera.CastRay(rkDeviceCoords));
+
+    if (mpEditor->Gizmo()->IsTransforming())
+    {
+        ResetHover();
+        return SRayIntersection();
+    }
+
+    makeCurrent();
+    const SRayIntersection Intersect = mpScene->ScenePick(mpRenderer.get(), mViewInfo, rkDeviceCoords);
+    doneCurrent();
+
+    UpdateHover(Intersect, mCamera.CastRay(rkDeviceCoords));
+    return Intersect;
+}
+
+void CSceneViewport::UpdateHover(const SRayIntersection& rkIntersect, const CRay& rkRay)
+{
+    if (rkIntersect.Hit)
     {
         if (mpHoverNode)
             mpHoverNode->SetMouseHovering(false);
 
-        mpHoverNode = Intersect.pNode;
+        mpHoverNode = rkIntersect.pNode;
         mpHoverNode->SetMouseHovering(true);
-        mHoverPoint = rkRay.PointOnRay(Intersect.Distance);
+        mHoverPoint = rkRay.PointOnRay(rkIntersect.Distance);
     }
     else
     {
         mHoverPoint = rkRay.PointOnRay(10.f);
         ResetHover();
     }
-
-    return Intersect;
 }
 
 void CSceneViewport::ResetHover()
@@ -290,7 +314,7 @@ void CSceneViewport::CheckUserInput()
             CheckGizmoInput(Ray);
 
         if (!mpEditor->Gizmo()->IsTransforming())
-            mRayIntersection = SceneRayCast(Ray);
+            mRayIntersection = ScenePick(MouseDeviceCoordinates());
     }
     else
     {
@@ -341,7 +365,7 @@ void CSceneViewport::Paint()
 void CSceneViewport::ContextMenu(QContextMenuEvent *pEvent)
 {
     // mpHoverNode is cleared during mouse input, so this call is necessary. todo: better way?
-    mRayIntersection = SceneRayCast(CastRay());
+    mRayIntersection = ScenePick(MouseDeviceCoordinates());
 
     // Set up actions
     TString NodeName;
@@ -18,6 +18,7 @@ class CSceneViewport : public CBasicViewport
     CScene *mpScene = nullptr;
     std::unique_ptr<CRenderer> mpRenderer;
     bool mRenderingMergedWorld = true;
+    bool mIDPickingEnabled = false;
 
     // Scene interaction
     bool mGizmoHovering = false;
@@ -62,12 +63,17 @@ public:
     void SetScene(INodeEditor *pEditor, CScene *pScene);
     void SetShowWorld(bool Visible);
     void SetRenderMergedWorld(bool RenderMerged);
+    void SetIDPickingEnabled(bool Enable) { mIDPickingEnabled = Enable; }
+    bool IsIDPickingEnabled() const       { return mIDPickingEnabled; }
     FShowFlags ShowFlags() const;
     CRenderer* Renderer();
     CSceneNode* HoverNode();
     const CVector3f& HoverPoint() const;
     void CheckGizmoInput(const CRay& rkRay);
+    // SceneRayCast always casts the given ray. ScenePick tests a screen position, and uses the
+    // ID buffer for it when pixel-accurate picking is enabled.
     SRayIntersection SceneRayCast(const CRay& rkRay);
+    SRayIntersection ScenePick(const CVector2f& rkDeviceCoords);
     void ResetHover();
     bool IsHoveringGizmo() const;
 
@@ -78,6 +84,7 @@ public:
     void SetLinkLine(const CVector3f& rkPointA, const CVector3f& rkPointB)   { mLinkLine.SetPoints(rkPointA, rkPointB); }
 
 protected:
+    void UpdateHover(const SRayIntersection& rkIntersect, const CRay& rkRay);
     void CreateContextMenu();
     QMouseEvent CreateMouseEvent();
     void FindConnectedObjects(CInstanceID InstanceID, bool SearchOutgoing, bool SearchIncoming, QList<CInstanceID>& rIDList);
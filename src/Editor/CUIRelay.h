@@ -6,12 +6,19 @@
 #include "Editor/UICommon.h"
 #include "Editor/WorldEditor/CWorldEditor.h"
 
+#include <QOffscreenSurface>
+#include <QOpenGLContext>
 #include <QThread>
 
+#include <memory>
+
 class CUIRelay : public QObject, public IUIRelay
 {
     Q_OBJECT
 
+    std::unique_ptr<QOffscreenSurface> mpOffscreenSurface;
+    std::unique_ptr<QOpenGLContext> mpOffscreenContext;
+
     static Qt::ConnectionType GetConnectionType()
     {
         const bool IsUIThread = (QThread::currentThread() == gpEdApp->thread());
@@ -53,6 +60,27 @@ public:
         return RetVal;
     }
 
+    // Not deferred; the context has to be current on the thread that asked for it. Only call from the UI thread.
+    bool MakeOffscreenContextCurrent() override
+    {
+        if (!mpOffscreenContext)
+        {
+            mpOffscreenSurface = std::make_unique<QOffscreenSurface>();
+            mpOffscreenSurface->create();
+
+            mpOffscreenContext = std::make_unique<QOpenGLContext>();
+            mpOffscreenContext->setShareContext(QOpenGLContext::globalShareContext());
+
+            if (!mpOffscreenContext->create())
+            {
+                mpOffscreenContext.reset();
+                return false;
+            }
+        }
+
+        return mpOffscreenContext->makeCurrent(mpOffscreenSurface.get());
+    }
+
 private slots:
     void MessageBoxSlot(const QString& rkInfoBoxTitle, const QString& rkMessage)
     {
@@ -31,6 +31,42 @@ IEditor::IEditor(QWidget* pParent)
 
 IEditor::~IEditor() = default;
 
+static size_t UndoCommandMemoryUsage(const QUndoCommand *pkCmd)
+{
+    size_t Usage = 0;
+
+    if (const auto* pkUndoCmd = dynamic_cast<const IUndoCommand*>(pkCmd))
+        Usage += pkUndoCmd->MemoryUsage();
+
+    for (int ChildIdx = 0; ChildIdx < pkCmd->childCount(); ChildIdx++)
+        Usage += UndoCommandMemoryUsage(pkCmd->child(ChildIdx));
+
+    return Usage;
+}
+
+void IEditor::EnforceUndoMemoryBudget()
+{
+    size_t Usage = 0;
+
+    for (int CmdIdx = 0; CmdIdx < mUndoStack.count(); CmdIdx++)
+        Usage += UndoCommandMemoryUsage(mUndoStack.command(CmdIdx));
+
+    if (Usage <= skUndoMemoryBudget)
+        return;
+
+    // QUndoStack can't drop individual commands, so the whole history has to go.
+    // Keep the unsaved changes flag; there's no clean state in the history to return to anymore.
+    NLog::Warn("Undo history is using {} MB; clearing it to stay within {} MB", Usage >> 20, skUndoMemoryBudget >> 20);
+    const bool WasModified = isWindowModified();
+    mUndoStack.clear();
+
+    if (WasModified)
+    {
+        mUndoStack.resetClean();
+        setWindowModified(true);
+    }
+}
+
 QUndoStack& IEditor::UndoStack()
 {
     return mUndoStack;
@@ -116,6 +152,9 @@ void IEditor::OnUndoStackIndexChanged()
     int CurrentIndex = mUndoStack.index();
     int CleanIndex = mUndoStack.cleanIndex();
 
+    // Check the memory budget once the stack has finished pushing
+    QMetaObject::invokeMethod(this, &IEditor::EnforceUndoMemoryBudget, Qt::QueuedConnection);
+
     if (CleanIndex == -1)
     {
         if (!isWindowModified())
@@ -18,6 +18,11 @@ protected:
     QUndoStack mUndoStack;
     QList<QAction*> mUndoActions;
 
+    // Once the undo history holds more than this, it gets cleared
+    static constexpr size_t skUndoMemoryBudget = 128 * 1024 * 1024;
+
+    void EnforceUndoMemoryBudget();
+
 public:
     explicit IEditor(QWidget* pParent);
     ~IEditor() override;
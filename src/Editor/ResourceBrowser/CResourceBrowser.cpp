@@ -915,6 +915,7 @@ void CResourceBrowser::UpdateStore()
     if (mpStore != pNewStore)
     {
         mpStore = pNewStore;
+        mpProxyModel->SetStore(mpStore);
 
         // Clear search
         mpUI->SearchBar->clear();
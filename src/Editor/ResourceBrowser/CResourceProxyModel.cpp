@@ -1,6 +1,7 @@
 #include "Editor/ResourceBrowser/CResourceProxyModel.h"
 
 #include <Core/GameProject/CResourceEntry.h>
+#include <Core/GameProject/CResourceStore.h>
 #include <Core/GameProject/CVirtualDirectory.h>
 #include "Editor/ResourceBrowser/CResourceTableModel.h"
 
@@ -68,7 +69,18 @@ bool CResourceProxyModel::filterAcceptsRow(int SourceRow, const QModelIndex& rkS
         return false;
 
     // Compare search results
-    const bool HasNameMatch = pEntry->UppercaseName().Contains(mSearchString);
+    bool HasNameMatch;
+
+    if (mpStore)
+    {
+        UpdateNameMatches();
+        HasNameMatch = mNameMatches.contains(pEntry);
+    }
+    else
+    {
+        HasNameMatch = pEntry->UppercaseName().Contains(mSearchString);
+    }
+
     if (HasNameMatch)
         return true;
 
@@ -125,10 +137,31 @@ void CResourceProxyModel::SetSortMode(ESortMode Mode)
     }
 }
 
+void CResourceProxyModel::SetStore(CResourceStore *pStore)
+{
+    mpStore = pStore;
+    mNameMatches.clear();
+    mNameMatchGeneration = 0;
+}
+
+/** Refreshes the name matches if the search string or the store's index changed since they were queried */
+void CResourceProxyModel::UpdateNameMatches() const
+{
+    const CResourceSearchIndex& rkIndex = mpStore->SearchIndex();
+
+    if (mNameMatchGeneration != rkIndex.Generation())
+    {
+        mNameMatches = rkIndex.Query(mSearchString);
+        mNameMatchGeneration = rkIndex.Generation();
+    }
+}
+
 // ************ SLOTS ************
 void CResourceProxyModel::SetSearchString(const TString& rkString)
 {
     mSearchString = rkString.ToUpper();
+    mNameMatches.clear();
+    mNameMatchGeneration = 0;
 
     // Check if this is an asset ID
     TString IDString = rkString;
@@ -5,6 +5,10 @@
 
 #include <QSortFilterProxyModel>
 
+#include <unordered_set>
+
+class CResourceEntry;
+class CResourceStore;
 class CResourceTableModel;
 class CResTypeInfo;
 
@@ -31,19 +35,27 @@ public:
     bool IsTypeAccepted(const CResTypeInfo* pTypeInfo) const;
 
     void SetSortMode(ESortMode Mode);
+    void SetStore(CResourceStore *pStore);
 
 public slots:
     void SetSearchString(const TString& rkString);
 
 private:
     CResourceTableModel *mpModel = nullptr;
+    CResourceStore *mpStore = nullptr;
     TString mSearchString;
+
+    // Entries matching mSearchString by name, from the store's search index
+    mutable std::unordered_set<const CResourceEntry*> mNameMatches;
+    mutable uint32_t mNameMatchGeneration = 0;
     ESortMode mSortMode{};
     QSet<const CResTypeInfo*> mTypeFilter;
 
     uint64_t mCompareID = 0;
     uint64_t mCompareMask = 0;
     uint32_t mCompareBitLength = 0;
+
+    void UpdateNameMatches() const;
 };
 
 #endif // CRESOURCEPROXYMODEL
@@ -57,15 +57,21 @@ void CCloneSelectionCommand::redo()
     QList<CSceneNode*> ClonedNodes;
     QList<CInstanceID> ToCloneInstanceIDs;
     QList<CInstanceID> ClonedInstanceIDs;
+    CGameArea *pArea = mpEditor->ActiveArea();
+
+    // Allocate IDs for all clones at once so they end up in one contiguous block
+    const std::vector<CInstanceID> NewIDs = pArea->ReserveInstanceIDs(static_cast<uint32_t>(ToClone.size()));
 
     // Clone nodes
-    for (CSceneNode *pNode : ToClone)
+    for (qsizetype iNode = 0; iNode < ToClone.size(); iNode++)
     {
         mpEditor->NotifyNodeAboutToBeSpawned();
-        CScriptNode *pScript = static_cast<CScriptNode*>(pNode);
+        CScriptNode *pScript = static_cast<CScriptNode*>(ToClone[iNode]);
         CScriptObject *pInstance = pScript->Instance();
+        const CInstanceID NewID = static_cast<size_t>(iNode) < NewIDs.size() ? NewIDs[iNode] : CInstanceID();
 
-        CScriptObject *pCloneInst = mpEditor->ActiveArea()->SpawnInstance(pInstance->Template(), pInstance->Layer());
+        CScriptObject *pCloneInst = pArea->SpawnInstance(pInstance->Template(), pInstance->Layer(), CVector3f::Zero(),
+                                                         CQuaternion::Identity(), CVector3f::One(), NewID);
         pCloneInst->CopyProperties(pInstance);
         pCloneInst->EvaluateProperties();
 
@@ -82,6 +88,8 @@ void CCloneSelectionCommand::redo()
         mpEditor->NotifyNodeSpawned(pCloneNode);
     }
 
+    pArea->CancelInstanceIDs(NewIDs);
+
     // Clone outgoing links from source object; incoming ones are discarded
     for (qsizetype iNode = 0; iNode < ClonedNodes.size(); iNode++)
     {
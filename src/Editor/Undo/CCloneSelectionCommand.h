@@ -21,6 +21,13 @@ public:
     void undo() override;
     void redo() override;
     bool AffectsCleanState() const override { return true; }
+
+    // Clones are made from the live nodes on redo, so only the node references are held
+    size_t MemoryUsage() const override
+    {
+        return (mOriginalSelection.size() + mNodesToClone.size() + mClonedNodes.size()) * sizeof(CNodePtr) +
+               mLinkedInstances.size() * sizeof(CInstancePtr);
+    }
 };
 
 #endif // CCLONESELECTIONCOMMAND_H
@@ -118,6 +118,19 @@ CDeleteSelectionCommand::CDeleteSelectionCommand(CWorldEditor *pEditor, const QS
 
 CDeleteSelectionCommand::~CDeleteSelectionCommand() = default;
 
+size_t CDeleteSelectionCommand::MemoryUsage() const
+{
+    size_t Total = (mOldSelection.size() + mNewSelection.size()) * sizeof(CNodePtr) +
+                   mLinkedInstances.size() * sizeof(CInstancePtr) +
+                   mDeletedNodes.size() * sizeof(SDeletedNode) +
+                   mDeletedLinks.size() * sizeof(SDeletedLink);
+
+    for (const SDeletedNode& rkNode : mDeletedNodes)
+        Total += rkNode.InstanceData.capacity();
+
+    return Total;
+}
+
 void CDeleteSelectionCommand::undo()
 {
     QList<CSceneNode*> NewNodes;
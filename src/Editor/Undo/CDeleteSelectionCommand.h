@@ -30,6 +30,7 @@ public:
     void undo() override;
     void redo() override;
     bool AffectsCleanState() const override { return true; }
+    size_t MemoryUsage() const override;
 };
 
 #endif // CDELETESELECTIONCOMMAND_H
@@ -9,6 +9,8 @@
 #include <QCoreApplication>
 #include <QClipboard>
 
+#include <algorithm>
+
 CPasteNodesCommand::CPasteNodesCommand(CWorldEditor *pEditor, CScriptLayer *pLayer, const CVector3f& PastePoint)
     : IUndoCommand(QCoreApplication::translate("CPasteNodesCommand", "Paste"))
     , mpEditor(pEditor)
@@ -22,6 +24,14 @@ CPasteNodesCommand::CPasteNodesCommand(CWorldEditor *pEditor, CScriptLayer *pLay
 
 CPasteNodesCommand::~CPasteNodesCommand() = default;
 
+size_t CPasteNodesCommand::MemoryUsage() const
+{
+    // The command keeps its own copy of the clipboard so redo works after the clipboard changes
+    return (mPastedNodes.size() + mOriginalSelection.size()) * sizeof(CNodePtr) +
+           mLinkedInstances.size() * sizeof(CInstancePtr) +
+           (mpMimeData ? mpMimeData->MemoryUsage() : 0);
+}
+
 void CPasteNodesCommand::undo()
 {
     mpEditor->Selection()->SetSelectedNodes(mOriginalSelection.DereferenceList());
@@ -51,14 +61,20 @@ void CPasteNodesCommand::redo()
     CGameArea *pArea = mpEditor->ActiveArea();
     QList<CSceneNode*> PastedNodes;
 
+    // Allocate IDs for every pasted instance up front so they end up in one contiguous block
+    const auto NumInstances = std::ranges::count(rkNodes, ENodeType::Script, &CNodeCopyMimeData::SCopiedNode::Type);
+    const std::vector<CInstanceID> NewIDs = pArea->ReserveInstanceIDs(static_cast<uint32_t>(NumInstances));
+    size_t NextID = 0;
+
     for (const CNodeCopyMimeData::SCopiedNode& rkNode : rkNodes)
     {
         CSceneNode *pNewNode = nullptr;
 
         if (rkNode.Type == ENodeType::Script)
         {
+            const CInstanceID NewID = NextID < NewIDs.size() ? NewIDs[NextID++] : CInstanceID();
             CMemoryInStream In(rkNode.InstanceData.data(), rkNode.InstanceData.size(), std::endian::big);
-            CScriptObject *pInstance = CScriptLoader::LoadInstance(In, pArea, mpLayer, pArea->Game(), false);
+            CScriptObject *pInstance = CScriptLoader::LoadInstance(In, pArea, mpLayer, pArea->Game(), false, NewID);
             pArea->AddInstanceToArea(pInstance);
             mpLayer->AddInstance(pInstance);
 
@@ -87,6 +103,8 @@ void CPasteNodesCommand::redo()
         }
     }
 
+    pArea->CancelInstanceIDs(NewIDs);
+
     // Fix links. This is how fixes are prioritized:
     // 1. If the link receiver has also been copied then redirect to the copied version.
     // 2. If we're pasting into the same area that this data was copied from and the receiver still exists, connect to original receiver.
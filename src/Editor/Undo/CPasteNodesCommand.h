@@ -29,6 +29,7 @@ public:
     void redo() override;
 
     bool AffectsCleanState() const override { return true; }
+    size_t MemoryUsage() const override;
 };
 
 #endif // CPASTENODESCOMMAND
@@ -0,0 +1,101 @@
+#include "Editor/Undo/CUndoDelta.h"
+
+#include <algorithm>
+
+void CUndoDelta::AddRun(size_t Offset, std::span<const char> OldBytes, std::span<const char> NewBytes)
+{
+    SRun& rRun = mRuns.emplace_back();
+    rRun.Offset = static_cast<uint32_t>(Offset);
+    rRun.OldSize = static_cast<uint32_t>(OldBytes.size());
+    rRun.NewSize = static_cast<uint32_t>(NewBytes.size());
+    rRun.DataOffset = static_cast<uint32_t>(mBytes.size());
+    mBytes.insert(mBytes.end(), OldBytes.begin(), OldBytes.end());
+    mBytes.insert(mBytes.end(), NewBytes.begin(), NewBytes.end());
+}
+
+CUndoDelta CUndoDelta::Compute(std::span<const char> Old, std::span<const char> New)
+{
+    CUndoDelta Delta;
+    Delta.mOldSize = static_cast<uint32_t>(Old.size());
+    Delta.mNewSize = static_cast<uint32_t>(New.size());
+
+    if (Old.size() == New.size())
+    {
+        size_t Pos = 0;
+
+        while (Pos < Old.size())
+        {
+            if (Old[Pos] == New[Pos])
+            {
+                Pos++;
+                continue;
+            }
+
+            // Extend the run until there's a long enough stretch of unchanged bytes to end it
+            const size_t Start = Pos;
+            size_t End = Pos + 1;
+            size_t NumEqual = 0;
+
+            while (Pos + 1 < Old.size() && NumEqual < skMinGap)
+            {
+                Pos++;
+
+                if (Old[Pos] == New[Pos])
+                {
+                    NumEqual++;
+                }
+                else
+                {
+                    NumEqual = 0;
+                    End = Pos + 1;
+                }
+            }
+
+            Delta.AddRun(Start, Old.subspan(Start, End - Start), New.subspan(Start, End - Start));
+            Pos = End;
+        }
+    }
+    else
+    {
+        const size_t MinSize = std::min(Old.size(), New.size());
+        size_t Prefix = 0;
+        size_t Suffix = 0;
+
+        while (Prefix < MinSize && Old[Prefix] == New[Prefix])
+            Prefix++;
+
+        while (Suffix < MinSize - Prefix && Old[Old.size() - 1 - Suffix] == New[New.size() - 1 - Suffix])
+            Suffix++;
+
+        Delta.AddRun(Prefix, Old.subspan(Prefix, Old.size() - Prefix - Suffix), New.subspan(Prefix, New.size() - Prefix - Suffix));
+    }
+
+    Delta.mRuns.shrink_to_fit();
+    Delta.mBytes.shrink_to_fit();
+    return Delta;
+}
+
+/** Rebuilds the new state from the old one (ToNew) or the other way around.
+ *  Returns false if Source isn't the size of the state this delta was computed from. */
+bool CUndoDelta::Apply(std::span<const char> Source, bool ToNew, std::vector<char>& rOut) const
+{
+    if (Source.size() != (ToNew ? mOldSize : mNewSize))
+        return false;
+
+    rOut.clear();
+    rOut.reserve(ToNew ? mNewSize : mOldSize);
+    size_t Pos = 0;
+
+    for (const SRun& rkRun : mRuns)
+    {
+        const char* pkReplacement = mBytes.data() + rkRun.DataOffset + (ToNew ? rkRun.OldSize : 0);
+        const size_t ReplacementSize = (ToNew ? rkRun.NewSize : rkRun.OldSize);
+
+        rOut.insert(rOut.end(), Source.begin() + Pos, Source.begin() + rkRun.Offset);
+        rOut.insert(rOut.end(), pkReplacement, pkReplacement + ReplacementSize);
+        Pos = rkRun.Offset + (ToNew ? rkRun.OldSize : rkRun.NewSize);
+    }
+
+    rOut.insert(rOut.end(), Source.begin() + Pos, Source.end());
+    return true;
+}
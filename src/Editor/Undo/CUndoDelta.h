@@ -0,0 +1,45 @@
+#ifndef CUNDODELTA_H
+#define CUNDODELTA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/**
+ * Difference between two serialized states of the same data, for undo commands.
+ * Only the byte runs that changed are stored (both their old and new contents), so
+ * either state can be rebuilt from the other one.
+ *
+ * When the two states are the same size, every changed run is stored separately.
+ * Otherwise a single run spans everything between the common prefix and suffix.
+ */
+class CUndoDelta
+{
+    struct SRun
+    {
+        uint32_t Offset = 0;
+        uint32_t OldSize = 0;
+        uint32_t NewSize = 0;
+        uint32_t DataOffset = 0; // Old bytes followed by new bytes in mBytes
+    };
+
+    /** Runs closer together than this many unchanged bytes are stored as one */
+    static constexpr size_t skMinGap = 8;
+
+    std::vector<SRun> mRuns;
+    std::vector<char> mBytes;
+    uint32_t mOldSize = 0;
+    uint32_t mNewSize = 0;
+
+    void AddRun(size_t Offset, std::span<const char> OldBytes, std::span<const char> NewBytes);
+
+public:
+    static CUndoDelta Compute(std::span<const char> Old, std::span<const char> New);
+    bool Apply(std::span<const char> Source, bool ToNew, std::vector<char>& rOut) const;
+
+    bool IsEmpty() const        { return mRuns.empty(); }
+    size_t MemoryUsage() const  { return mRuns.capacity() * sizeof(SRun) + mBytes.capacity(); }
+};
+
+#endif // CUNDODELTA_H
@@ -38,6 +38,19 @@ void IEditPropertyCommand::RestoreObjectStateFromArray(std::vector<char>& rArray
     }
 }
 
+/** Move the object properties to the old or new state by applying the delta to their current state */
+void IEditPropertyCommand::ApplyDelta(bool ToNew)
+{
+    std::vector<char> Current;
+    std::vector<char> Target;
+    SaveObjectStateToArray(Current);
+
+    // If the sizes don't line up, the objects are already in the target state;
+    // this happens on the first redo, since the edit is applied before the command is pushed.
+    if (mDelta.Apply(Current, ToNew, Target))
+        RestoreObjectStateFromArray(Target);
+}
+
 IEditPropertyCommand::IEditPropertyCommand(
         IProperty* pProperty,
         CPropertyModel* pModel,
@@ -78,14 +91,18 @@ void IEditPropertyCommand::SaveOldData()
 
 void IEditPropertyCommand::SaveNewData()
 {
-    SaveObjectStateToArray(mNewData);
+    ASSERT(mSavedOldData);
+    std::vector<char> NewData;
+    SaveObjectStateToArray(NewData);
+
+    mDelta = CUndoDelta::Compute(mOldData, NewData);
+    mOldData = std::vector<char>();
     mSavedNewData = true;
 }
 
 bool IEditPropertyCommand::IsNewDataDifferent() const
 {
-    if (mOldData.size() != mNewData.size()) return true;
-    return memcmp(mOldData.data(), mNewData.data(), mNewData.size()) != 0;
+    return !mDelta.IsEmpty();
 }
 
 void IEditPropertyCommand::SetEditComplete(bool IsComplete)
@@ -122,8 +139,17 @@ bool IEditPropertyCommand::mergeWith(const QUndoCommand *pkOther)
                     return false;
             }
 
-            // Match
-            mNewData = pkCmd->mNewData;
+            // Match. The other command has been applied already, so walk both deltas back from
+            // the current state to our old state, then diff that against the current state.
+            std::vector<char> Current;
+            std::vector<char> Middle;
+            std::vector<char> Old;
+            SaveObjectStateToArray(Current);
+
+            if (!pkCmd->mDelta.Apply(Current, false, Middle) || !mDelta.Apply(Middle, false, Old))
+                return false;
+
+            mDelta = CUndoDelta::Compute(Old, Current);
             mCommandEnded = pkCmd->mCommandEnded;
             return true;
         }
@@ -135,7 +161,7 @@ bool IEditPropertyCommand::mergeWith(const QUndoCommand *pkOther)
 void IEditPropertyCommand::undo()
 {
     ASSERT(mSavedOldData && mSavedNewData);
-    RestoreObjectStateFromArray(mOldData);
+    ApplyDelta(false);
     mCommandEnded = true;
 
     if (mpModel && mIndex.isValid())
@@ -151,7 +177,7 @@ void IEditPropertyCommand::undo()
 void IEditPropertyCommand::redo()
 {
     ASSERT(mSavedOldData && mSavedNewData);
-    RestoreObjectStateFromArray(mNewData);
+    ApplyDelta(true);
 
     if (mpModel && mIndex.isValid())
     {
@@ -167,3 +193,8 @@ bool IEditPropertyCommand::AffectsCleanState() const
 {
     return true;
 }
+
+size_t IEditPropertyCommand::MemoryUsage() const
+{
+    return mOldData.capacity() + mDelta.MemoryUsage();
+}
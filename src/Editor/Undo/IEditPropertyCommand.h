@@ -1,6 +1,7 @@
 #ifndef IEDITPROPERTYCOMMAND_H
 #define IEDITPROPERTYCOMMAND_H
 
+#include "Editor/Undo/CUndoDelta.h"
 #include "Editor/Undo/IUndoCommand.h"
 
 #include <QCoreApplication>
@@ -14,9 +15,10 @@ class CPropertyModel;
 class IEditPropertyCommand : public IUndoCommand
 {
 protected:
-    // Has to be std::vector for compatibility with CVectorOutStream
+    // Has to be std::vector for compatibility with CVectorOutStream.
+    // Only held between SaveOldData and SaveNewData; after that, just the delta is kept.
     std::vector<char> mOldData;
-    std::vector<char> mNewData;
+    CUndoDelta mDelta;
 
     IProperty* mpProperty;
     CPropertyModel* mpModel;
@@ -31,6 +33,9 @@ protected:
     /** Restore the state of the object properties from the given data buffer */
     void RestoreObjectStateFromArray(std::vector<char>& rArray);
 
+    /** Move the object properties to the old or new state by applying the delta to their current state */
+    void ApplyDelta(bool ToNew);
+
 public:
     IEditPropertyCommand(
             IProperty* pProperty,
@@ -56,6 +61,7 @@ public:
     void undo() override;
     void redo() override;
     bool AffectsCleanState() const override;
+    size_t MemoryUsage() const override;
 };
 
 #endif // IEDITPROPERTYCOMMAND_H
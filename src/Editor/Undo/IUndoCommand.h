@@ -2,6 +2,7 @@
 #define IUNDOCOMMAND
 
 #include <QUndoCommand>
+#include <cstddef>
 
 class IUndoCommand : public QUndoCommand
 {
@@ -13,6 +14,9 @@ public:
         : QUndoCommand(rkText, pParent) {}
 
     virtual bool AffectsCleanState() const = 0;
+
+    /** Heap memory held for undo/redo, counted against the editor's undo memory budget */
+    virtual size_t MemoryUsage() const { return 0; }
 };
 
 #endif // IUNDOCOMMAND
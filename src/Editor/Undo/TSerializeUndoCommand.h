@@ -1,6 +1,7 @@
 #ifndef TSERIALIZEUNDOCOMMAND_H
 #define TSERIALIZEUNDOCOMMAND_H
 
+#include "Editor/Undo/CUndoDelta.h"
 #include "Editor/Undo/IUndoCommand.h"
 #include <Common/CFourCC.h>
 #include <Common/FileIO/CMemoryInStream.h>
@@ -18,19 +19,50 @@
  * Commands with IsActionComplete=false will be merged.
  * To prevent merging, push a final command with IsActionComplete=true.
  *
- * The current implementatation is "dumb" and just saves and restores
- * the entire object, including parameters that have not changed. Due
- * to this, it could be memory-intensive and not super performant.
- * As a result, it's probably not a good idea to use this on very
- * large objects right now.
+ * The whole object is serialized when the command is created and on every
+ * undo/redo, but only the bytes that changed are kept between them, so
+ * memory use scales with the size of the edit rather than the object.
+ * Serialization time still scales with the object.
  */
 template<typename ObjectT>
 class TSerializeUndoCommand : public IUndoCommand
 {
     ObjectT* mpObject;
-    std::vector<char> mOldData;
-    std::vector<char> mNewData;
+    std::vector<char> mOldData; // Only held until the first redo; after that, just the delta is kept
+    CUndoDelta mDelta;
     bool mIsActionComplete;
+    bool mHasDelta = false;
+
+    void SaveObjectState(std::vector<char>& rOut) const
+    {
+        CVectorOutStream Out(&rOut, std::endian::native);
+        CBasicBinaryWriter Writer(&Out, 0, EGame::Invalid);
+        mpObject->Serialize(Writer);
+    }
+
+    void RestoreObjectState(std::vector<char>& rData)
+    {
+        CMemoryInStream In(rData.data(), rData.size(), std::endian::native);
+        CBasicBinaryReader Reader(&In, CSerialVersion(0,0,EGame::Invalid));
+        mpObject->Serialize(Reader);
+    }
+
+    void ApplyDelta(bool ToNew)
+    {
+        std::vector<char> Current;
+        std::vector<char> Target;
+        SaveObjectState(Current);
+
+        if (mDelta.Apply(Current, ToNew, Target))
+            RestoreObjectState(Target);
+    }
+
+    void CheckObsolete()
+    {
+        // Obsolete command if nothing changed
+        if (mIsActionComplete && mDelta.IsEmpty())
+            setObsolete(true);
+    }
 
 public:
     TSerializeUndoCommand(const QString& kText, ObjectT* pObject, bool IsActionComplete)
@@ -39,9 +71,7 @@ public:
         , mIsActionComplete(IsActionComplete)
     {
         // Save old state of object
-        CVectorOutStream Out(&mOldData, std::endian::native);
-        CBasicBinaryWriter Writer(&Out, 0, EGame::Invalid);
-        mpObject->Serialize(Writer);
+        SaveObjectState(mOldData);
     }
 
     /** IUndoCommand interface */
@@ -53,38 +83,26 @@ public:
     void undo() override
     {
         // Restore old state of object
-        CMemoryInStream In(&mOldData[0], mOldData.size(), std::endian::native);
-        CBasicBinaryReader Reader(&In, CSerialVersion(0,0,EGame::Invalid));
-        mpObject->Serialize(Reader);
+        ApplyDelta(false);
     }
 
     void redo() override
     {
-        // First call when command is pushed - save new state of object
-        if (mNewData.empty())
+        // First call when command is pushed - the change is already applied, so just record it
+        if (!mHasDelta)
         {
-            CVectorOutStream Out(&mNewData, std::endian::native);
-            CBasicBinaryWriter Writer(&Out, 0, EGame::Invalid);
-            mpObject->Serialize(Writer);
-
-            // Obsolete command if memory buffers match
-            if (mIsActionComplete)
-            {
-                if (mOldData.size() == mNewData.size())
-                {
-                    if (memcmp(mOldData.data(), mNewData.data(), mNewData.size()) == 0)
-                    {
-                        setObsolete(true);
-                    }
-                }
-            }
+            std::vector<char> NewData;
+            SaveObjectState(NewData);
+
+            mDelta = CUndoDelta::Compute(mOldData, NewData);
+            mOldData = std::vector<char>();
+            mHasDelta = true;
+            CheckObsolete();
         }
         // Subsequent calls - restore new state of object
         else
         {
-            CMemoryInStream In(&mNewData[0], mNewData.size(), std::endian::native);
-            CBasicBinaryReader Reader(&In, CSerialVersion(0,0,EGame::Invalid));
-            mpObject->Serialize(Reader);
+            ApplyDelta(true);
         }
     }
 
@@ -95,21 +113,22 @@ public:
             const TSerializeUndoCommand* pkSerializeCommand =
                     static_cast<const TSerializeUndoCommand*>(pkOther);
 
-            mNewData = pkSerializeCommand->mNewData;
-            mIsActionComplete = pkSerializeCommand->mIsActionComplete;
+            if (pkSerializeCommand->mpObject != mpObject)
+                return false;
 
-            // Obsolete command if memory buffers match
-            if (mIsActionComplete)
-            {
-                if (mOldData.size() == mNewData.size())
-                {
-                    if (memcmp(mOldData.data(), mNewData.data(), mNewData.size()) == 0)
-                    {
-                        setObsolete(true);
-                    }
-                }
-            }
+            // The other command has been applied already; walk both deltas back from the
+            // current state to our old state, then diff that against the current state.
+            std::vector<char> Current;
+            std::vector<char> Middle;
+            std::vector<char> Old;
+            SaveObjectState(Current);
 
+            if (!pkSerializeCommand->mDelta.Apply(Current, false, Middle) || !mDelta.Apply(Middle, false, Old))
+                return false;
+
+            mDelta = CUndoDelta::Compute(Old, Current);
+            mIsActionComplete = pkSerializeCommand->mIsActionComplete;
+            CheckObsolete();
             return true;
         }
         return false;
@@ -119,6 +138,11 @@ public:
     {
         return true;
     }
+
+    size_t MemoryUsage() const override
+    {
+        return mOldData.capacity() + mDelta.MemoryUsage();
+    }
 };
 
 #endif // TSERIALIZEUNDOCOMMAND_H
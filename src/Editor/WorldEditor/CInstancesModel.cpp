@@ -108,16 +108,11 @@ QModelIndex CInstancesModel::index(int Row, int Column, const QModelIndex& rkPar
 
             if (mModelType == EInstanceModelType::Types)
             {
-                const std::list<CScriptObject*>& list = mTemplateList[rkParent.row()]->ObjectList();
-                if (static_cast<size_t>(Row) >= list.size())
-                {
+                const CScriptTemplate *pTemp = mTemplateList[rkParent.row()];
+                if (static_cast<size_t>(Row) >= pTemp->NumObjects())
                     return QModelIndex();
-                }
-                else
-                {
-                    auto it = std::next(list.begin(), Row);
-                    return createIndex(Row, Column, *it);
-                }
+
+                return createIndex(Row, Column, pTemp->ObjectByIndex(static_cast<size_t>(Row)));
             }
         }
 
@@ -149,22 +144,19 @@ QModelIndex CInstancesModel::parent(const QModelIndex& rkChild) const
 
         if (mModelType == EInstanceModelType::Layers)
         {
-            CScriptLayer *pLayer = pObj->Layer();
+            const uint32 LayerIdx = pObj->Layer()->AreaIndex();
 
-            for (size_t iLyr = 0; iLyr < mpArea->NumScriptLayers(); iLyr++)
-            {
-                if (mpArea->ScriptLayer(iLyr) == pLayer)
-                    return createIndex(iLyr, 0, (iLyr << TYPES_ROW_INDEX_SHIFT) | 1);
-            }
+            if (LayerIdx != UINT32_MAX)
+                return createIndex(static_cast<int>(LayerIdx), 0, static_cast<quintptr>((LayerIdx << TYPES_ROW_INDEX_SHIFT) | 1));
         }
         else if (mModelType == EInstanceModelType::Types)
         {
-            CScriptTemplate *pTemp = pObj->Template();
+            const auto Iter = mTemplateRows.constFind(pObj->Template());
 
-            for (qsizetype iTemp = 0; iTemp < mTemplateList.size(); iTemp++)
+            if (Iter != mTemplateRows.cend())
             {
-                if (mTemplateList[iTemp] == pTemp)
-                    return createIndex(static_cast<int>(iTemp), 0, static_cast<quintptr>((iTemp << TYPES_ROW_INDEX_SHIFT) | 1));
+                const int TempIdx = Iter.value();
+                return createIndex(TempIdx, 0, static_cast<quintptr>((TempIdx << TYPES_ROW_INDEX_SHIFT) | 1));
             }
         }
     }
@@ -434,6 +426,7 @@ void CInstancesModel::NodeCreated(CSceneNode *pNode)
 
                 beginInsertRows(ScriptRootIdx, NewIndex, NewIndex);
                 mTemplateList.insert(NewIndex, pObj->Template());
+                UpdateTemplateRows();
                 endInsertRows();
             }
         }
@@ -453,9 +446,10 @@ void CInstancesModel::NodeAboutToBeDeleted(CSceneNode *pNode)
         if (pObj->Template()->NumObjects() <= 1)
         {
             const QModelIndex ScriptRootIdx = index(0, 0);
-            const int TempIdx = mTemplateList.indexOf(pObj->Template());
+            const int TempIdx = mTemplateRows.value(pObj->Template(), -1);
             beginRemoveRows(ScriptRootIdx, TempIdx, TempIdx);
             mTemplateList.removeOne(pObj->Template());
+            UpdateTemplateRows();
             endRemoveRows();
         }
 
@@ -497,13 +491,9 @@ void CInstancesModel::PropertyModified(IProperty *pProp, CScriptObject *pInst)
     }
     else
     {
-        const uint32 Index = mTemplateList.indexOf(pInst->Template());
+        const int Index = mTemplateRows.value(pInst->Template(), -1);
         const QModelIndex TempIndex = index(Index, 0, ScriptRoot);
-
-        const auto& ObjList = pInst->Template()->ObjectList();
-        const QList<CScriptObject*> InstList(ObjList.begin(), ObjList.end());
-        const uint32 InstIdx = InstList.indexOf(pInst);
-        const QModelIndex InstIndex = index(InstIdx, 0, TempIndex);
+        const QModelIndex InstIndex = index(static_cast<int>(pInst->TemplateIndex()), 0, TempIndex);
         emit dataChanged(InstIndex, InstIndex);
     }
 }
@@ -602,5 +592,15 @@ void CInstancesModel::GenerateList()
         });
     }
 
+    UpdateTemplateRows();
     endResetModel();
 }
+
+void CInstancesModel::UpdateTemplateRows()
+{
+    mTemplateRows.clear();
+    mTemplateRows.reserve(mTemplateList.size());
+
+    for (qsizetype iTemp = 0; iTemp < mTemplateList.size(); iTemp++)
+        mTemplateRows.insert(mTemplateList[iTemp], static_cast<int>(iTemp));
+}
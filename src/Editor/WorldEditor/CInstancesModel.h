@@ -2,6 +2,7 @@
 #define CTYPESINSTANCEMODEL_H
 
 #include <QAbstractItemModel>
+#include <QHash>
 #include <QList>
 
 #include <Core/Scene/ENodeType.h>
@@ -40,6 +41,7 @@ private:
     CGameTemplate *mpCurrentGame = nullptr;
     EInstanceModelType mModelType{EInstanceModelType::Layers};
     QList<CScriptTemplate*> mTemplateList;
+    QHash<const CScriptTemplate*, int> mTemplateRows; // Reverse lookup for mTemplateList, used by parent()
     QStringList mBaseItems;
     bool mShowColumnEnabled = true;
     bool mChangingLayout = false;
@@ -80,6 +82,7 @@ public slots:
 
 private:
     void GenerateList();
+    void UpdateTemplateRows();
 };
 
 #endif // CTYPESINSTANCEMODEL_H
@@ -26,6 +26,14 @@ public:
         {
             QString Left = sourceModel()->data(rkLeft).toString();
             QString Right = sourceModel()->data(rkRight).toString();
+
+            // Break ties on the instance ID, since the source rows of a type aren't kept in any order
+            if (Left == Right && rkLeft.column() != 1)
+            {
+                Left = sourceModel()->data(rkLeft.siblingAtColumn(1)).toString();
+                Right = sourceModel()->data(rkRight.siblingAtColumn(1)).toString();
+            }
+
             return Left < Right;
         }
     }
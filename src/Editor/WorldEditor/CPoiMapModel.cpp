@@ -138,12 +138,30 @@ bool CPoiMapModel::IsModelMapped(const QModelIndex& rkIndex, const CModelNode *p
         return false;
 
     const CScriptNode* pPOI = PoiNodePointer(rkIndex);
-    const auto iter = mModelMap.constFind(pPOI);
 
-    if (iter != mModelMap.cend())
-        return iter->contains(pNode);
+    if (!pPOI)
+        return false;
+
+    return mpPoiToWorld->HasPoiMeshMap(pPOI->Instance()->InstanceID(), pNode->FindMeshID());
+}
+
+QModelIndex CPoiMapModel::FirstMappedPoi(const CModelNode *pNode) const
+{
+    if (!pNode || !mpPoiToWorld)
+        return QModelIndex();
+
+    // Use the reverse lookup rather than checking every POI; prefer the first row for consistency
+    uint32 FirstRow = UINT32_MAX;
+
+    for (const CInstanceID PoiID : mpPoiToWorld->PoisForModel(pNode->FindMeshID()))
+    {
+        const uint32 Row = mpPoiToWorld->MapIndexByID(PoiID);
+
+        if (Row < FirstRow && mpEditor->Scene()->NodeForInstanceID(PoiID))
+            FirstRow = Row;
+    }
 
-    return false;
+    return FirstRow != UINT32_MAX ? index(static_cast<int>(FirstRow), 0) : QModelIndex();
 }
 
 CScriptNode* CPoiMapModel::PoiNodePointer(const QModelIndex& rkIndex) const
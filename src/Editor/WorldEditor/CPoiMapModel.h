@@ -37,6 +37,7 @@ public:
     void RemoveMapping(const QModelIndex& rkIndex, const CModelNode* pNode);
     bool IsPoiTracked(const CScriptNode* pPOI) const;
     bool IsModelMapped(const QModelIndex& rkIndex, const CModelNode* pNode) const;
+    QModelIndex FirstMappedPoi(const CModelNode* pNode) const;
 
     CScriptNode* PoiNodePointer(const QModelIndex& rkIndex) const;
     const QList<CModelNode*>& GetPoiMeshList(const QModelIndex& rkIndex);
@@ -122,18 +122,12 @@ void CPoiMapSidebar::RevertModelOverlay(CModelNode *pModel)
         }
         else // If it's not mapped to the selected POI, then check whether it's mapped to any others.
         {
-            for (int iRow = 0; iRow < mSourceModel.rowCount(); iRow++)
-            {
-                const QModelIndex Index = mSourceModel.index(iRow, 0);
-
-                if (mSourceModel.IsModelMapped(Index, pModel))
-                {
-                    HighlightModel(Index, pModel);
-                    return;
-                }
-            }
+            const QModelIndex Index = mSourceModel.FirstMappedPoi(pModel);
 
-            UnhighlightModel(pModel);
+            if (Index.isValid())
+                HighlightModel(Index, pModel);
+            else
+                UnhighlightModel(pModel);
         }
     }
     else if (mHighlightMode == EHighlightMode::HighlightSelected)
@@ -30,6 +30,7 @@
 #include <Common/FileUtil.h>
 #include <Common/Log.h>
 #include <Core/SRayIntersection.h>
+#include <Core/GameProject/CAreaPreloader.h>
 #include <Core/GameProject/CGameProject.h>
 #include <Core/Resource/CWorld.h>
 #include <Core/Resource/Area/CGameArea.h>
@@ -131,6 +132,14 @@ CWorldEditor::CWorldEditor(QWidget *parent)
 
     mpCollisionDialog = new CCollisionRenderSettingsDialog(this, this);
 
+    // Picking mode is remembered between sessions
+    ui->ActionPixelAccuratePicking->setChecked(QSettings().value(QStringLiteral("WorldEditor/PixelAccuratePicking"), false).toBool());
+    ui->MainViewport->SetIDPickingEnabled(ui->ActionPixelAccuratePicking->isChecked());
+
+    // Set before anything is uploaded; switching later only affects models uploaded afterwards
+    ui->ActionLowMemoryGeometry->setChecked(QSettings().value(QStringLiteral("WorldEditor/LowMemoryGeometry"), false).toBool());
+    ToggleLowMemoryGeometry();
+
     // Quickplay buttons
     QToolButton* pQuickplayButton = new QToolButton(this);
     pQuickplayButton->setIcon(QIcon(QStringLiteral(":/icons/Play_32px.svg")));
@@ -213,6 +222,8 @@ CWorldEditor::CWorldEditor(QWidget *parent)
     connect(ui->ActionDrawSky, &QAction::triggered, this, &CWorldEditor::ToggleDrawSky);
     connect(ui->ActionGameMode, &QAction::triggered, this, &CWorldEditor::ToggleGameMode);
     connect(ui->ActionDisableAlpha, &QAction::triggered, this, &CWorldEditor::ToggleDisableAlpha);
+    connect(ui->ActionPixelAccuratePicking, &QAction::triggered, this, &CWorldEditor::TogglePixelAccuratePicking);
+    connect(ui->ActionLowMemoryGeometry, &QAction::triggered, this, &CWorldEditor::ToggleLowMemoryGeometry);
     connect(ui->ActionNoLighting, &QAction::triggered, this, &CWorldEditor::SetNoLighting);
     connect(ui->ActionBasicLighting, &QAction::triggered, this, &CWorldEditor::SetBasicLighting);
     connect(ui->ActionWorldLighting, &QAction::triggered, this, &CWorldEditor::SetWorldLighting);
@@ -223,6 +234,7 @@ CWorldEditor::CWorldEditor(QWidget *parent)
     connect(ui->ActionIncrementGizmo, &QAction::triggered, this, &CWorldEditor::IncrementGizmo);
     connect(ui->ActionDecrementGizmo, &QAction::triggered, this, &CWorldEditor::DecrementGizmo);
     connect(ui->ActionCollisionRenderSettings, &QAction::triggered, mpCollisionDialog, &CWorldEditor::show);
+    connect(ui->ActionDumpMemoryReport, &QAction::triggered, this, &CWorldEditor::DumpMemoryReport);
 
     connect(ui->ActionAbout, &QAction::triggered, this, &CWorldEditor::About);
 }
@@ -244,6 +256,7 @@ CWorldEditor::~CWorldEditor()
     }
 
     mScene.ClearScene();
+    mpAreaPreloader.reset();
     mpArea = nullptr;
     mpWorld = nullptr;
     if (gpResourceStore)
@@ -284,9 +297,15 @@ bool CWorldEditor::CloseWorld()
 
 bool CWorldEditor::SetArea(CWorld *pWorld, int AreaIndex)
 {
+    const bool WorldChanged = (pWorld != mpWorld);
+
     if (!CloseWorld())
         return false;
 
+    // Areas preloaded for another world won't be needed anymore
+    if (WorldChanged && mpAreaPreloader)
+        mpAreaPreloader->Clear();
+
     ExitPickMode();
     ui->MainViewport->ResetHover();
     ClearSelection();
@@ -300,6 +319,14 @@ bool CWorldEditor::SetArea(CWorld *pWorld, int AreaIndex)
 
     mpArea = pAreaEntry->Load();
     ASSERT(mpArea);
+
+    // The editor owns the area from here on. Unsaved changes get discarded by unloading it,
+    // so the preloader must not keep it alive. Start reading the neighbours in the meantime.
+    if (mpAreaPreloader)
+    {
+        mpAreaPreloader->Release(AreaID);
+        mpAreaPreloader->RequestAttachedAreas(mpWorld, AreaIndex);
+    }
     mpWorld->SetAreaLayerInfo(mpArea);
     mScene.SetActiveArea(mpWorld, mpArea);
 
@@ -376,6 +403,10 @@ void CWorldEditor::EditorTick(float)
 {
     // Update new link line
     UpdateNewLinkLine();
+
+    // Decode one preloaded area per tick so a batch of them doesn't stall the viewport
+    if (mpAreaPreloader)
+        mpAreaPreloader->Update();
 }
 
 void CWorldEditor::NotifyNodeAboutToBeDeleted(CSceneNode *pNode)
@@ -562,6 +593,16 @@ void CWorldEditor::OpenProjectSettings()
 
 void CWorldEditor::OnActiveProjectChanged(CGameProject *pProj)
 {
+    // The preloader is tied to the project's resource store
+    mpAreaPreloader.reset();
+
+    if (pProj)
+    {
+        QSettings Settings;
+        const uint64_t BudgetMB = Settings.value(QStringLiteral("WorldEditor/AreaPreloadBudgetMB"), CAreaPreloader::skDefaultMemoryBudget >> 20).toULongLong();
+        mpAreaPreloader = std::make_unique<CAreaPreloader>(pProj->ResourceStore(), BudgetMB << 20);
+    }
+
     ui->ActionProjectSettings->setEnabled( pProj != nullptr );
     ui->ActionCloseProject->setEnabled( pProj != nullptr );
     mpPoiMapAction->setVisible( pProj != nullptr && pProj->Game() >= EGame::EchoesDemo && pProj->Game() <= EGame::Corruption );
@@ -1318,6 +1359,31 @@ void CWorldEditor::ToggleDisableAlpha()
     ui->MainViewport->Renderer()->ToggleAlphaDisabled(ui->ActionDisableAlpha->isChecked());
 }
 
+void CWorldEditor::TogglePixelAccuratePicking()
+{
+    const bool Enable = ui->ActionPixelAccuratePicking->isChecked();
+    ui->MainViewport->SetIDPickingEnabled(Enable);
+    QSettings().setValue(QStringLiteral("WorldEditor/PixelAccuratePicking"), Enable);
+}
+
+void CWorldEditor::ToggleLowMemoryGeometry()
+{
+    const bool Enable = ui->ActionLowMemoryGeometry->isChecked();
+    CBasicModel::SetGeometryResidency(Enable ? EGeometryResidency::PositionsOnly : EGeometryResidency::Full);
+    QSettings().setValue(QStringLiteral("WorldEditor/LowMemoryGeometry"), Enable);
+}
+
+void CWorldEditor::DumpMemoryReport()
+{
+    if (gpResourceStore)
+        gpResourceStore->DumpMemoryReport();
+
+    if (gpEditorStore && gpEditorStore != gpResourceStore)
+        gpEditorStore->DumpMemoryReport();
+
+    UICommon::InfoMsg(this, tr("Memory Report"), tr("The memory report has been written to the log."));
+}
+
 void CWorldEditor::SetNoLighting()
 {
     CGraphics::sLightMode = CGraphics::ELightingMode::None;
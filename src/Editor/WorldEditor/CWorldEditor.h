@@ -15,6 +15,7 @@ namespace Ui {
 class CWorldEditor;
 }
 
+class CAreaPreloader;
 class CCollisionRenderSettingsDialog;
 class CGameArea;
 class CGeneratePropertyNamesDialog;
@@ -51,6 +52,7 @@ class CWorldEditor : public INodeEditor
 
     TResPtr<CWorld> mpWorld;
     TResPtr<CGameArea> mpArea;
+    std::unique_ptr<CAreaPreloader> mpAreaPreloader; // Loads neighbouring areas in the background; recreated per project
 
     CCollisionRenderSettingsDialog* mpCollisionDialog;
     CLinkDialog* mpLinkDialog;
@@ -165,6 +167,9 @@ private slots:
     void ToggleDrawSky();
     void ToggleGameMode();
     void ToggleDisableAlpha();
+    void TogglePixelAccuratePicking();
+    void ToggleLowMemoryGeometry();
+    void DumpMemoryReport();
     void SetNoLighting();
     void SetBasicLighting();
     void SetWorldLighting();
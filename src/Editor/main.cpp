@@ -5,11 +5,13 @@
 #include <Common/Log.h>
 
 #include <Core/NCoreTests.h>
+#include <Core/OpenGL/CShaderCache.h>
 #include <Core/Resource/Script/NGameList.h>
 
 #include <QApplication>
 #include <QCoreApplication>
 #include <QIcon>
+#include <QStandardPaths>
 #include <QStyleFactory>
 #include <QtGlobal>
 
@@ -90,6 +92,24 @@ static TString LocateLogPath()
 #endif
 }
 
+static TString LocateShaderCachePath()
+{
+#ifndef _WIN32
+    if (const char* pkHome = getenv("HOME"))
+        return TString(pkHome) + "/.primeworldeditor/shadercache/";
+
+    // No home directory (e.g. a service account); use the app data dir instead, or disable the cache if there isn't one
+    const QString AppDataDir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+
+    if (AppDataDir.isEmpty())
+        return "";
+
+    return TString(AppDataDir.toStdString()) + "/shadercache/";
+#else
+    return "shadercache/";
+#endif
+}
+
 class CMain
 {
 public:
@@ -134,6 +154,7 @@ public:
         gDataDir = LocateDataDirectory();
         gResourcesWritable = FileUtil::IsDirectoryWritable(gDataDir + "resources");
         gTemplatesWritable = FileUtil::IsDirectoryWritable(gDataDir + "templates");
+        CShaderCache::SetCacheDirectory(LocateShaderCachePath());
 
         // Create editor resource store
         gpEditorStore = new CResourceStore(gDataDir + "resources/");
@@ -153,9 +174,9 @@ public:
         }
 
         // Check for unit tests being run
-        if (NCoreTests::RunTests(argc, argv))
+        if (int ExitCode = 0; NCoreTests::RunTests(argc, argv, ExitCode))
         {
-            return 0;
+            return ExitCode;
         }
 
         // Execute application